@@ -0,0 +1,430 @@
+/*
+ * BMP280 Compensation Check and Benchmark
+ *
+ * Checks the FSWV1_BMP280 compensation against the datasheet reference
+ * code (BST-BMP280-DS001, 8.2, copied below with its global t_fine) and
+ * compares the cost per sample of the integer and float paths.
+ *
+ * Compile: gcc -O2 -Ifsw/inc -o bmp280_comp_bench bmp280_comp_bench.c fsw/src/fswv1_bmp280_comp.c -lm
+ * Run:     ./bmp280_comp_bench [samples] [adc_t_step]
+ *
+ * For each calibration set (the datasheet example and perturbed copies):
+ *   - the integer path must be bit-identical to the reference for every
+ *     20-bit adc_T, and for every 20-bit adc_P at adc_T steps of
+ *     adc_t_step (default 65536, 1 checks all 2^40 pairs);
+ *   - the float path's temperature must be bit-identical to the integer
+ *     result / 100.0f, and its pressure within TOL_PA of the integer
+ *     result wherever that lies in the sensor's operating range
+ *     (-40..85 degC, 300..1100 hPa). Elsewhere it only has to be finite.
+ *
+ * Cycles are counted with perf_event_open (ARM and x86 core cycles). If
+ * that is not allowed, x86 falls back to TSC ticks and others report ns
+ * only. Exit status is non-zero if any check fails.
+ *
+ * The timings hold only for the machine the tool runs on. So far it has
+ * been timed on an x86-64 host only (float about 1.5-1.7x faster); run it
+ * on the Raspberry Pi before relying on the float path being faster there.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "fswv1_bmp280_comp.h"
+
+#define ADC_RANGE       (1 << 20)
+#define DEFAULT_T_STEP  65536
+#define RANDOM_SETS     7
+#define BENCH_SAMPLES   10000000
+#define BENCH_SET       1024
+#define TOL_PA          0.05
+#define DATASHEET_PA    100653.27   /* Pressure of the datasheet example */
+
+static int failures = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/*
+ * Datasheet reference code, kept as published apart from the calibration
+ * being read from one global struct
+ */
+typedef int32_t BMP280_S32_t;
+typedef uint32_t BMP280_U32_t;
+typedef int64_t BMP280_S64_t;
+
+static FSWV1_BMP280_Calib_t ref_cal;
+static BMP280_S32_t t_fine;
+
+static BMP280_S32_t bmp280_compensate_T_int32(BMP280_S32_t adc_T) {
+    BMP280_S32_t var1, var2, T;
+    var1 = ((((adc_T >> 3) - ((BMP280_S32_t)ref_cal.dig_T1 << 1))) * ((BMP280_S32_t)ref_cal.dig_T2)) >> 11;
+    var2 = (((((adc_T >> 4) - ((BMP280_S32_t)ref_cal.dig_T1)) * ((adc_T >> 4) - ((BMP280_S32_t)ref_cal.dig_T1))) >> 12) *
+            ((BMP280_S32_t)ref_cal.dig_T3)) >> 14;
+    t_fine = var1 + var2;
+    T = (t_fine * 5 + 128) >> 8;
+    return T;
+}
+
+static BMP280_U32_t bmp280_compensate_P_int64(BMP280_S32_t adc_P) {
+    BMP280_S64_t var1, var2, p;
+    var1 = ((BMP280_S64_t)t_fine) - 128000;
+    var2 = var1 * var1 * (BMP280_S64_t)ref_cal.dig_P6;
+    var2 = var2 + ((var1 * (BMP280_S64_t)ref_cal.dig_P5) << 17);
+    var2 = var2 + (((BMP280_S64_t)ref_cal.dig_P4) << 35);
+    var1 = ((var1 * var1 * (BMP280_S64_t)ref_cal.dig_P3) >> 8) + ((var1 * (BMP280_S64_t)ref_cal.dig_P2) << 12);
+    var1 = (((((BMP280_S64_t)1) << 47) + var1)) * ((BMP280_S64_t)ref_cal.dig_P1) >> 33;
+    if (var1 == 0) {
+        return 0;
+    }
+    p = 1048576 - adc_P;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((BMP280_S64_t)ref_cal.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((BMP280_S64_t)ref_cal.dig_P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((BMP280_S64_t)ref_cal.dig_P7) << 4);
+    return (BMP280_U32_t)p;
+}
+
+/* Datasheet example (section 8.2): adc_T 519888 -> 25.08 degC, adc_P 415148 -> 100653.27 Pa */
+static const FSWV1_BMP280_Calib_t datasheet_cal = {
+    27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+static int16_t perturb16(int16_t c) {
+    long v = c + (long)c * ((int32_t)(rng() % 41) - 20) / 100 + (int32_t)(rng() % 7) - 3;
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+static uint16_t perturbu16(uint16_t c) {
+    long v = c + (long)c * ((int32_t)(rng() % 41) - 20) / 100;
+    return (uint16_t)(v > 65535 ? 65535 : (v < 1 ? 1 : v));
+}
+
+static void random_calib(FSWV1_BMP280_Calib_t *cal) {
+    cal->dig_T1 = perturbu16(datasheet_cal.dig_T1);
+    cal->dig_T2 = perturb16(datasheet_cal.dig_T2);
+    cal->dig_T3 = perturb16(datasheet_cal.dig_T3);
+    cal->dig_P1 = perturbu16(datasheet_cal.dig_P1);
+    cal->dig_P2 = perturb16(datasheet_cal.dig_P2);
+    cal->dig_P3 = perturb16(datasheet_cal.dig_P3);
+    cal->dig_P4 = perturb16(datasheet_cal.dig_P4);
+    cal->dig_P5 = perturb16(datasheet_cal.dig_P5);
+    cal->dig_P6 = perturb16(datasheet_cal.dig_P6);
+    cal->dig_P7 = perturb16(datasheet_cal.dig_P7);
+    cal->dig_P8 = perturb16(datasheet_cal.dig_P8);
+    cal->dig_P9 = perturb16(datasheet_cal.dig_P9);
+}
+
+/* The calibration must survive the trip through the raw NVM layout */
+static void check_parse(const FSWV1_BMP280_Calib_t *cal) {
+    const uint16_t *words = (const uint16_t *)cal;
+    uint8_t raw[FSWV1_BMP280_CALIB_SIZE];
+    FSWV1_BMP280_Calib_t parsed;
+    int i;
+
+    for (i = 0; i < FSWV1_BMP280_CALIB_SIZE / 2; i++) {
+        raw[2 * i] = (uint8_t)(words[i] & 0xFF);
+        raw[2 * i + 1] = (uint8_t)(words[i] >> 8);
+    }
+    FSWV1_BMP280_ParseCalib(raw, &parsed);
+    if (memcmp(&parsed, cal, sizeof(parsed)) != 0) {
+        printf("MISMATCH calibration unpacking\n");
+        failures++;
+    }
+}
+
+typedef struct {
+    uint64_t int_checked;
+    uint64_t float_checked;
+    uint64_t float_outside;
+    double max_err_pa;
+    double sum_sq_pa;
+} check_stats_t;
+
+static void check_set(const FSWV1_BMP280_Calib_t *cal, int t_step, check_stats_t *st) {
+    FSWV1_BMP280_Comp_t comp;
+    int32_t adc_t, adc_p;
+    int32_t ref_t, temp;
+    uint32_t ref_p, press;
+    float temp_c, press_hpa;
+    double err;
+    int reported = 0;
+
+    ref_cal = *cal;
+    FSWV1_BMP280_InitComp(&comp, cal);
+    check_parse(cal);
+
+    /* Temperature and t_fine over the whole range */
+    for (adc_t = 0; adc_t < ADC_RANGE; adc_t++) {
+        ref_t = bmp280_compensate_T_int32(adc_t);
+        FSWV1_BMP280_CompensateInt(&comp, adc_t, 0, &temp, &press);
+        FSWV1_BMP280_CompensateFloat(&comp, adc_t, 0, &temp_c, &press_hpa);
+        if (temp != ref_t || FSWV1_BMP280_TFine(&comp, adc_t) != t_fine ||
+            memcmp(&temp_c, &(float){ ref_t / 100.0f }, sizeof(float)) != 0) {
+            if (reported++ < 5) {
+                printf("MISMATCH temperature: adc_T=%d ref=%d int=%d float=%.9g\n",
+                       adc_t, ref_t, temp, temp_c);
+            }
+            failures++;
+        }
+    }
+
+    /* Pressure over the whole range at each adc_T step */
+    for (adc_t = 0; adc_t < ADC_RANGE; adc_t += t_step) {
+        ref_t = bmp280_compensate_T_int32(adc_t);
+        for (adc_p = 0; adc_p < ADC_RANGE; adc_p++) {
+            ref_p = bmp280_compensate_P_int64(adc_p);
+            FSWV1_BMP280_CompensateInt(&comp, adc_t, adc_p, &temp, &press);
+            st->int_checked++;
+            if (press != ref_p) {
+                if (reported++ < 5) {
+                    printf("MISMATCH integer pressure: adc_T=%d adc_P=%d ref=%u int=%u\n",
+                           adc_t, adc_p, ref_p, press);
+                }
+                failures++;
+            }
+
+            FSWV1_BMP280_CompensateFloat(&comp, adc_t, adc_p, &temp_c, &press_hpa);
+            if (ref_t < -4000 || ref_t > 8500 || ref_p < 300u * 25600u || ref_p > 1100u * 25600u) {
+                st->float_outside++;
+                if (!isfinite(press_hpa)) {
+                    if (reported++ < 5) {
+                        printf("MISMATCH float pressure not finite: adc_T=%d adc_P=%d\n", adc_t, adc_p);
+                    }
+                    failures++;
+                }
+                continue;
+            }
+
+            st->float_checked++;
+            err = fabs((double)press_hpa * 100.0 - ref_p / 256.0);
+            st->sum_sq_pa += err * err;
+            if (err > st->max_err_pa) {
+                st->max_err_pa = err;
+            }
+            if (err > TOL_PA) {
+                if (reported++ < 5) {
+                    printf("MISMATCH float pressure: adc_T=%d adc_P=%d ref=%.4f Pa float=%.4f Pa\n",
+                           adc_t, adc_p, ref_p / 256.0, press_hpa * 100.0);
+                }
+                failures++;
+            }
+        }
+    }
+}
+
+/*
+ * Cycle counter: perf_event_open core cycles, else TSC on x86
+ */
+static int cycle_fd = -1;
+
+static const char *cycles_init(void) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    cycle_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (cycle_fd >= 0) {
+        return "core cycles (perf_event)";
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    return "TSC ticks (perf_event unavailable)";
+#else
+    return NULL;
+#endif
+}
+
+static int cycles_read(uint64_t *count) {
+    if (cycle_fd >= 0) {
+        return read(cycle_fd, count, sizeof(*count)) == (ssize_t)sizeof(*count);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    *count = __rdtsc();
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+typedef struct {
+    int32_t adc_t[BENCH_SET];
+    int32_t adc_p[BENCH_SET];
+} bench_set_t;
+
+typedef struct {
+    double ns;
+    double cycles;   /* < 0 if not available */
+} bench_result_t;
+
+static void bench_finish(bench_result_t *r, uint64_t t0, uint64_t c0, int have_c0, int count) {
+    uint64_t c1;
+
+    r->ns = (double)(now_ns() - t0) / count;
+    r->cycles = (have_c0 && cycles_read(&c1)) ? (double)(c1 - c0) / count : -1.0;
+}
+
+static void bench_reference(const bench_set_t *set, int count, bench_result_t *r) {
+    volatile uint32_t sink = 0;
+    uint64_t t0, c0 = 0;
+    int have_c0;
+    int i;
+
+    t0 = now_ns();
+    have_c0 = cycles_read(&c0);
+    for (i = 0; i < count; i++) {
+        sink += (uint32_t)bmp280_compensate_T_int32(set->adc_t[i % BENCH_SET]);
+        sink += bmp280_compensate_P_int64(set->adc_p[i % BENCH_SET]);
+    }
+    bench_finish(r, t0, c0, have_c0, count);
+}
+
+static void bench_int(const FSWV1_BMP280_Comp_t *comp, const bench_set_t *set, int count, bench_result_t *r) {
+    volatile uint32_t sink = 0;
+    uint64_t t0, c0 = 0;
+    int32_t temp;
+    uint32_t press;
+    int have_c0;
+    int i;
+
+    t0 = now_ns();
+    have_c0 = cycles_read(&c0);
+    for (i = 0; i < count; i++) {
+        FSWV1_BMP280_CompensateInt(comp, set->adc_t[i % BENCH_SET], set->adc_p[i % BENCH_SET], &temp, &press);
+        sink += (uint32_t)temp + press;
+    }
+    bench_finish(r, t0, c0, have_c0, count);
+}
+
+static void bench_float(const FSWV1_BMP280_Comp_t *comp, const bench_set_t *set, int count, bench_result_t *r) {
+    volatile float sink = 0.0f;
+    uint64_t t0, c0 = 0;
+    float temp_c, press_hpa;
+    int have_c0;
+    int i;
+
+    t0 = now_ns();
+    have_c0 = cycles_read(&c0);
+    for (i = 0; i < count; i++) {
+        FSWV1_BMP280_CompensateFloat(comp, set->adc_t[i % BENCH_SET], set->adc_p[i % BENCH_SET], &temp_c, &press_hpa);
+        sink += temp_c + press_hpa;
+    }
+    bench_finish(r, t0, c0, have_c0, count);
+}
+
+static void print_result(const char *name, const bench_result_t *r) {
+    if (r->cycles >= 0.0) {
+        printf("%-15s %8.1f ns/sample %8.1f cycles/sample\n", name, r->ns, r->cycles);
+    } else {
+        printf("%-15s %8.1f ns/sample\n", name, r->ns);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    static bench_set_t set;
+    FSWV1_BMP280_Calib_t cal;
+    FSWV1_BMP280_Comp_t comp;
+    check_stats_t st;
+    bench_result_t ref_r, int_r, float_r;
+    int bench_count = (argc > 1) ? atoi(argv[1]) : BENCH_SAMPLES;
+    int t_step = (argc > 2) ? atoi(argv[2]) : DEFAULT_T_STEP;
+    const char *cycle_source;
+    int32_t temp;
+    uint32_t press;
+    float temp_c, press_hpa;
+    int i;
+
+    if (bench_count <= 0 || t_step <= 0) {
+        printf("Usage: %s [samples] [adc_t_step]\n", argv[0]);
+        return 2;
+    }
+
+    printf("===========================================\n");
+    printf("BMP280 Compensation Check and Benchmark\n");
+    printf("===========================================\n");
+
+    /* Known answer from the datasheet */
+    FSWV1_BMP280_InitComp(&comp, &datasheet_cal);
+    FSWV1_BMP280_CompensateInt(&comp, 519888, 415148, &temp, &press);
+    FSWV1_BMP280_CompensateFloat(&comp, 519888, 415148, &temp_c, &press_hpa);
+    if (temp != 2508 || FSWV1_BMP280_TFine(&comp, 519888) != 128422 ||
+        fabs(press / 256.0 - DATASHEET_PA) > TOL_PA || fabs(press_hpa * 100.0 - DATASHEET_PA) > TOL_PA) {
+        printf("MISMATCH datasheet example: T=%d P=%.4f Pa float=%.4f Pa\n",
+               temp, press / 256.0, press_hpa * 100.0);
+        failures++;
+    }
+
+    /* Correctness */
+    memset(&st, 0, sizeof(st));
+    for (i = 0; i <= RANDOM_SETS; i++) {
+        if (i == 0) {
+            cal = datasheet_cal;
+        } else {
+            random_calib(&cal);
+        }
+        check_set(&cal, t_step, &st);
+    }
+    printf("Calibrations:   %d (datasheet + %d perturbed)\n", RANDOM_SETS + 1, RANDOM_SETS);
+    printf("Temperature:    %d adc_T values per set, bit-exact\n", ADC_RANGE);
+    printf("Integer path:   %llu pressure samples vs datasheet code\n",
+           (unsigned long long)st.int_checked);
+    printf("Float path:     %llu in operating range, %llu outside\n",
+           (unsigned long long)st.float_checked, (unsigned long long)st.float_outside);
+    printf("Float error:    max %.4f Pa, rms %.4f Pa (limit %.2f Pa)\n", st.max_err_pa,
+           st.float_checked ? sqrt(st.sum_sq_pa / st.float_checked) : 0.0, TOL_PA);
+    printf("Mismatches:     %d\n\n", failures);
+
+    /* Cost on readings around the datasheet example */
+    ref_cal = datasheet_cal;
+    for (i = 0; i < BENCH_SET; i++) {
+        set.adc_t[i] = 519888 + (int32_t)(rng() % 80001) - 40000;
+        set.adc_p[i] = 415148 + (int32_t)(rng() % 200001) - 100000;
+    }
+
+    cycle_source = cycles_init();
+    printf("Counter:        %s\n", cycle_source ? cycle_source : "none, ns only");
+
+    bench_reference(&set, BENCH_SET, &ref_r);
+    bench_int(&comp, &set, BENCH_SET, &int_r);
+    bench_float(&comp, &set, BENCH_SET, &float_r);
+    bench_reference(&set, bench_count, &ref_r);
+    bench_int(&comp, &set, bench_count, &int_r);
+    bench_float(&comp, &set, bench_count, &float_r);
+
+    print_result("datasheet:", &ref_r);
+    print_result("integer path:", &int_r);
+    print_result("float path:", &float_r);
+    printf("Speedup:        %8.1fx (float vs integer, this machine only)\n", int_r.ns / float_r.ns);
+
+    if (failures > 0) {
+        printf("\nFAIL\n");
+        return 1;
+    }
+
+    printf("\nPASS\n");
+    return 0;
+}
@@ -0,0 +1,574 @@
+/*
+ * BMP388/BMP390 FIFO Check and Benchmark
+ *
+ * Checks the FSWV1_BMP3 FIFO decoder, compensation and frame clock
+ * (fswv1_bmp3_fifo.c) on the host and measures what a burst costs.
+ *
+ * Compile: gcc -O2 -Ifsw/inc -o bmp3_fifo_bench bmp3_fifo_bench.c fsw/src/fswv1_bmp3_fifo.c -lm
+ * Run:     ./bmp3_fifo_bench [seconds]
+ *
+ *   - the INT_CTRL value: watermark interrupt, push-pull, active high;
+ *   - decoder: full bursts, control and partial frames, a frame cut off at
+ *     the end of the read, reads past the end of the FIFO, unknown headers;
+ *   - calibration scaling against the datasheet's powers of two;
+ *   - compensation against the datasheet code (BST-BMP388-DS001, 9.3,
+ *     copied below) evaluated in double, within TOL_PA over the operating
+ *     range (-40..85 degC, 300..1250 hPa) for the example calibration and
+ *     perturbed copies. The published float version is reported too;
+ *   - frame clock: a simulated sensor whose oscillator runs DRIFT off
+ *     nominal, read at the 25 Hz rate group with jitter and an occasional
+ *     late read. Every frame time must be within one output period of
+ *     the true one (default 60 s of simulated time);
+ *   - bus cost: the driver's read policy (fswv1_bmp3.c) against a
+ *     sensor drifting DRIFT, read once per watermark with jitter. At the
+ *     default watermark it must use at least BUS_SAVING less bus time
+ *     than reading every sample;
+ *   - ns per frame to decode and compensate a full FIFO.
+ *
+ * Exit status is non-zero if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "fswv1_bmp3_fifo.h"
+
+#define TOL_PA          0.02
+#define RANDOM_SETS     7
+#define BENCH_BURSTS    200000
+#define SIM_SECONDS     60
+#define ODR_NS          5000000ULL   /* 200 Hz nominal */
+#define READ_NS         40000000ULL  /* 25 Hz rate group */
+#define READ_JITTER_NS  3000000ULL
+#define LATE_EVERY      97           /* Every 97th read is late ... */
+#define LATE_NS         150000000ULL /* ... by 150 ms */
+#define DRIFT           0.02
+#define LATENCY_MS      40           /* FSWV1_BMP3_FIFO_LATENCY_MS */
+#define BUS_SAVING      0.10
+
+static int failures = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void check(int ok, const char *what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/*
+ * Raw calibration (NVM_PAR_T1 .. NVM_PAR_P11)
+ */
+typedef struct {
+    uint16_t t1, t2;
+    int8_t   t3;
+    int16_t  p1, p2;
+    int8_t   p3, p4;
+    uint16_t p5, p6;
+    int8_t   p7, p8;
+    int16_t  p9;
+    int8_t   p10, p11;
+} raw_calib_t;
+
+/* A typical part */
+static const raw_calib_t example_cal = {
+    27104, 18873, -7, -1563, -3251, 35, 0, 25262, 30176, 3, -6, 16134, 7, -60
+};
+
+static void pack_calib(const raw_calib_t *c, uint8_t b[FSWV1_BMP3_CALIB_SIZE]) {
+    b[0] = c->t1 & 0xFF;  b[1] = c->t1 >> 8;
+    b[2] = c->t2 & 0xFF;  b[3] = c->t2 >> 8;
+    b[4] = (uint8_t)c->t3;
+    b[5] = (uint16_t)c->p1 & 0xFF;  b[6] = (uint16_t)c->p1 >> 8;
+    b[7] = (uint16_t)c->p2 & 0xFF;  b[8] = (uint16_t)c->p2 >> 8;
+    b[9] = (uint8_t)c->p3;
+    b[10] = (uint8_t)c->p4;
+    b[11] = c->p5 & 0xFF; b[12] = c->p5 >> 8;
+    b[13] = c->p6 & 0xFF; b[14] = c->p6 >> 8;
+    b[15] = (uint8_t)c->p7;
+    b[16] = (uint8_t)c->p8;
+    b[17] = (uint16_t)c->p9 & 0xFF; b[18] = (uint16_t)c->p9 >> 8;
+    b[19] = (uint8_t)c->p10;
+    b[20] = (uint8_t)c->p11;
+}
+
+static void random_calib(raw_calib_t *c) {
+    *c = example_cal;
+    c->t1 += (int)(rng() % 2001) - 1000;
+    c->t2 += (int)(rng() % 2001) - 1000;
+    c->t3 = (int8_t)((int)(rng() % 9) - 10);
+    c->p1 += (int)(rng() % 401) - 200;
+    c->p2 += (int)(rng() % 401) - 200;
+    c->p3 = (int8_t)(30 + rng() % 11);
+    c->p5 += (int)(rng() % 201) - 100;
+    c->p6 += (int)(rng() % 201) - 100;
+    c->p9 += (int)(rng() % 401) - 200;
+    c->p11 = (int8_t)(-55 - (int)(rng() % 11));
+}
+
+/*
+ * Datasheet reference code (9.3), as published with float (ref_*_f) and
+ * with every float turned into double (ref_*_d)
+ */
+#define REF_COMPENSATE(suffix, real)                                                        \
+    typedef struct {                                                                        \
+        real par_t1, par_t2, par_t3;                                                        \
+        real par_p1, par_p2, par_p3, par_p4, par_p5, par_p6, par_p7, par_p8, par_p9,        \
+             par_p10, par_p11;                                                              \
+        real t_lin;                                                                         \
+    } ref_calib_##suffix;                                                                   \
+                                                                                            \
+    static void ref_scale_##suffix(const raw_calib_t *c, ref_calib_##suffix *r) {           \
+        r->par_t1 = (real)c->t1 / (real)pow(2, -8);                                          \
+        r->par_t2 = (real)c->t2 / (real)pow(2, 30);                                          \
+        r->par_t3 = (real)c->t3 / (real)pow(2, 48);                                          \
+        r->par_p1 = ((real)c->p1 - (real)pow(2, 14)) / (real)pow(2, 20);                     \
+        r->par_p2 = ((real)c->p2 - (real)pow(2, 14)) / (real)pow(2, 29);                     \
+        r->par_p3 = (real)c->p3 / (real)pow(2, 32);                                          \
+        r->par_p4 = (real)c->p4 / (real)pow(2, 37);                                          \
+        r->par_p5 = (real)c->p5 / (real)pow(2, -3);                                          \
+        r->par_p6 = (real)c->p6 / (real)pow(2, 6);                                           \
+        r->par_p7 = (real)c->p7 / (real)pow(2, 8);                                           \
+        r->par_p8 = (real)c->p8 / (real)pow(2, 15);                                          \
+        r->par_p9 = (real)c->p9 / (real)pow(2, 48);                                          \
+        r->par_p10 = (real)c->p10 / (real)pow(2, 48);                                        \
+        r->par_p11 = (real)c->p11 / (real)pow(2, 65);                                        \
+    }                                                                                       \
+                                                                                            \
+    static real ref_temperature_##suffix(uint32_t uncomp_temp, ref_calib_##suffix *calib_data) { \
+        real partial_data1 = (real)(uncomp_temp - calib_data->par_t1);                      \
+        real partial_data2 = (real)(partial_data1 * calib_data->par_t2);                    \
+        calib_data->t_lin = partial_data2 + (partial_data1 * partial_data1) * calib_data->par_t3; \
+        return calib_data->t_lin;                                                           \
+    }                                                                                       \
+                                                                                            \
+    static real ref_pressure_##suffix(uint32_t uncomp_press, ref_calib_##suffix *calib_data) { \
+        real comp_press;                                                                    \
+        real partial_data1, partial_data2, partial_data3, partial_data4;                    \
+        real partial_out1, partial_out2;                                                    \
+        partial_data1 = calib_data->par_p6 * calib_data->t_lin;                             \
+        partial_data2 = calib_data->par_p7 * (calib_data->t_lin * calib_data->t_lin);       \
+        partial_data3 = calib_data->par_p8 * (calib_data->t_lin * calib_data->t_lin * calib_data->t_lin); \
+        partial_out1 = calib_data->par_p5 + partial_data1 + partial_data2 + partial_data3;  \
+        partial_data1 = calib_data->par_p2 * calib_data->t_lin;                             \
+        partial_data2 = calib_data->par_p3 * (calib_data->t_lin * calib_data->t_lin);       \
+        partial_data3 = calib_data->par_p4 * (calib_data->t_lin * calib_data->t_lin * calib_data->t_lin); \
+        partial_out2 = (real)uncomp_press *                                                 \
+                       (calib_data->par_p1 + partial_data1 + partial_data2 + partial_data3); \
+        partial_data1 = (real)uncomp_press * (real)uncomp_press;                            \
+        partial_data2 = calib_data->par_p9 + calib_data->par_p10 * calib_data->t_lin;       \
+        partial_data3 = partial_data1 * partial_data2;                                      \
+        partial_data4 = partial_data3 + ((real)uncomp_press * (real)uncomp_press * (real)uncomp_press) * \
+                        calib_data->par_p11;                                                \
+        comp_press = partial_out1 + partial_out2 + partial_data4;                           \
+        return comp_press;                                                                  \
+    }
+
+REF_COMPENSATE(d, double)
+REF_COMPENSATE(f, float)
+
+/*
+ * Calibration scaling
+ */
+static void check_parse(const raw_calib_t *c) {
+    uint8_t raw[FSWV1_BMP3_CALIB_SIZE];
+    FSWV1_BMP3_Calib_t cal;
+    ref_calib_d ref;
+
+    pack_calib(c, raw);
+    FSWV1_BMP3_ParseCalib(raw, &cal);
+    ref_scale_d(c, &ref);
+
+    check(cal.T1 == ref.par_t1 && cal.T2 == ref.par_t2 && cal.T3 == ref.par_t3, "calibration T1..T3");
+    check(cal.P1 == ref.par_p1 && cal.P2 == ref.par_p2 && cal.P3 == ref.par_p3 &&
+          cal.P4 == ref.par_p4 && cal.P5 == ref.par_p5 && cal.P6 == ref.par_p6 &&
+          cal.P7 == ref.par_p7 && cal.P8 == ref.par_p8 && cal.P9 == ref.par_p9 &&
+          cal.P10 == ref.par_p10 && cal.P11 == ref.par_p11, "calibration P1..P11");
+}
+
+/*
+ * Compensation over the operating range
+ */
+typedef struct {
+    long   checked;
+    double max_pa;      /* Driver against the double reference */
+    double max_f_pa;    /* Published float code against the double reference */
+    double max_t;
+} comp_stats_t;
+
+static void check_comp(const raw_calib_t *c, comp_stats_t *st) {
+    uint8_t raw[FSWV1_BMP3_CALIB_SIZE];
+    FSWV1_BMP3_Calib_t cal;
+    ref_calib_d ref_d;
+    ref_calib_f ref_f;
+    uint32_t adc_t, adc_p;
+    double t_ref, p_ref, p_f;
+    float t, p;
+    long before = st->checked;
+
+    pack_calib(c, raw);
+    FSWV1_BMP3_ParseCalib(raw, &cal);
+    ref_scale_d(c, &ref_d);
+    ref_scale_f(c, &ref_f);
+
+    for (adc_t = 0; adc_t < (1u << 24); adc_t += 4099) {
+        t_ref = ref_temperature_d(adc_t, &ref_d);
+        if (t_ref < -40.0 || t_ref > 85.0) {
+            continue;
+        }
+        ref_temperature_f(adc_t, &ref_f);
+
+        for (adc_p = 0; adc_p < (1u << 24); adc_p += 1021) {
+            p_ref = ref_pressure_d(adc_p, &ref_d);
+            if (p_ref < 30000.0 || p_ref > 125000.0) {
+                continue;
+            }
+            p_f = ref_pressure_f(adc_p, &ref_f);
+            FSWV1_BMP3_Compensate(&cal, adc_t, adc_p, &t, &p);
+
+            if (fabs(p * 100.0 - p_ref) > st->max_pa) st->max_pa = fabs(p * 100.0 - p_ref);
+            if (fabs(p_f - p_ref) > st->max_f_pa) st->max_f_pa = fabs(p_f - p_ref);
+            if (fabs(t - t_ref) > st->max_t) st->max_t = fabs(t - t_ref);
+            st->checked++;
+        }
+    }
+
+    check(st->checked > before, "compensation: calibration covers the operating range");
+}
+
+/*
+ * FIFO images
+ */
+static uint32_t put_frame(uint8_t *b, uint32_t adc_t, uint32_t adc_p) {
+    b[0] = FSWV1_BMP3_FH_TEMP_PRESS;
+    b[1] = adc_t & 0xFF; b[2] = (adc_t >> 8) & 0xFF; b[3] = adc_t >> 16;
+    b[4] = adc_p & 0xFF; b[5] = (adc_p >> 8) & 0xFF; b[6] = adc_p >> 16;
+    return FSWV1_BMP3_FRAME_SIZE;
+}
+
+static uint32_t put_time(uint8_t *b, uint32_t ticks) {
+    b[0] = FSWV1_BMP3_FH_TIME;
+    b[1] = ticks & 0xFF; b[2] = (ticks >> 8) & 0xFF; b[3] = (ticks >> 16) & 0xFF;
+    return FSWV1_BMP3_TIME_FRAME_SIZE;
+}
+
+static void check_decoder(void) {
+    uint8_t buf[FSWV1_BMP3_FIFO_READ_MAX + 16];
+    FSWV1_BMP3_Frame_t frames[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    FSWV1_BMP3_FifoResult_t r;
+    uint32_t len = 0;
+    uint32_t n, i;
+    int ok;
+
+    /* Full FIFO, sensor time, then reads past the end */
+    for (i = 0; len + FSWV1_BMP3_FRAME_SIZE <= FSWV1_BMP3_FIFO_SIZE; i++) {
+        len += put_frame(&buf[len], 0x800000 + i, 0x600000 + 3 * i);
+    }
+    len += put_time(&buf[len], 0x123456);
+    buf[len++] = FSWV1_BMP3_FH_EMPTY;
+    buf[len++] = 0;
+
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    ok = (n == i) && r.TimeValid && r.SensorTime == 0x123456 && !r.Invalid && r.Consumed == len;
+    for (i = 0; i < n && ok; i++) {
+        ok = frames[i].AdcT == 0x800000 + i && frames[i].AdcP == 0x600000 + 3 * i;
+    }
+    check(ok, "decoder: full FIFO with sensor time");
+
+    /* Control and partial frames between data frames */
+    len = 0;
+    len += put_frame(&buf[len], 1, 2);
+    buf[len++] = FSWV1_BMP3_FH_CONFIG_CHANGE; buf[len++] = 0;
+    buf[len++] = FSWV1_BMP3_FH_TEMP; buf[len++] = 9; buf[len++] = 9; buf[len++] = 9;
+    buf[len++] = FSWV1_BMP3_FH_CONFIG_ERROR; buf[len++] = 0;
+    len += put_frame(&buf[len], 3, 4);
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    check(n == 2 && frames[1].AdcT == 3 && frames[1].AdcP == 4 && r.ConfigChanges == 1 &&
+          r.ConfigErrors == 1 && r.Partial == 1 && !r.TimeValid && r.Consumed == len,
+          "decoder: control and partial frames");
+
+    /* Last frame cut off by the read length: left for the next burst */
+    len = 0;
+    len += put_frame(&buf[len], 5, 6);
+    len += put_frame(&buf[len], 7, 8);
+    n = FSWV1_BMP3_DecodeFifo(buf, len - 3, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    check(n == 1 && r.Consumed == FSWV1_BMP3_FRAME_SIZE && !r.Invalid, "decoder: truncated frame");
+
+    /* Unknown header */
+    len = 0;
+    len += put_frame(&buf[len], 5, 6);
+    buf[len++] = 0x3C;
+    len += put_frame(&buf[len], 7, 8);
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    check(n == 1 && r.Invalid, "decoder: unknown header");
+
+    /* More frames than room */
+    len = 0;
+    for (i = 0; i < 10; i++) {
+        len += put_frame(&buf[len], i, i);
+    }
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, 4, &r);
+    check(n == 4 && frames[3].AdcT == 3 && r.Consumed == len, "decoder: MaxFrames");
+
+    /* Empty FIFO */
+    buf[0] = FSWV1_BMP3_FH_EMPTY;
+    n = FSWV1_BMP3_DecodeFifo(buf, 1, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    check(n == 0 && !r.Invalid, "decoder: empty FIFO");
+}
+
+/*
+ * Frame clock against a simulated sensor
+ */
+typedef struct {
+    long   frames;
+    long   lost;
+    double max_err_ns;
+    double sum_err_ns;
+    double tick_ps;
+} clock_stats_t;
+
+static void simulate_clock(double drift, int seconds, clock_stats_t *st) {
+    FSWV1_BMP3_Clock_t clock;
+    uint64_t frame_ns[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    double true_period = ODR_NS * (1.0 + drift);
+    double tick_ns = (FSWV1_BMP3_TICK_PS / 1000.0) * (1.0 + drift);
+    uint64_t t0 = 1000000000ULL;
+    uint64_t end = t0 + (uint64_t)seconds * 1000000000ULL;
+    uint64_t read_ns = t0;
+    uint64_t next_frame = 1;     /* Frame k is complete at t0 + k * true_period */
+    uint64_t last_frame;
+    uint64_t first;
+    uint32_t count, i;
+    long reads = 0;
+    double err;
+
+    memset(&clock, 0, sizeof(clock));
+    FSWV1_BMP3_ClockInit(&clock, FSWV1_BMP3_ODR_BASE_TICKS);
+    memset(st, 0, sizeof(*st));
+
+    while (read_ns < end) {
+        reads++;
+        read_ns += READ_NS + (rng() % (2 * READ_JITTER_NS)) - READ_JITTER_NS;
+        if (reads % LATE_EVERY == 0) {
+            read_ns += LATE_NS;
+        }
+
+        last_frame = (uint64_t)((read_ns - t0) / true_period);
+        if (last_frame < next_frame) {
+            continue;
+        }
+
+        /* The FIFO keeps the newest frames when it overflows */
+        first = next_frame;
+        count = (uint32_t)(last_frame - next_frame + 1);
+        if (count > FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE) {
+            count = FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE;
+            first = last_frame - count + 1;
+            st->lost += (long)(first - next_frame);
+        }
+
+        FSWV1_BMP3_ClockStamp(&clock, count, read_ns, 1,
+                              (uint32_t)((read_ns - t0 + rng() % 200000) / tick_ns) & FSWV1_BMP3_TIME_MASK,
+                              frame_ns);
+
+        for (i = 0; i < count; i++) {
+            if (read_ns < t0 + 1000000000ULL) {
+                continue;   /* Tick estimate still settling */
+            }
+            err = fabs((double)frame_ns[i] - (t0 + (first + i) * true_period));
+            st->sum_err_ns += err;
+            if (err > st->max_err_ns) st->max_err_ns = err;
+            st->frames++;
+        }
+
+        next_frame = last_frame + 1;
+    }
+
+    st->tick_ps = clock.TickPs;
+}
+
+/*
+ * Decode + compensate cost
+ */
+static void bench_burst(void) {
+    uint8_t raw[FSWV1_BMP3_CALIB_SIZE];
+    uint8_t buf[FSWV1_BMP3_FIFO_READ_MAX];
+    FSWV1_BMP3_Frame_t frames[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    FSWV1_BMP3_FifoResult_t r;
+    FSWV1_BMP3_Calib_t cal;
+    float t, p;
+    volatile float sink = 0;
+    uint32_t len = 0;
+    uint32_t n = 0, i;
+    uint64_t start, elapsed;
+    long b;
+
+    pack_calib(&example_cal, raw);
+    FSWV1_BMP3_ParseCalib(raw, &cal);
+
+    while (len + FSWV1_BMP3_FRAME_SIZE <= FSWV1_BMP3_FIFO_SIZE) {
+        len += put_frame(&buf[len], 8300000 + (rng() & 0xFFF), 6500000 + (rng() & 0xFFFF));
+    }
+    len += put_time(&buf[len], 1000);
+
+    start = now_ns();
+    for (b = 0; b < BENCH_BURSTS; b++) {
+        n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+        for (i = 0; i < n; i++) {
+            FSWV1_BMP3_Compensate(&cal, frames[i].AdcT, frames[i].AdcP, &t, &p);
+            sink += p;
+        }
+    }
+    elapsed = now_ns() - start;
+    (void)sink;
+
+    printf("\nDecode + compensate: %u frames per full FIFO, %.1f ns/frame, %.2f us/burst\n",
+           n, (double)elapsed / ((double)BENCH_BURSTS * n), (double)elapsed / BENCH_BURSTS / 1000.0);
+}
+
+/*
+ * I2C bus cost per second at 200 Hz, counted as the driver counts it
+ * (address byte + payload per message), for one watermark. Reads come
+ * once per watermark, +/- 7.5% jitter; the FIFO is read the way
+ * BMP3_Read does it.
+ */
+typedef struct {
+    double bytes;           /* Per second */
+    double transactions;    /* Per second */
+} bus_cost_t;
+
+static void simulate_bus(uint32_t latency_ms, double drift, bus_cost_t *bc) {
+    const uint32_t status_bytes = (1 + 1) + (1 + 1) + (1 + 1) + (1 + 4);   /* ERR, EVENT..FIFO_LENGTH */
+    double true_period = ODR_NS * (1.0 + drift);
+    uint64_t wtm = latency_ms * 1000000ULL / ODR_NS;
+    uint64_t burst = wtm + 1;
+    uint64_t read_ns = 0;
+    uint64_t end = (uint64_t)SIM_SECONDS * 1000000000ULL;
+    uint64_t jitter = latency_ms * 75000ULL;
+    uint64_t made, held, rest;
+    uint64_t read = 0;
+    uint64_t bytes = 0;
+    uint64_t transactions = 0;
+
+    while (read_ns < end) {
+        read_ns += latency_ms * 1000000ULL + rng() % (2 * jitter) - jitter;
+        made = (uint64_t)(read_ns / true_period);
+        held = made - read;
+        if (held > FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE) {
+            held = FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE;
+            read = made - held;
+        }
+
+        /* Watermark + 1 frame and the sensor time */
+        bytes += (1 + 1) + (1 + burst * FSWV1_BMP3_FRAME_SIZE + FSWV1_BMP3_TIME_FRAME_SIZE);
+        transactions++;
+
+        if (held == 0 || held > burst) {
+            bytes += status_bytes;
+            transactions++;
+        }
+        if (held > burst) {
+            rest = held - burst;
+            bytes += (1 + 1) + (1 + rest * FSWV1_BMP3_FRAME_SIZE + FSWV1_BMP3_TIME_FRAME_SIZE);
+            transactions++;
+        }
+        read += held;
+    }
+
+    bc->bytes = bytes / (double)SIM_SECONDS;
+    bc->transactions = transactions / (double)SIM_SECONDS;
+}
+
+static void check_bus_cost(void) {
+    static const uint32_t latency_ms[] = { 5, 10, 20, 40, 80, 160 };
+    static const double drifts[] = { 0.0, DRIFT, -DRIFT };
+    const double odr = 1e9 / ODR_NS;
+    const double polled = odr * ((1 + 1) + (1 + 7));   /* Status .. data (0x03..0x09) per sample */
+    bus_cost_t bc, worst;
+    uint32_t k, d;
+
+    printf("\nI2C cost at %.0f Hz, +/-%.0f%% drift   transactions/s  bytes/s  bus us/s  vs polled\n",
+           odr, DRIFT * 100.0);
+    printf("  every sample (polled)          %14.0f %8.0f %9.0f\n", odr, polled, polled * 9 / 0.4);
+
+    for (k = 0; k < sizeof(latency_ms) / sizeof(latency_ms[0]); k++) {
+        memset(&worst, 0, sizeof(worst));
+        for (d = 0; d < sizeof(drifts) / sizeof(drifts[0]); d++) {
+            simulate_bus(latency_ms[k], drifts[d], &bc);
+            if (bc.bytes > worst.bytes) worst = bc;
+        }
+        printf("  FIFO, %3u ms watermark         %14.1f %8.0f %9.0f  %+6.1f%%\n", latency_ms[k],
+               worst.transactions, worst.bytes, worst.bytes * 9 / 0.4, (worst.bytes / polled - 1.0) * 100.0);
+        if (latency_ms[k] == LATENCY_MS) {
+            check(worst.bytes <= polled * (1.0 - BUS_SAVING), "bus: default watermark saves BUS_SAVING");
+            check(worst.transactions <= 1.05 * 1000.0 / LATENCY_MS, "bus: about one transaction per watermark");
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int seconds = (argc > 1) ? atoi(argv[1]) : SIM_SECONDS;
+    raw_calib_t cal;
+    comp_stats_t cs;
+    clock_stats_t st;
+    static const double drifts[] = { 0.0, DRIFT, -DRIFT };
+    int s;
+
+    check((FSWV1_BMP3_INT_CTRL_FWTM & FSWV1_BMP3_INT_FWTM_EN) &&
+          (FSWV1_BMP3_INT_CTRL_FWTM & FSWV1_BMP3_INT_LEVEL) &&
+          !(FSWV1_BMP3_INT_CTRL_FWTM & (FSWV1_BMP3_INT_OD | FSWV1_BMP3_INT_LATCH |
+                                        FSWV1_BMP3_INT_FFULL_EN | FSWV1_BMP3_INT_DRDY_EN)) &&
+          FSWV1_BMP3_INT_CTRL_FWTM == 0x0A,
+          "INT_CTRL: watermark only, push-pull, active high");
+    check_decoder();
+
+    memset(&cs, 0, sizeof(cs));
+    check_parse(&example_cal);
+    check_comp(&example_cal, &cs);
+    for (s = 0; s < RANDOM_SETS; s++) {
+        random_calib(&cal);
+        check_parse(&cal);
+        check_comp(&cal, &cs);
+    }
+    printf("Compensation: %ld points, max |dP| %.4f Pa (published float code: %.2f Pa), max |dT| %.6f degC\n",
+           cs.checked, cs.max_pa, cs.max_f_pa, cs.max_t);
+    check(cs.max_pa <= TOL_PA, "compensation within TOL_PA of the reference");
+
+    printf("\nFrame clock, %d s at 200 Hz, reads every 40 +/- 3 ms, every %dth read %llu ms late\n",
+           seconds, LATE_EVERY, (unsigned long long)(LATE_NS / 1000000));
+    printf("  drift     frames   lost  mean err us  max err us  tick ps\n");
+    for (s = 0; s < (int)(sizeof(drifts) / sizeof(drifts[0])); s++) {
+        simulate_clock(drifts[s], seconds, &st);
+        printf("  %+5.1f%%  %8ld %6ld %12.1f %11.1f %8.0f\n", drifts[s] * 100.0, st.frames, st.lost,
+               st.frames ? st.sum_err_ns / st.frames / 1000.0 : 0.0, st.max_err_ns / 1000.0, st.tick_ps);
+        check(st.frames > 0 && st.max_err_ns < ODR_NS * (1.0 + fabs(drifts[s])),
+              "frame times within one output period");
+    }
+
+    check_bus_cost();
+    bench_burst();
+
+    if (failures) {
+        printf("\n%d check(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("\nAll checks passed\n");
+    return 0;
+}
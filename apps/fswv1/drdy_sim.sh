@@ -0,0 +1,86 @@
+#!/bin/bash
+#
+# Data-ready GPIO simulator for the FSWV1 cFS App
+# Creates a gpio-sim chip and pulses one of its lines at a fixed rate, so the
+# DRDY edge path can be tested without a sensor interrupt wired up.
+#
+# Usage: sudo ./drdy_sim.sh [rate_hz] [line]   # create (if needed) and pulse
+#        sudo ./drdy_sim.sh remove             # tear the simulated chip down
+#
+# Build the app with FSWV1_DRDY_ENABLE=1, FSWV1_DRDY_CHIP_PATH set to the chip
+# printed below and FSWV1_DRDY_LINE set to the pulsed line.
+#
+
+set -e
+
+SIM_NAME="fswv1_drdy"
+SIM_LINES=8
+RATE_HZ=${1:-25}
+LINE=${2:-0}
+CONFIGFS="/sys/kernel/config/gpio-sim"
+
+echo "=========================================="
+echo "FSWV1 Data-Ready Simulator (gpio-sim)"
+echo "=========================================="
+
+# Check if running as root
+if [ "$EUID" -ne 0 ]; then
+    echo "ERROR: This script must be run as root (sudo)"
+    echo "Usage: sudo ./drdy_sim.sh [rate_hz] [line]"
+    exit 1
+fi
+
+if [ "$1" = "remove" ]; then
+    if [ -d "$CONFIGFS/$SIM_NAME" ]; then
+        echo 0 > "$CONFIGFS/$SIM_NAME/live"
+        rmdir "$CONFIGFS/$SIM_NAME/bank0"
+        rmdir "$CONFIGFS/$SIM_NAME"
+        echo "  ✓ Simulated chip removed"
+    else
+        echo "  Nothing to remove"
+    fi
+    exit 0
+fi
+
+echo "[1/3] Loading gpio-sim..."
+modprobe gpio-sim
+if [ ! -d "$CONFIGFS" ]; then
+    mountpoint -q /sys/kernel/config || mount -t configfs none /sys/kernel/config
+fi
+echo "  ✓ gpio-sim available"
+
+echo ""
+echo "[2/3] Creating simulated chip..."
+if [ ! -d "$CONFIGFS/$SIM_NAME" ]; then
+    mkdir "$CONFIGFS/$SIM_NAME"
+    mkdir "$CONFIGFS/$SIM_NAME/bank0"
+    echo $SIM_LINES > "$CONFIGFS/$SIM_NAME/bank0/num_lines"
+    echo 1 > "$CONFIGFS/$SIM_NAME/live"
+fi
+
+DEV_NAME=$(cat "$CONFIGFS/$SIM_NAME/dev_name")
+CHIP_NAME=$(cat "$CONFIGFS/$SIM_NAME/bank0/chip_name")
+PULL="/sys/devices/platform/$DEV_NAME/$CHIP_NAME/sim_gpio$LINE/pull"
+
+# Let the app open the chip without root
+chmod 666 "/dev/$CHIP_NAME"
+echo "  ✓ Chip /dev/$CHIP_NAME, line $LINE"
+
+echo ""
+echo "[3/3] Pulsing line $LINE at $RATE_HZ Hz (Ctrl+C to stop)..."
+echo "  Build with:"
+echo "    FSWV1_DRDY_ENABLE=1"
+echo "    FSWV1_DRDY_CHIP_PATH=\"/dev/$CHIP_NAME\""
+echo "    FSWV1_DRDY_LINE=$LINE"
+echo ""
+
+# Short high pulse per period: a rising edge, then back low
+HALF=$(awk "BEGIN { printf \"%.6f\", 0.5 / $RATE_HZ }")
+trap 'echo pull-down > "$PULL"; echo ""; echo "Stopped."; exit 0' INT TERM
+echo pull-down > "$PULL"
+while true; do
+    echo pull-up > "$PULL"
+    sleep "$HALF"
+    echo pull-down > "$PULL"
+    sleep "$HALF"
+done
@@ -34,6 +34,178 @@
 #define FSWV1_APP_PIPE_DEPTH 32
 #define FSWV1_APP_EVENT_COUNTS 5
 
+/*
+** Console output of sensor readings
+** 0: the latest BMP280 and IMU readings are printed once per housekeeping
+**    request. 1 (debug): every sample batch is printed from the rate groups,
+**    which puts console I/O on the sampling path.
+** Nothing is printed while the deadline monitor is in degraded mode.
+*/
+#define FSWV1_APP_CONSOLE_DEBUG 0
+
+/*
+** Command drain budget per wakeup (0 disables a limit). At least one
+** command is always processed, so commands cannot starve. One limit must
+** stay set: SET_CMD_BUDGET rejects 0 messages with 0 microseconds.
+** SB does not report the pipe depth, so housekeeping reports
+** CmdBurstHighWater instead: the most commands drained, across wakeups,
+** before the pipe was seen empty. Commands that arrive during a burst are
+** counted too, so it is an upper bound on the depth the pipe reached (unless
+** it overflowed). Size FSWV1_APP_PIPE_DEPTH from it.
+*/
+#define FSWV1_APP_CMD_BUDGET_MSGS  8
+#define FSWV1_APP_CMD_BUDGET_US    2000
+
+/*
+** IMU reader child task and sample ring
+** FSWV1_IMU_RING_SIZE must be a power of two; 1024 holds ~1 s at 1 kHz.
+*/
+#define FSWV1_IMU_TASK_ENABLE      1
+#define FSWV1_IMU_TASK_NAME        "FSWV1_IMU"
+#define FSWV1_IMU_TASK_PRIORITY    55     /* Above the main task (60) */
+#define FSWV1_IMU_TASK_STACK_SIZE  16384
+#define FSWV1_IMU_TASK_POLL_MS     100    /* Bounds shutdown latency */
+#define FSWV1_IMU_RING_SIZE        1024
+
+/*
+** IMU drain batch
+** Most samples FSWV1_ReadUARTFrames hands to the IMU rate group per call.
+** When more are waiting, the oldest are dropped and counted.
+*/
+#define FSWV1_IMU_DRAIN_MAX        64
+
+/*
+** IMU instances
+** Every instance's samples go out in its own IMU telemetry packets; the
+** newest sample of FSWV1_IMU_PRIMARY_INSTANCE also feeds the combined
+** telemetry packet, UDP and the telemetry UART. Each instance has its own
+** FSWV1_IMU_RING_SIZE ring.
+*/
+#define FSWV1_IMU_PRIMARY_INSTANCE 0
+
+/*
+** IMU wire format at startup (FSWV1_IMU_FORMAT_xxx in fswv1_app_msg.h)
+** Under AUTO, a detected format is dropped, and detection starts again,
+** after FSWV1_IMU_AUTO_LOSS_FRAMES unusable frames in a row or
+** FSWV1_IMU_AUTO_LOSS_BYTES bytes without a good frame.
+*/
+#define FSWV1_IMU_FORMAT           FSWV1_IMU_FORMAT_AUTO
+#define FSWV1_IMU_AUTO_LOSS_FRAMES 8
+#define FSWV1_IMU_AUTO_LOSS_BYTES  512
+
+/*
+** BMP280 measurement profile at startup (FSWV1_BMP_xxx in fswv1_app_msg.h)
+** In normal mode a read is skipped, without touching the bus, until one
+** output period (conversion plus standby) has passed since the last
+** sample. In forced mode each read collects the conversion started by
+** the previous one and starts the next, so the sensor sleeps in between.
+*/
+#define FSWV1_BMP_OSRS_T           FSWV1_BMP_OSRS_X1
+#define FSWV1_BMP_OSRS_P           FSWV1_BMP_OSRS_X1
+#define FSWV1_BMP_FILTER           FSWV1_BMP_FILTER_OFF
+#define FSWV1_BMP_STANDBY          FSWV1_BMP_STANDBY_0_5MS
+#define FSWV1_BMP_MODE             FSWV1_BMP_MODE_NORMAL
+
+/*
+** BMP280 compensation: 1 = float path with coefficients precomputed from
+** the calibration, 0 = datasheet 64-bit integer path (fswv1_bmp280_comp.h)
+** The float path is faster on x86-64 hosts; it has not been timed on ARM
+** (see bmp280_comp_bench.c).
+*/
+#define FSWV1_BMP_COMP_FLOAT       1
+
+/*
+** Barometer instances
+** Every instance's samples go out in its own barometer telemetry packets;
+** FSWV1_BMP_PRIMARY_INSTANCE also feeds the combined telemetry packet, UDP
+** and the telemetry UART. A device that fails FSWV1_BMP_FAIL_LIMIT reads in
+** a row is marked failed and re-probed every FSWV1_BMP_REPROBE_PASSES
+** passes of its bus.
+*/
+#define FSWV1_BMP_PRIMARY_INSTANCE 0
+#define FSWV1_BMP_FAIL_LIMIT       5
+#define FSWV1_BMP_REPROBE_PASSES   25
+
+/*
+** Barometer sample queues
+** Each instance queues its samples in a ring of FSWV1_BMP_RING_SIZE (a
+** power of two) until the main task collects them, at most
+** FSWV1_BMP_DRAIN_MAX per collection; the rest wait for the next one.
+*/
+#define FSWV1_BMP_RING_SIZE        256
+#define FSWV1_BMP_DRAIN_MAX        128
+
+/*
+** BMP388/BMP390 FIFO (fswv1_bmp3.c)
+** The watermark is FSWV1_BMP3_FIFO_LATENCY_MS of frames (at least one, at
+** most FSWV1_BMP3_FIFO_WTM_MAX_FRAMES) and each read is one burst of that
+** plus a frame. Bursts only save bus time over reading every sample from
+** about 40 ms up, and only if the reads come once per watermark: keep
+** the BMP280 rate group period at the latency, or wire INT to
+** FSWV1_DRDY_LINE. A faster trigger pays for a whole burst each time.
+*/
+#define FSWV1_BMP3_FIFO_LATENCY_MS     40
+#define FSWV1_BMP3_FIFO_WTM_MAX_FRAMES 36   /* Half the FIFO */
+
+/*
+** Barometer bus reader tasks (one per I2C bus in FSWV1_BMP_DEVICES)
+** The BMP280 rate group only wakes them, so the buses are read in
+** parallel and the cycle does not wait for the I2C transfers. Without
+** them (disabled, failed to start, or simulated time) the main task reads
+** each bus in turn.
+*/
+#define FSWV1_BMP_TASK_ENABLE      1
+#define FSWV1_BMP_TASK_NAME        "FSWV1_BMP"   /* Bus index appended */
+#define FSWV1_BMP_TASK_PRIORITY    56     /* Above the main task (60) */
+#define FSWV1_BMP_TASK_STACK_SIZE  16384
+#define FSWV1_BMP_TASK_POLL_MS     100    /* Bounds shutdown latency */
+
+/*
+** Time-tagged command queue
+** A command due within FSWV1_TTQ_LOOKAHEAD_US (one wakeup period) of the
+** cycle start is waited for rather than left for the next wakeup. After a
+** wakeup timeout the window runs to the next timeout instead. Executions later than
+** FSWV1_TTQ_LATE_TOLERANCE_US after their tag count as late.
+*/
+#define FSWV1_TTQ_CAPACITY            32
+#define FSWV1_TTQ_LOOKAHEAD_US        (1000000 / FSWV1_APP_WAKEUP_RATE_HZ)
+#define FSWV1_TTQ_LATE_TOLERANCE_US   500
+
+/*
+** Real-time profile (FSWV1_RT_PROFILE_xxx in fswv1_app_msg.h)
+** Priorities are SCHED_FIFO levels (1-99, higher runs first). A CPU mask
+** of 0 leaves the affinity alone. The stack prefault must stay below the
+** smallest task stack size.
+** FSWV1_RT_LOCK_PROCESS_MEMORY adds mlockall, disables heap trimming and
+** mmap allocations and prefaults the heap. These affect every app in the
+** cFE process, so enable it only where the whole process should be locked.
+*/
+#define FSWV1_RT_PROFILE                FSWV1_RT_PROFILE_DEFAULT
+#define FSWV1_RT_MAIN_PRIORITY          80
+#define FSWV1_RT_MAIN_CPUMASK           0x8     /* Core 3 */
+#define FSWV1_RT_IMU_PRIORITY           85
+#define FSWV1_RT_IMU_CPUMASK            0x8
+#define FSWV1_RT_BMP_PRIORITY           84      /* Barometer bus tasks */
+#define FSWV1_RT_BMP_CPUMASK            0x8
+#define FSWV1_RT_LOCK_PROCESS_MEMORY    0
+#define FSWV1_RT_STACK_PREFAULT_BYTES   8192
+#define FSWV1_RT_HEAP_PREFAULT_BYTES    (256 * 1024)
+
+/*
+** Tasks managed by the real-time profile
+*/
+#define FSWV1_RT_TASK_MAIN   0
+#define FSWV1_RT_TASK_IMU    1
+#define FSWV1_RT_TASK_BMP    2    /* First barometer bus task, one per bus */
+#define FSWV1_RT_TASK_COUNT  (FSWV1_RT_TASK_BMP + FSWV1_BMP_MAX_BUSES)
+
+/*
+** Real-time settings that failed to apply (FSWV1_RT_SetProfile FailedMask)
+*/
+#define FSWV1_RT_FAILED_PRIORITY  0x01  /* Scheduling policy / priority */
+#define FSWV1_RT_FAILED_AFFINITY  0x02  /* CPU affinity */
+#define FSWV1_RT_FAILED_MEMLOCK   0x04  /* mlockall */
+
 /***********************************************************************/
 /*
 ** Type Definitions
@@ -46,9 +218,26 @@ typedef struct
 {
     float Temperature;
     float Pressure;
-    uint32 Timestamp;
+    CFE_TIME_SysTime_t Timestamp;   /* CFE time of ArrivalNs */
+    uint64 ArrivalNs;               /* FSWV1_Time_MonoNs() when the I2C read completed (FIFO: frame time) */
+    uint8 Instance;                 /* Barometer (entry of FSWV1_BMP_DEVICES) */
 } FSWV1_SensorData_t;
 
+/*
+** Barometer Instance Statistics (FSWV1_GetSensorInstanceStats)
+*/
+typedef struct
+{
+    uint8  Health;         /* FSWV1_BMP_HEALTH_xxx */
+    uint8  Chip;           /* FSWV1_BMP_CHIP_xxx */
+    uint32 Samples;        /* Samples published */
+    uint32 NotReady;       /* Reads with no new conversion available */
+    uint32 ReadErrors;     /* Failed reads */
+    uint32 Recoveries;     /* Times a re-probe found the failed device again */
+    uint32 Dropped;        /* Samples lost because the main task fell a ring behind */
+    uint32 FifoFull;       /* FIFO bursts that found the FIFO full (frames overwritten) */
+} FSWV1_BaroStats_t;
+
 /*
 ** IMU Data Structure (from UART)
 ** Format: "$,Ax,Ay,Az,Gx,Gy,Gz,Temperature,#"
@@ -62,9 +251,82 @@ typedef struct
     float Gyro_Y;       /* Gyroscope Y-axis */
     float Gyro_Z;       /* Gyroscope Z-axis */
     float Temperature;  /* IMU Temperature */
-    uint32 Timestamp;   /* Timestamp */
+    CFE_TIME_SysTime_t Timestamp;   /* CFE time of ArrivalNs */
+    uint64 ArrivalNs;               /* FSWV1_Time_MonoNs() when the frame's last byte arrived */
+    uint8 Instance;                 /* IMU channel (entry of UART_DEVICES) */
 } FSWV1_IMUData_t;
 
+/*
+** IMU Stream Integrity Statistics (FSWV1_GetIMULinkStats)
+*/
+typedef struct
+{
+    uint32 FramesGood;     /* Frames decoded */
+    uint32 BadFrames;      /* Frames dropped: parse, CRC, framing, overflow, truncation */
+    uint32 Overflows;      /* ASCII frames longer than the receive buffer */
+    uint32 Truncated;      /* ASCII frames missing their start or end marker */
+    uint32 ReadErrors;     /* read() failures other than "no data" */
+    uint32 SeqGaps;        /* Jumps in the sender frame counter */
+    uint32 SeqLost;        /* Frames missing according to the sender counter */
+    uint32 SeqResets;      /* Counter went backwards (sender restart) */
+    uint32 IntervalUs;     /* Smoothed inter-arrival time of frames */
+    uint32 JitterUs;       /* Smoothed change between successive intervals */
+    uint32 MaxIntervalUs;  /* Longest inter-arrival time */
+} FSWV1_IMULinkStats_t;
+
+/*
+** IMU Sample Ring
+** Single-producer/single-consumer ring between the IMU reader child task
+** (producer) and the main task (consumer). Head is only written by the
+** producer and Tail only by the consumer, so no locks are needed.
+*/
+typedef struct
+{
+    FSWV1_IMUData_t Samples[FSWV1_IMU_RING_SIZE];
+    uint32 Head;       /* Next slot to write (producer owned) */
+    uint32 Tail;       /* Next slot to read (consumer owned) */
+    uint32 Overflows;  /* Samples dropped because the ring was full */
+    uint32 HighWater;  /* Maximum occupancy seen by the producer */
+} FSWV1_IMURing_t;
+
+/*
+** Rate Group
+** Deadlines are absolute CLOCK_MONOTONIC times advanced by whole periods,
+** so the schedule never drifts with cycle execution time.
+*/
+typedef struct
+{
+    uint32 RateHz;          /* 0 = disabled */
+    uint64 PeriodNs;
+    uint64 NextDeadlineNs;
+    uint32 RunCount;
+    uint32 SkippedCount;    /* Deadlines that passed without a run */
+} FSWV1_RateGroup_t;
+
+/*
+** Cycle Deadline Monitor
+*/
+typedef struct
+{
+    bool   Degraded;                          /* Optional work is skipped */
+    uint32 DegradedEntries;
+    uint32 Overruns[FSWV1_APP_STAGE_COUNT];   /* Overruns by slowest stage */
+    uint64 MaxExecNs;
+} FSWV1_DeadlineMonitor_t;
+
+/*
+** Time-Tagged Command Queue Statistics
+*/
+typedef struct
+{
+    uint32 Occupancy;
+    uint32 HighWater;
+    uint32 ExecutedCount;
+    uint32 LateCount;
+    uint32 MaxLateUs;
+    uint32 RejectedCount;
+} FSWV1_TTQStats_t;
+
 /*
 ** Global Data Structure
 */
@@ -86,6 +348,21 @@ typedef struct
     */
     FSWV1_APP_CombinedTlm_t CombinedTlm;
 
+    /*
+    ** Performance telemetry packet (sent with housekeeping)
+    */
+    FSWV1_APP_PerfTlm_t PerfTlm;
+
+    /*
+    ** IMU telemetry packets, one per instance (filled as samples arrive)
+    */
+    FSWV1_APP_ImuTlm_t ImuTlm[FSWV1_IMU_MAX_INSTANCES];
+
+    /*
+    ** Barometer telemetry packets (samples of one instance each)
+    */
+    FSWV1_APP_BaroTlm_t BaroTlm[FSWV1_BMP_MAX_INSTANCES];
+
     /*
     ** Run Status variable
     */
@@ -96,6 +373,11 @@ typedef struct
     */
     CFE_SB_PipeId_t CommandPipe;
 
+    /*
+    ** Software Bus Pipe ID for cycle wakeups (kept apart from commands)
+    */
+    CFE_SB_PipeId_t WakeupPipe;
+
     /*
     ** Event table ID
     */
@@ -109,12 +391,15 @@ typedef struct
     /*
     ** Sensor data
     */
-    FSWV1_SensorData_t SensorData;
+    FSWV1_SensorData_t SensorData;                              /* Newest primary instance sample */
+    FSWV1_SensorData_t SensorSamples[FSWV1_BMP_DRAIN_MAX];     /* Last collection */
     
     /*
     ** IMU data
     */
     FSWV1_IMUData_t IMUData;
+    FSWV1_IMUData_t IMUSamples[FSWV1_IMU_DRAIN_MAX]; /* Last drain, oldest first */
+    uint32 IMUSampleCount;                             /* Valid entries in IMUSamples */
     
     /*
     ** App state
@@ -125,6 +410,42 @@ typedef struct
     uint16 CombinedTlmSeqCnt;
     bool LedState;
 
+    /*
+    ** Cycle accounting
+    */
+    uint32 CycleCount;
+    uint32 MissedCycles;
+
+    /*
+    ** Per-subsystem rate groups (FSWV1_APP_RATE_GROUP_xxx)
+    */
+    FSWV1_RateGroup_t RateGroups[FSWV1_APP_RATE_GROUP_COUNT];
+
+    /*
+    ** Data-ready triggering (FSWV1_DRDY_RATE_GROUP runs on edges, not its timer)
+    */
+    bool   DrdyActive;
+    uint32 DrdyMaxLatencyUs;   /* Kernel edge timestamp to acquisition complete */
+
+    /*
+    ** Command drain budget and pipe statistics
+    */
+    uint16 CmdBudgetMsgs;
+    uint32 CmdBudgetUs;
+    uint32 CmdBurstCount;      /* Commands drained since the pipe was last empty */
+    uint16 CmdBurstHighWater;  /* Largest CmdBurstCount seen */
+    uint32 CmdDeferredCount;
+
+    /*
+    ** Cycle deadline monitor
+    */
+    FSWV1_DeadlineMonitor_t Deadline;
+
+    /*
+    ** Time-tagged command queue statistics
+    */
+    FSWV1_TTQStats_t Ttq;
+
 } FSWV1_APP_Data_t;
 
 /*
@@ -141,6 +462,8 @@ extern FSWV1_APP_Data_t FSWV1_APP_Data;
 ** Application entry point and main process loop
 */
 void FSWV1_APP_Main(void);
+void FSWV1_APP_RunCycle(void);
+void FSWV1_APP_ProcessCommands(void);
 
 /*
 ** Application initialization
@@ -165,20 +488,60 @@ int32 FSWV1_APP_LedOn(const FSWV1_APP_LedOnCmd_t *Msg);
 int32 FSWV1_APP_LedOff(const FSWV1_APP_LedOffCmd_t *Msg);
 int32 FSWV1_APP_LedToggle(const FSWV1_APP_LedToggleCmd_t *Msg);
 int32 FSWV1_APP_LedStatus(const FSWV1_APP_LedStatusCmd_t *Msg);
+int32 FSWV1_APP_SetRate(const FSWV1_APP_SetRateCmd_t *Msg);
+int32 FSWV1_APP_ResetPerf(const FSWV1_APP_ResetPerfCmd_t *Msg);
+int32 FSWV1_APP_SetCmdBudget(const FSWV1_APP_SetCmdBudgetCmd_t *Msg);
+int32 FSWV1_APP_SetRtProfile(const FSWV1_APP_SetRtProfileCmd_t *Msg);
+int32 FSWV1_APP_RtJitterReport(const FSWV1_APP_RtJitterReportCmd_t *Msg);
+int32 FSWV1_APP_TimeTag(const FSWV1_APP_TimeTagCmd_t *Msg);
+int32 FSWV1_APP_TtqClear(const FSWV1_APP_TtqClearCmd_t *Msg);
+int32 FSWV1_APP_SetImuFormat(const FSWV1_APP_SetImuFormatCmd_t *Msg);
+int32 FSWV1_APP_SetBmpProfile(const FSWV1_APP_SetBmpProfileCmd_t *Msg);
 
 /*
 ** BMP280 Sensor functions
 */
 int32 FSWV1_InitSensor(void);
-int32 FSWV1_ReadSensor(FSWV1_SensorData_t *Data);
+int32 FSWV1_StartSensorTasks(void);
+int32 FSWV1_TriggerSensors(uint64 EdgeNs);
+int32 FSWV1_ReadSensors(FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count);
 void FSWV1_CloseSensor(void);
+void FSWV1_GetSensorBusStats(uint32 *Transactions, uint32 *Errors, uint32 *Bytes, uint32 *SampleTxns);
+int32 FSWV1_SetSensorProfile(uint8 Instance, const FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile);
+int32 FSWV1_GetSensorProfile(uint8 Instance, FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile,
+                             uint32 *MeasTimeUs, uint32 *NotReady);
+void FSWV1_GetSensorInstances(uint8 *Configured, uint8 *HealthyMask, uint8 *Buses, uint8 *TaskMask);
+int32 FSWV1_GetSensorInstanceStats(uint8 Instance, FSWV1_BaroStats_t *Stats);
+int32 FSWV1_GetSensorBusPassStats(uint8 Bus, uint32 *Passes, uint32 *Overruns, uint32 *MaxPassUs);
 
 /*
 ** UART/IMU functions (for receiving IMU data)
 */
 int32 FSWV1_InitUART(void);
 int32 FSWV1_ReadUART(FSWV1_IMUData_t *Data);
+int32 FSWV1_ReadUARTFrames(FSWV1_IMUData_t *Samples, uint32 MaxSamples, uint32 *Count);
 void FSWV1_CloseUART(void);
+int32 FSWV1_StartIMUTask(void);
+int32 FSWV1_ServiceUART(void);
+int FSWV1_GetUARTFd(uint8 Instance);
+void FSWV1_GetIMURingStats(uint32 *Overflows, uint32 *HighWater);
+void FSWV1_GetUARTReadStats(uint32 *ReadCalls, uint32 *BytesRead);
+void FSWV1_GetIMUParseStats(uint32 *ParseErrors, uint32 *LastBadField);
+uint32 FSWV1_GetIMUDrainDropped(void);
+int32 FSWV1_SetIMUFormat(uint8 Format);
+void FSWV1_GetIMUFormatStats(uint8 *Format, uint8 *Active, uint32 *CrcErrors, uint32 *Resyncs);
+void FSWV1_GetIMULinkStats(FSWV1_IMULinkStats_t *Stats);
+void FSWV1_GetIMUInstances(uint8 *Configured, uint8 *OpenMask);
+int32 FSWV1_GetIMUInstanceStats(uint8 Instance, FSWV1_IMULinkStats_t *Stats, uint8 *FormatActive);
+
+/*
+** IMU sample ring (lock-free SPSC)
+*/
+void FSWV1_IMURing_Init(FSWV1_IMURing_t *Ring);
+bool FSWV1_IMURing_Push(FSWV1_IMURing_t *Ring, const FSWV1_IMUData_t *Sample);
+bool FSWV1_IMURing_Pop(FSWV1_IMURing_t *Ring, FSWV1_IMUData_t *Sample);
+const FSWV1_IMUData_t *FSWV1_IMURing_Peek(const FSWV1_IMURing_t *Ring);
+uint32 FSWV1_IMURing_Count(const FSWV1_IMURing_t *Ring);
 
 /*
 ** UART Telemetry functions (for transmitting telemetry data)
@@ -186,6 +549,9 @@ void FSWV1_CloseUART(void);
 int32 FSWV1_InitTelemetryUART(void);
 int32 FSWV1_SendTelemetryUART(const FSWV1_SensorData_t *SensorData, const FSWV1_IMUData_t *IMUData);
 void FSWV1_CloseTelemetryUART(void);
+int32 FSWV1_FlushTelemetryUART(void);
+int FSWV1_GetTelemetryUARTFd(void);
+uint32 FSWV1_TelemetryUARTPending(void);
 
 /*
 ** GPIO functions
@@ -195,6 +561,85 @@ int32 FSWV1_SetLED(bool state);
 int32 FSWV1_GetLED(bool *state);
 int32 FSWV1_ToggleLED(void);
 void FSWV1_CloseGPIO(void);
+int32 FSWV1_InitDataReady(void);
+int FSWV1_GetDataReadyFd(void);
+int32 FSWV1_ReadDataReady(uint64 *EdgeNs);
+void FSWV1_GetDataReadyStats(uint32 *Edges, uint32 *Missed);
+void FSWV1_CloseDataReady(void);
+void FSWV1_APP_DataReady(void);
+
+/*
+** Cycle scheduling functions
+*/
+int32 FSWV1_InitSched(void);
+int32 FSWV1_WaitForWakeup(uint32 *MissedCycles);
+void FSWV1_CloseSched(void);
+uint64 FSWV1_Sched_NowNs(void);
+void FSWV1_InitRateGroups(void);
+int32 FSWV1_SetRateGroup(uint8 Group, uint32 RateHz);
+bool FSWV1_RateGroupDue(uint8 Group, uint64 NowNs);
+
+/*
+** Event loop functions (FSWV1_WAKEUP_SOURCE_EPOLL)
+*/
+int32 FSWV1_InitEventLoop(void);
+int32 FSWV1_EventLoopWait(uint32 *MissedCycles);
+void FSWV1_CloseEventLoop(void);
+
+/*
+** Time source functions
+*/
+uint64 FSWV1_Time_MonoNs(void);
+CFE_TIME_SysTime_t FSWV1_Time_GetTime(void);
+CFE_TIME_SysTime_t FSWV1_Time_MonoToTime(uint64 MonoNs);
+void FSWV1_Time_SleepNs(uint64 Ns);
+void FSWV1_Time_StampMsg(CFE_MSG_Message_t *MsgPtr);
+bool FSWV1_Time_SimTick(void);
+
+/*
+** Synthetic sensor source functions (FSWV1_TIME_SOURCE_SIM)
+*/
+void FSWV1_SimSrc_Reset(void);
+int32 FSWV1_SimSrc_TriggerSensors(void);
+int32 FSWV1_SimSrc_ReadSensors(FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count);
+int32 FSWV1_SimSrc_ReadIMU(FSWV1_IMUData_t *Samples, uint32 MaxSamples, uint32 *Count);
+
+/*
+** Cycle deadline monitor functions
+*/
+void FSWV1_Deadline_Reset(void);
+void FSWV1_Deadline_BeginCycle(void);
+void FSWV1_Deadline_StageTime(uint8 Stage, uint64 DurationNs);
+void FSWV1_Deadline_EndCycle(uint64 ExecNs);
+bool FSWV1_Deadline_Degraded(void);
+
+/*
+** Real-time profile functions
+*/
+int32 FSWV1_RT_Init(void);
+int32 FSWV1_RT_RegisterTask(uint8 Task);
+void FSWV1_RT_UnregisterTask(uint8 Task);
+int32 FSWV1_RT_SetProfile(uint8 Profile, uint8 *FailedMask);
+uint8 FSWV1_RT_GetProfile(void);
+void FSWV1_RT_RecordPeriod(uint64 PeriodNs);
+void FSWV1_RT_ReportJitter(void);
+void FSWV1_RT_ResetJitter(void);
+
+/*
+** Time-tagged command queue functions
+*/
+void FSWV1_TTQ_Init(void);
+int32 FSWV1_TTQ_Insert(CFE_TIME_SysTime_t ExecTime, uint8 CommandCode, const uint8 *Args, uint16 ArgLength);
+void FSWV1_TTQ_Process(uint64 WindowEndNs);
+void FSWV1_TTQ_Clear(void);
+
+/*
+** Performance measurement functions
+*/
+void FSWV1_Perf_Record(uint8 Probe, uint64 DurationNs);
+void FSWV1_Perf_Stop(uint8 Probe, uint64 StartNs);
+void FSWV1_Perf_Reset(void);
+void FSWV1_Perf_SendTlm(void);
 
 /*
 ** UDP functions
@@ -219,10 +664,20 @@ bool FSWV1_APP_VerifyCommandLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLen
 #define FSWV1_APP_REVISION 0
 
 /*
-** I2C Configuration (BMP280)
+** I2C Configuration (barometers)
+** FSWV1_BMP_DEVICES lists the barometers as { bus device, 7-bit address }
+** or { bus device, 7-bit address, FSWV1_BMP_CHIP_xxx } entries; entry n is
+** instance n. Without a chip the BMP280 and BMP388/BMP390 drivers are
+** tried by chip ID. For several barometers, set it to a comma-separated
+** list, e.g.
+**   { "/dev/i2c-1", 0x76 }, { "/dev/i2c-1", 0x77, FSWV1_BMP_CHIP_BMP390 }
+** Entries naming the same bus device share one descriptor and reader task.
 */
 #define FSWV1_I2C_DEVICE "/dev/i2c-1"
 #define FSWV1_I2C_ADDRESS 0x76
+#ifndef FSWV1_BMP_DEVICES
+#define FSWV1_BMP_DEVICES { FSWV1_I2C_DEVICE, FSWV1_I2C_ADDRESS, FSWV1_BMP_CHIP_AUTO }
+#endif
 
 /*
 ** UART Configuration (IMU)
@@ -234,6 +689,28 @@ bool FSWV1_APP_VerifyCommandLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLen
 */
 #define FSWV1_GPIO_PIN 17
 
+/*
+** GPIO Configuration (data-ready input)
+** When enabled, an edge on FSWV1_DRDY_LINE runs rate group FSWV1_DRDY_RATE_GROUP
+** instead of its timer, timestamped with the kernel's CLOCK_MONOTONIC edge time.
+** The epoll wakeup source acquires on the edge itself; the other sources pick up
+** the newest edge once per cycle. FSWV1_DRDY_CHIP_PATH may name a gpio-sim chip
+** for bench testing (see drdy_sim.sh). Not used with FSWV1_TIME_SOURCE_SIM.
+*/
+#ifndef FSWV1_DRDY_ENABLE
+#define FSWV1_DRDY_ENABLE        0
+#endif
+#ifndef FSWV1_DRDY_CHIP_PATH
+#define FSWV1_DRDY_CHIP_PATH     "/dev/gpiochip4"
+#endif
+#ifndef FSWV1_DRDY_LINE
+#define FSWV1_DRDY_LINE          27
+#endif
+#define FSWV1_DRDY_FALLING_EDGE  0    /* 0 = rising (active-high DRDY), 1 = falling */
+#define FSWV1_DRDY_DEBOUNCE_US   0
+#define FSWV1_DRDY_RATE_GROUP    FSWV1_APP_RATE_GROUP_BMP280
+#define FSWV1_DRDY_EVENT_BUFFER  16
+
 /*
 ** UDP Configuration
 */
@@ -241,9 +718,81 @@ bool FSWV1_APP_VerifyCommandLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLen
 #define FSWV1_UDP_DEST_IP "100.99.41.92"
 
 /*
-** Sensor Read Rate
+** Default Rate Group Rates (Hz, 0 = disabled)
+** Every rate must be at or below FSWV1_APP_WAKEUP_RATE_HZ; SET_RATE rejects
+** anything faster. A group deadline is taken as reached up to
+** FSWV1_RATE_GROUP_TOLERANCE_NS early, so it runs at the nearest wakeup.
+*/
+#define FSWV1_DEFAULT_READ_RATE  25   /* BMP280 */
+#define FSWV1_DEFAULT_IMU_RATE   FSWV1_APP_WAKEUP_RATE_HZ   /* Every wakeup */
+#define FSWV1_DEFAULT_TLM_RATE   50
+#define FSWV1_DEFAULT_HK_RATE    0    /* HK follows SEND_HK from sch_lab */
+
+/*
+** Cycle Scheduling
+** FSWV1_APP_WAKEUP_SOURCE selects what starts each acquisition/telemetry cycle:
+** - FSWV1_WAKEUP_SOURCE_SCH:   FSWV1_APP_WAKEUP_MID sent by sch_lab, expected
+**   at FSWV1_APP_SCH_CYCLE_RATE_HZ (sch_lab tick rate / PacketRate)
+** - FSWV1_WAKEUP_SOURCE_TIMER: internal OSAL timer at FSWV1_APP_CYCLE_RATE_HZ
+** - FSWV1_WAKEUP_SOURCE_EPOLL: epoll event loop with a timerfd at
+**   FSWV1_APP_CYCLE_RATE_HZ; IMU UART input and telemetry UART output are
+**   serviced as soon as the descriptors are ready (Linux only)
+*/
+#define FSWV1_WAKEUP_SOURCE_SCH    0
+#define FSWV1_WAKEUP_SOURCE_TIMER  1
+#define FSWV1_WAKEUP_SOURCE_EPOLL  2
+
+#define FSWV1_APP_WAKEUP_SOURCE      FSWV1_WAKEUP_SOURCE_SCH
+#define FSWV1_APP_CYCLE_RATE_HZ      400   /* Internal timer/timerfd rate (Hz) */
+#define FSWV1_APP_SCH_CYCLE_RATE_HZ  100   /* sch_lab wakeup rate (Hz) */
+#define FSWV1_APP_MAX_CYCLE_RATE_HZ  1000
+#define FSWV1_APP_WAKEUP_PIPE_DEPTH  8
+#define FSWV1_APP_WAKEUP_TIMEOUT_MS  1000  /* Service commands even if wakeups stop */
+
+#define FSWV1_RATE_GROUP_TOLERANCE_NS  (500000000ULL / FSWV1_APP_WAKEUP_RATE_HZ)   /* Half a cycle */
+
+/*
+** Time Source
+** - FSWV1_TIME_SOURCE_REAL: CFE time and CLOCK_MONOTONIC
+** - FSWV1_TIME_SOURCE_SIM:  simulated clock advanced one cycle period per
+**   wakeup; cycles run back-to-back (FSWV1_APP_WAKEUP_SOURCE and the IMU
+**   reader task are not used) and the app exits after FSWV1_SIM_DURATION_S
+**   simulated seconds (0 = run forever). Simulated CFE time starts at
+**   FSWV1_SIM_EPOCH_SECONDS. The sensors are not opened: the rate groups
+**   read synthetic samples at FSWV1_SIM_BMP_RATE_HZ / FSWV1_SIM_IMU_RATE_HZ
+**   whose values depend only on their index and FSWV1_SIM_SEED.
+*/
+#define FSWV1_TIME_SOURCE_REAL     0
+#define FSWV1_TIME_SOURCE_SIM      1
+
+#define FSWV1_APP_TIME_SOURCE      FSWV1_TIME_SOURCE_REAL
+#define FSWV1_SIM_DURATION_S       86400
+#define FSWV1_SIM_EPOCH_SECONDS    1000000000
+#define FSWV1_SIM_BMP_RATE_HZ      25
+#define FSWV1_SIM_IMU_RATE_HZ      400
+#define FSWV1_SIM_SEED             1
+
+/*
+** Rate the cycles actually start at. Rate group limits, the group deadline
+** tolerance, the cycle deadline and the time-tag lookahead derive from it.
+*/
+#if FSWV1_APP_TIME_SOURCE != FSWV1_TIME_SOURCE_SIM && FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_SCH
+#define FSWV1_APP_WAKEUP_RATE_HZ   FSWV1_APP_SCH_CYCLE_RATE_HZ
+#else
+#define FSWV1_APP_WAKEUP_RATE_HZ   FSWV1_APP_CYCLE_RATE_HZ
+#endif
+
+/*
+** Cycle Deadline Monitor
+** A cycle overruns when its execution time exceeds FSWV1_APP_CYCLE_DEADLINE_US.
+** Degraded mode (no console prints or ASCII telemetry formatting) starts after
+** FSWV1_DEADLINE_DEGRADE_COUNT consecutive overruns and ends after
+** FSWV1_DEADLINE_RECOVER_COUNT consecutive cycles within the deadline.
 */
-#define FSWV1_DEFAULT_READ_RATE 1  /* Hz */
+#define FSWV1_APP_CYCLE_DEADLINE_US    (1000000 / FSWV1_APP_WAKEUP_RATE_HZ)
+#define FSWV1_DEADLINE_DEGRADE_COUNT   5
+#define FSWV1_DEADLINE_RECOVER_COUNT   100
+#define FSWV1_DEADLINE_EVENT_MIN_MS    5000
 
 /*
 ** Event IDs
@@ -270,5 +819,28 @@ bool FSWV1_APP_VerifyCommandLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLen
 #define FSWV1_APP_IMU_ERR_EID       19
 #define FSWV1_APP_UART_TELEMETRY_INIT_INF_EID 20
 #define FSWV1_APP_UART_TELEMETRY_ERR_EID      21
+#define FSWV1_APP_SCHED_INIT_INF_EID          22
+#define FSWV1_APP_SCHED_ERR_EID               23
+#define FSWV1_APP_IMU_TASK_INF_EID            24
+#define FSWV1_APP_SET_RATE_INF_EID            25
+#define FSWV1_APP_SET_RATE_ERR_EID            26
+#define FSWV1_APP_RESET_PERF_INF_EID          27
+#define FSWV1_APP_CMD_BUDGET_INF_EID          28
+#define FSWV1_APP_DEADLINE_INF_EID            29
+#define FSWV1_APP_DEADLINE_ERR_EID            30
+#define FSWV1_APP_RT_INF_EID                  31
+#define FSWV1_APP_RT_ERR_EID                  32
+#define FSWV1_APP_RT_JITTER_INF_EID           33
+#define FSWV1_APP_TTQ_INF_EID                 34
+#define FSWV1_APP_TTQ_ERR_EID                 35
+#define FSWV1_APP_IMU_FORMAT_INF_EID          36
+#define FSWV1_APP_IMU_FORMAT_ERR_EID          37
+#define FSWV1_APP_DRDY_INF_EID                38
+#define FSWV1_APP_DRDY_ERR_EID                39
+#define FSWV1_APP_BMP_PROFILE_INF_EID         40
+#define FSWV1_APP_BMP_PROFILE_ERR_EID         41
+#define FSWV1_APP_BMP_HEALTH_INF_EID          42
+#define FSWV1_APP_BMP_HEALTH_ERR_EID          43
+#define FSWV1_APP_CMD_BUDGET_ERR_EID          44
 
 #endif /* FSWV1_APP_H */
@@ -25,6 +25,115 @@
 #define FSWV1_APP_LED_OFF_CC        5
 #define FSWV1_APP_LED_TOGGLE_CC     6
 #define FSWV1_APP_LED_STATUS_CC     7
+#define FSWV1_APP_SET_RATE_CC       8
+#define FSWV1_APP_RESET_PERF_CC     9
+#define FSWV1_APP_SET_CMD_BUDGET_CC 10
+#define FSWV1_APP_SET_RT_PROFILE_CC 11
+#define FSWV1_APP_RT_JITTER_RPT_CC  12
+#define FSWV1_APP_TIME_TAG_CC       13
+#define FSWV1_APP_TTQ_CLEAR_CC      14
+#define FSWV1_APP_SET_IMU_FORMAT_CC 15
+#define FSWV1_APP_SET_BMP_PROFILE_CC 16
+
+/*
+** Rate Groups (SET_RATE_CC RateGroup argument)
+*/
+#define FSWV1_APP_RATE_GROUP_BMP280  0   /* BMP280 acquisition */
+#define FSWV1_APP_RATE_GROUP_IMU     1   /* IMU sample consumption */
+#define FSWV1_APP_RATE_GROUP_TLM     2   /* Combined telemetry (SB, UDP, UART) */
+#define FSWV1_APP_RATE_GROUP_HK      3   /* Housekeeping (0 = on SEND_HK only) */
+#define FSWV1_APP_RATE_GROUP_COUNT   4
+
+/*
+** Performance Probes (index into FSWV1_APP_PerfTlm_Payload_t.Probes)
+*/
+#define FSWV1_APP_PERF_READ_SENSOR    0   /* FSWV1_TriggerSensors */
+#define FSWV1_APP_PERF_READ_UART      1   /* FSWV1_ReadUART */
+#define FSWV1_APP_PERF_SEND_UDP       2   /* FSWV1_SendUDP */
+#define FSWV1_APP_PERF_SEND_TLM_UART  3   /* FSWV1_SendTelemetryUART */
+#define FSWV1_APP_PERF_CYCLE_PERIOD   4   /* Start-to-start cycle period */
+#define FSWV1_APP_PERF_CYCLE_EXEC     5   /* Cycle execution time */
+#define FSWV1_APP_PERF_PROBE_COUNT    6
+
+/*
+** Real-Time Profiles (SET_RT_PROFILE_CC Profile argument)
+*/
+#define FSWV1_RT_PROFILE_DEFAULT      0   /* Scheduling as set up by OSAL */
+#define FSWV1_RT_PROFILE_REALTIME     1   /* SCHED_FIFO, pinned, memory locked */
+#define FSWV1_RT_PROFILE_COUNT        2
+
+/*
+** IMU Wire Formats (SET_IMU_FORMAT_CC Format argument)
+*/
+#define FSWV1_IMU_FORMAT_ASCII        0   /* "$,Ax,...,T,#" text frames */
+#define FSWV1_IMU_FORMAT_BINARY       1   /* COBS + CRC-16 frames (fswv1_imu_parse.h) */
+#define FSWV1_IMU_FORMAT_AUTO         2   /* Detect from the first good frame */
+#define FSWV1_IMU_FORMAT_COUNT        3
+
+/*
+** BMP280 Measurement Profile (SET_BMP_PROFILE_CC arguments, register encodings)
+*/
+#define FSWV1_BMP_OSRS_X1             1   /* Oversampling: 1 << (code - 1) samples */
+#define FSWV1_BMP_OSRS_X2             2
+#define FSWV1_BMP_OSRS_X4             3
+#define FSWV1_BMP_OSRS_X8             4
+#define FSWV1_BMP_OSRS_X16            5
+#define FSWV1_BMP_FILTER_OFF          0   /* IIR coefficient 2^code (1-4), 0 = off */
+#define FSWV1_BMP_FILTER_16           4
+#define FSWV1_BMP_STANDBY_0_5MS       0   /* Normal mode standby: 0.5, 62.5, 125, 250, */
+#define FSWV1_BMP_STANDBY_4000MS      7   /* 500, 1000, 2000, 4000 ms (codes 0-7) */
+#define FSWV1_BMP_MODE_FORCED         1   /* One conversion per read */
+#define FSWV1_BMP_MODE_NORMAL         3   /* Continuous conversions */
+
+/*
+** IMU instances (one per IMU UART) and samples per IMU telemetry packet
+*/
+#define FSWV1_IMU_MAX_INSTANCES       4
+#define FSWV1_IMU_TLM_SAMPLES         16
+
+/*
+** Barometer instances (entries of FSWV1_BMP_DEVICES) and the I2C buses
+** they can spread over
+*/
+#define FSWV1_BMP_MAX_INSTANCES       4
+#define FSWV1_BMP_MAX_BUSES           2
+#define FSWV1_BMP_ALL_INSTANCES       0xFF   /* SET_BMP_PROFILE_CC: every instance */
+#define FSWV1_BMP_TLM_SAMPLES         16
+
+/*
+** Barometer chips (FSWV1_BMP_DEVICES, BaroTlm Chip, HK BmpInstChip)
+*/
+#define FSWV1_BMP_CHIP_AUTO           0   /* Config: identify at probe; telemetry: not identified yet */
+#define FSWV1_BMP_CHIP_BMP280         1
+#define FSWV1_BMP_CHIP_BMP388         2
+#define FSWV1_BMP_CHIP_BMP390         3
+
+/*
+** Barometer health (BaroTlm Health, HK BmpInstHealth)
+*/
+#define FSWV1_BMP_HEALTH_OK           0
+#define FSWV1_BMP_HEALTH_DEGRADED     1   /* Last read failed */
+#define FSWV1_BMP_HEALTH_FAILED       2   /* FSWV1_BMP_FAIL_LIMIT failures in a row; re-probed */
+
+/*
+** Largest argument block a time-tagged command can carry
+*/
+#define FSWV1_TTQ_MAX_ARG_BYTES       16
+
+/*
+** Cycle Stages (deadline overrun causes, HK CycleOverruns index)
+*/
+#define FSWV1_APP_STAGE_SENSOR        0   /* BMP280 I2C read */
+#define FSWV1_APP_STAGE_IMU           1   /* IMU UART read */
+#define FSWV1_APP_STAGE_UDP           2   /* UDP telemetry send */
+#define FSWV1_APP_STAGE_UART          3   /* Telemetry UART send */
+#define FSWV1_APP_STAGE_COUNT         4
+
+/*
+** Histogram bucket b counts durations below 2^(b+10) ns (~1 us, 2 us, ...);
+** the last bucket also collects everything above ~16.8 ms.
+*/
+#define FSWV1_APP_PERF_BUCKETS        16
 
 /*
 ** Command Structures
@@ -70,6 +179,109 @@ typedef struct
     CFE_MSG_CommandHeader_t CmdHeader;
 } FSWV1_APP_LedStatusCmd_t;
 
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+} FSWV1_APP_ResetPerfCmd_t;
+
+typedef struct
+{
+    uint8  RateGroup;        /* FSWV1_APP_RATE_GROUP_xxx */
+    uint8  Spare[3];
+    uint32 RateHz;           /* 0 disables the group */
+} FSWV1_APP_SetRateCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t        CmdHeader;
+    FSWV1_APP_SetRateCmd_Payload_t Payload;
+} FSWV1_APP_SetRateCmd_t;
+
+typedef struct
+{
+    uint16 MaxMsgs;          /* Commands per drain, 0 = no message limit */
+    uint16 Spare;
+    uint32 MaxUs;            /* Microseconds per drain, 0 = no time limit (not both 0) */
+} FSWV1_APP_SetCmdBudgetCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t             CmdHeader;
+    FSWV1_APP_SetCmdBudgetCmd_Payload_t Payload;
+} FSWV1_APP_SetCmdBudgetCmd_t;
+
+typedef struct
+{
+    uint8 Profile;           /* FSWV1_RT_PROFILE_xxx */
+    uint8 Spare[3];
+} FSWV1_APP_SetRtProfileCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t             CmdHeader;
+    FSWV1_APP_SetRtProfileCmd_Payload_t Payload;
+} FSWV1_APP_SetRtProfileCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+} FSWV1_APP_RtJitterReportCmd_t;
+
+/*
+** TIME_TAG_CC wraps another fswv1 command: CommandCode plus the first
+** ArgLength bytes of Args are rebuilt into a command and executed when
+** CFE time reaches ExecSeconds/ExecSubseconds.
+*/
+typedef struct
+{
+    uint32 ExecSeconds;
+    uint32 ExecSubseconds;
+    uint8  CommandCode;      /* Wrapped command code (not TIME_TAG_CC) */
+    uint8  Spare;
+    uint16 ArgLength;        /* Bytes of Args used (wrapped payload size) */
+    uint8  Args[FSWV1_TTQ_MAX_ARG_BYTES];
+} FSWV1_APP_TimeTagCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t        CmdHeader;
+    FSWV1_APP_TimeTagCmd_Payload_t Payload;
+} FSWV1_APP_TimeTagCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+} FSWV1_APP_TtqClearCmd_t;
+
+typedef struct
+{
+    uint8 Format;            /* FSWV1_IMU_FORMAT_xxx */
+    uint8 Spare[3];
+} FSWV1_APP_SetImuFormatCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t             CmdHeader;
+    FSWV1_APP_SetImuFormatCmd_Payload_t Payload;
+} FSWV1_APP_SetImuFormatCmd_t;
+
+typedef struct
+{
+    uint8 OsrsT;             /* Temperature oversampling, FSWV1_BMP_OSRS_xxx */
+    uint8 OsrsP;             /* Pressure oversampling, FSWV1_BMP_OSRS_xxx */
+    uint8 Filter;            /* IIR filter code, FSWV1_BMP_FILTER_OFF..FSWV1_BMP_FILTER_16 */
+    uint8 Standby;           /* Normal mode standby code (0-7) */
+    uint8 Mode;              /* FSWV1_BMP_MODE_FORCED or FSWV1_BMP_MODE_NORMAL */
+    uint8 Instance;          /* Barometer instance, or FSWV1_BMP_ALL_INSTANCES */
+    uint8 Spare[2];
+} FSWV1_APP_SetBmpProfileCmd_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t              CmdHeader;
+    FSWV1_APP_SetBmpProfileCmd_Payload_t Payload;
+} FSWV1_APP_SetBmpProfileCmd_t;
+
 /*
 ** Telemetry Structures
 */
@@ -83,6 +295,93 @@ typedef struct
     uint8  IMUEnabled;
     uint32 ReadRate;
     uint8  LedState;
+    uint8  Spare[3];
+    uint32 CycleCount;       /* Acquisition/telemetry cycles executed */
+    uint32 MissedCycles;     /* Wakeups that arrived while a cycle was pending */
+    uint32 ImuRingOverflows; /* IMU samples dropped because the ring was full */
+    uint32 ImuRingHighWater; /* Maximum IMU ring occupancy (samples) */
+    uint32 RateGroupHz[FSWV1_APP_RATE_GROUP_COUNT];      /* Configured rates */
+    uint32 RateGroupSkipped[FSWV1_APP_RATE_GROUP_COUNT]; /* Deadlines passed without running */
+    uint16 CmdBudgetMsgs;    /* Command drain budget (messages, 0 = none) */
+    uint16 CmdBurstHighWater; /* Most commands drained before the pipe was seen empty */
+    uint32 CmdBudgetUs;      /* Command drain budget (microseconds, 0 = none) */
+    uint32 CmdDeferredCount; /* Drains cut short by the budget, leaving commands queued */
+    uint32 CycleOverruns[FSWV1_APP_STAGE_COUNT]; /* Deadline overruns by slowest stage */
+    uint32 MaxCycleExecUs;   /* Longest cycle execution time */
+    uint32 DegradedEntries;  /* Times degraded mode was entered */
+    uint8  Degraded;         /* 1 = optional work is being skipped */
+    uint8  RtProfile;        /* Active FSWV1_RT_PROFILE_xxx */
+    uint8  Spare2[2];
+    uint16 TtqOccupancy;     /* Time-tagged commands waiting */
+    uint16 TtqHighWater;     /* Most time-tagged commands ever waiting */
+    uint32 TtqExecuted;      /* Time-tagged commands executed */
+    uint32 TtqLate;          /* Executed later than FSWV1_TTQ_LATE_TOLERANCE_US */
+    uint32 TtqMaxLateUs;     /* Worst execution lateness */
+    uint32 TtqRejected;      /* Tags refused (queue full or bad arguments) */
+    uint32 ImuUartReadCalls; /* read() calls on the IMU UART */
+    uint32 ImuUartBytesRead; /* Bytes returned by those calls */
+    uint32 ImuUartBytesPerRead; /* ImuUartBytesRead / ImuUartReadCalls */
+    uint32 ImuParseErrors;   /* Framed IMU messages that failed to parse */
+    uint32 ImuLastBadField;  /* Field index (0-6) of the most recent parse failure */
+    uint32 ImuLastDrainCount; /* IMU samples returned by the most recent drain */
+    uint32 ImuDrainDropped;  /* Samples discarded because a drain batch was full */
+    uint8  ImuFormat;        /* Commanded FSWV1_IMU_FORMAT_xxx */
+    uint8  ImuFormatActive;  /* Format being decoded (AUTO = not detected yet) */
+    uint8  Spare3[2];
+    uint32 ImuCrcErrors;     /* Binary frames that failed the CRC */
+    uint32 ImuResyncs;       /* Binary framing losses (bad COBS, length or oversize) */
+    uint32 ImuFramesGood;    /* IMU frames decoded */
+    uint32 ImuOverflows;     /* ASCII frames longer than the receive buffer */
+    uint32 ImuTruncated;     /* ASCII frames missing their '$' or '#' */
+    uint32 ImuReadErrors;    /* IMU UART read() failures */
+    uint32 ImuSeqGaps;       /* Jumps in the sender frame counter */
+    uint32 ImuSeqLost;       /* Frames missing according to the sender counter */
+    uint32 ImuSeqResets;     /* Sender counter went backwards */
+    uint32 ImuIntervalUs;    /* Smoothed frame inter-arrival time */
+    uint32 ImuJitterUs;      /* Smoothed inter-arrival jitter */
+    uint32 ImuMaxIntervalUs; /* Longest frame inter-arrival time */
+    uint8  ImuInstances;     /* IMU UARTs configured (UART_DEVICES) */
+    uint8  ImuOpenMask;      /* Bit n set: IMU instance n is open */
+    uint8  ImuInstFormatActive[FSWV1_IMU_MAX_INSTANCES]; /* ImuFormatActive per instance */
+    uint8  Spare4[2];
+    uint32 ImuInstFramesGood[FSWV1_IMU_MAX_INSTANCES];    /* ImuFramesGood per instance */
+    uint32 ImuInstBadFrames[FSWV1_IMU_MAX_INSTANCES];     /* Parse, CRC, framing, overflow and truncation failures */
+    uint32 ImuInstSeqLost[FSWV1_IMU_MAX_INSTANCES];       /* ImuSeqLost per instance */
+    uint32 ImuInstMaxIntervalUs[FSWV1_IMU_MAX_INSTANCES]; /* ImuMaxIntervalUs per instance */
+
+    /* Data-ready triggering */
+    uint8  DrdyActive;             /* Edges drive the data-ready rate group */
+    uint8  Spare5[3];
+    uint32 DrdyEdges;              /* Edges seen by the kernel */
+    uint32 DrdyMissed;             /* Edges coalesced or dropped before acquisition */
+    uint32 DrdyMaxLatencyUs;       /* Worst edge-to-acquisition latency (BMP bus tasks: edge to wakeup) */
+
+    /* BMP280 I2C buses (one I2C_RDWR ioctl per transaction), all buses */
+    uint32 SensorI2cTransactions;  /* Transactions issued */
+    uint32 SensorI2cErrors;        /* Transactions that failed */
+    uint32 SensorI2cBytes;         /* Address and data bytes transferred */
+    uint32 SensorI2cTxnPerSample;  /* Transactions used by the primary instance's last read */
+
+    /* BMP280 measurement profile (primary instance) */
+    FSWV1_APP_SetBmpProfileCmd_Payload_t BmpProfile;   /* Active profile */
+    uint32 BmpMeasTimeUs;          /* Worst-case conversion time of the profile */
+    uint32 BmpNotReady;            /* Reads with no new conversion available */
+
+    /* Barometer instances */
+    uint8  BmpInstances;           /* Barometers configured (FSWV1_BMP_DEVICES) */
+    uint8  BmpHealthyMask;         /* Bit n set: instance n is FSWV1_BMP_HEALTH_OK */
+    uint8  BmpBuses;               /* I2C buses they are on */
+    uint8  BmpBusTaskMask;         /* Bit n set: bus n has its own reader task */
+    uint8  BmpInstHealth[FSWV1_BMP_MAX_INSTANCES];      /* FSWV1_BMP_HEALTH_xxx */
+    uint8  BmpInstChip[FSWV1_BMP_MAX_INSTANCES];        /* FSWV1_BMP_CHIP_xxx */
+    uint32 BmpInstSamples[FSWV1_BMP_MAX_INSTANCES];     /* Samples published */
+    uint32 BmpInstNotReady[FSWV1_BMP_MAX_INSTANCES];    /* BmpNotReady per instance */
+    uint32 BmpInstReadErrors[FSWV1_BMP_MAX_INSTANCES];  /* Failed reads */
+    uint32 BmpInstRecoveries[FSWV1_BMP_MAX_INSTANCES];  /* Failed devices found again by a re-probe */
+    uint32 BmpInstFifoFull[FSWV1_BMP_MAX_INSTANCES];    /* FIFO bursts that found the FIFO full */
+    uint32 BmpBusPasses[FSWV1_BMP_MAX_BUSES];           /* Read passes over the bus's devices */
+    uint32 BmpBusOverruns[FSWV1_BMP_MAX_BUSES];         /* Triggers while the last pass was still running */
+    uint32 BmpBusMaxPassUs[FSWV1_BMP_MAX_BUSES];        /* Longest read pass */
 } FSWV1_APP_HkTlm_Payload_t;
 
 /* Housekeeping Telemetry */
@@ -92,6 +391,30 @@ typedef struct
     FSWV1_APP_HkTlm_Payload_t Payload;
 } FSWV1_APP_HkTlm_t;
 
+/* Performance Telemetry - one probe (times in microseconds) */
+typedef struct
+{
+    uint32 Count;
+    uint32 MinUs;
+    uint32 MaxUs;
+    uint32 MeanUs;
+    uint32 P99Us;            /* Upper bound of the bucket holding the 99th percentile */
+    uint32 Buckets[FSWV1_APP_PERF_BUCKETS];
+} FSWV1_APP_PerfProbe_t;
+
+/* Performance Telemetry Payload */
+typedef struct
+{
+    FSWV1_APP_PerfProbe_t Probes[FSWV1_APP_PERF_PROBE_COUNT];
+} FSWV1_APP_PerfTlm_Payload_t;
+
+/* Performance Telemetry */
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t    TelemetryHeader;
+    FSWV1_APP_PerfTlm_Payload_t Payload;
+} FSWV1_APP_PerfTlm_t;
+
 /* Combined Sensor + IMU Telemetry Payload */
 typedef struct
 {
@@ -108,7 +431,11 @@ typedef struct
     float  Gyro_Z;           /* Gyroscope Z-axis */
     float  IMU_Temperature;  /* IMU temperature (°C) */
     
-    uint32 Timestamp;        /* Timestamp */
+    uint32 Timestamp;        /* Send time (seconds) */
+    
+    /* Sample times: when the I2C read completed / the IMU frame arrived */
+    CFE_TIME_SysTime_t BMP_Time;
+    CFE_TIME_SysTime_t IMU_Time;
 } FSWV1_APP_CombinedTlm_Payload_t;
 
 /* Combined Telemetry */
@@ -118,4 +445,61 @@ typedef struct
     FSWV1_APP_CombinedTlm_Payload_t  Payload;
 } FSWV1_APP_CombinedTlm_t;
 
+/* IMU Telemetry - one sample */
+typedef struct
+{
+    CFE_TIME_SysTime_t Time; /* Frame arrival time */
+    float  Accel_X;          /* Accelerometer X-axis */
+    float  Accel_Y;          /* Accelerometer Y-axis */
+    float  Accel_Z;          /* Accelerometer Z-axis */
+    float  Gyro_X;           /* Gyroscope X-axis */
+    float  Gyro_Y;           /* Gyroscope Y-axis */
+    float  Gyro_Z;           /* Gyroscope Z-axis */
+    float  Temperature;      /* IMU temperature (°C) */
+} FSWV1_APP_ImuSample_t;
+
+/* IMU Telemetry Payload - samples of one instance, oldest first */
+typedef struct
+{
+    uint8  Instance;         /* IMU instance (entry of UART_DEVICES) */
+    uint8  Count;            /* Valid entries in Samples */
+    uint8  Spare[2];
+    FSWV1_APP_ImuSample_t Samples[FSWV1_IMU_TLM_SAMPLES];
+} FSWV1_APP_ImuTlm_Payload_t;
+
+/* IMU Telemetry */
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t    TelemetryHeader;
+    FSWV1_APP_ImuTlm_Payload_t  Payload;
+} FSWV1_APP_ImuTlm_t;
+
+/* Barometer Telemetry - one sample */
+typedef struct
+{
+    CFE_TIME_SysTime_t Time; /* Sample time */
+    float  Temperature;      /* Temperature (°C) */
+    float  Pressure;         /* Pressure (hPa) */
+} FSWV1_APP_BaroSample_t;
+
+/* Barometer Telemetry Payload - samples of one instance, oldest first */
+typedef struct
+{
+    uint8  Instance;         /* Barometer instance (entry of FSWV1_BMP_DEVICES) */
+    uint8  Health;           /* FSWV1_BMP_HEALTH_xxx */
+    uint8  Count;            /* Valid entries in Samples */
+    uint8  Chip;             /* FSWV1_BMP_CHIP_xxx */
+    uint32 TotalSamples;     /* Samples published by this instance */
+    uint32 NotReady;         /* Reads with no new conversion available */
+    uint32 ReadErrors;       /* Failed reads */
+    FSWV1_APP_BaroSample_t Samples[FSWV1_BMP_TLM_SAMPLES];
+} FSWV1_APP_BaroTlm_Payload_t;
+
+/* Barometer Telemetry */
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t     TelemetryHeader;
+    FSWV1_APP_BaroTlm_Payload_t  Payload;
+} FSWV1_APP_BaroTlm_t;
+
 #endif /* FSWV1_APP_MSG_H */
@@ -13,11 +13,15 @@
 */
 #define FSWV1_APP_CMD_MID       0x1884
 #define FSWV1_APP_SEND_HK_MID   0x1885
+#define FSWV1_APP_WAKEUP_MID    0x1886
 
 /*
 ** Telemetry Message IDs
 */
 #define FSWV1_APP_HK_TLM_MID        0x0884
 #define FSWV1_APP_COMBINED_TLM_MID  0x0885
+#define FSWV1_APP_PERF_TLM_MID      0x0886
+#define FSWV1_APP_IMU_TLM_MID       0x0887   /* One stream for all IMU instances */
+#define FSWV1_APP_BARO_TLM_MID      0x0888   /* One stream for all barometer instances */
 
 #endif /* FSWV1_APP_MSGIDS_H */
@@ -0,0 +1,147 @@
+/******************************************************************************
+** File: fswv1_baro.h
+**
+** Purpose:
+**   This file contains the barometer driver interface of the FSWV1 app.
+**
+**   fswv1_sensor.c owns the I2C buses, the reader tasks, health tracking
+**   and the sample rings. A chip driver (fswv1_bmp280.c, fswv1_bmp3.c)
+**   only talks to its device through the register helpers below and fills
+**   in FSWV1_BaroDriver_t:
+**
+**     Probe         identify the chip, load its calibration, apply Profile
+**     ApplyProfile  write Dev->Profile; CFE_ES_BAD_ARGUMENT if the chip
+**                   cannot run it (the previous profile is kept)
+**     Read          return every new sample, oldest first, at most
+**                   FSWV1_BARO_READ_MAX; OS_ERROR when there is nothing
+**                   new yet
+**
+**   All three run with the bus lock held, in the bus reader's context.
+**
+******************************************************************************/
+
+#ifndef FSWV1_BARO_H
+#define FSWV1_BARO_H
+
+#include "fswv1_app.h"
+#include "fswv1_bmp280_comp.h"
+#include "fswv1_bmp3_fifo.h"
+
+/*
+** Most samples a driver returns from one Read (a full BMP3 FIFO)
+*/
+#define FSWV1_BARO_READ_MAX    FSWV1_BMP3_FIFO_MAX_FRAMES
+
+/*
+** Most register runs batched into one I2C_RDWR transaction
+*/
+#define FSWV1_I2C_MAX_RUNS     4
+
+/*
+** One contiguous run of registers to read (both chip families auto-increment)
+*/
+typedef struct
+{
+    uint8  Reg;
+    uint16 Len;
+    uint8 *Data;
+} FSWV1_RegRun_t;
+
+typedef struct FSWV1_I2CBus FSWV1_I2CBus_t;
+typedef struct FSWV1_BaroDevice FSWV1_BaroDevice_t;
+
+/*
+** Chip driver
+*/
+typedef struct
+{
+    const char *Name;
+    uint8 IdReg;                 /* Chip ID register */
+    uint8 ChipId[2];             /* Accepted chip IDs (0 = unused) */
+    uint8 Chip[2];               /* FSWV1_BMP_CHIP_xxx of each */
+    bool  Fifo;                  /* Read drains a FIFO and times each sample itself */
+    int32 (*Probe)(FSWV1_BaroDevice_t *Dev);
+    int32 (*ApplyProfile)(FSWV1_BaroDevice_t *Dev);
+    int32 (*Read)(FSWV1_BaroDevice_t *Dev, FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count);
+} FSWV1_BaroDriver_t;
+
+/*
+** BMP280 state (fswv1_bmp280.c)
+*/
+typedef struct
+{
+    FSWV1_BMP280_Comp_t Comp;    /* Compensation context from the calibration */
+    uint8  CtrlMeas;             /* ctrl_meas for the profile, mode bits clear */
+    uint64 OutputPeriodNs;       /* Normal mode: typical conversion + standby */
+    bool   ConvPending;          /* Forced mode: a conversion has been started */
+    uint64 ConvDueNs;            /* Forced mode: when that conversion is complete */
+    uint64 LastSampleNs;         /* Arrival time of the last sample returned */
+} FSWV1_BMP280_State_t;
+
+/*
+** BMP388/BMP390 state (fswv1_bmp3.c)
+*/
+typedef struct
+{
+    FSWV1_BMP3_Calib_t Calib;
+    FSWV1_BMP3_Clock_t Clock;
+    uint16 WatermarkBytes;       /* FIFO watermark; a burst reads one frame more */
+} FSWV1_BMP3_State_t;
+
+/*
+** Barometer instance (one per entry of FSWV1_BMP_DEVICES)
+*/
+struct FSWV1_BaroDevice
+{
+    FSWV1_I2CBus_t           *Bus;         /* NULL if the bus could not be opened */
+    const FSWV1_BaroDriver_t *Driver;      /* NULL until the chip is identified */
+    uint8  Address;
+    uint8  Instance;
+    uint8  ConfigChip;                     /* FSWV1_BMP_CHIP_xxx from the table (AUTO = detect) */
+    uint8  Chip;                           /* FSWV1_BMP_CHIP_xxx found */
+    uint8  Health;                         /* FSWV1_BMP_HEALTH_xxx */
+
+    /* Measurement profile (set by the driver's ApplyProfile) */
+    FSWV1_APP_SetBmpProfileCmd_Payload_t Profile;
+    uint32 MeasTimeUs;                     /* Worst-case conversion time */
+
+    /* Driver counters */
+    uint32 NotReady;                       /* Reads with nothing new */
+    uint32 FifoFull;                       /* Bursts that found the FIFO full (frames lost) */
+
+    union
+    {
+        FSWV1_BMP280_State_t Bmp280;
+        FSWV1_BMP3_State_t   Bmp3;
+    } State;
+
+    /* Owned by fswv1_sensor.c */
+    uint32 SampleTxns;                     /* Transactions used by the last read */
+    uint32 Samples;
+    uint32 ReadErrors;
+    uint32 ConsecErrors;                   /* Failed reads since the last good one */
+    uint32 Recoveries;
+    uint32 Dropped;                        /* Samples lost because the ring was full */
+    uint32 ProbeWait;                      /* Failed: passes since the last re-probe */
+
+    /* Sample ring: the reader pushes, FSWV1_ReadSensors pops */
+    FSWV1_SensorData_t Ring[FSWV1_BMP_RING_SIZE];
+    uint32 Head;
+    uint32 Tail;
+};
+
+/*
+** Chip drivers
+*/
+extern const FSWV1_BaroDriver_t FSWV1_BMP280_Driver;
+extern const FSWV1_BaroDriver_t FSWV1_BMP3_Driver;
+
+/*
+** Register access for drivers (fswv1_sensor.c)
+*/
+int32 FSWV1_Baro_WriteRegs(FSWV1_BaroDevice_t *Dev, const uint8 *Pairs, uint8 Count);
+int32 FSWV1_Baro_ReadRegRuns(FSWV1_BaroDevice_t *Dev, const FSWV1_RegRun_t *Runs, uint32 Count,
+                             const uint8 *Pairs, uint8 PairCount);
+int32 FSWV1_Baro_ReadReg(FSWV1_BaroDevice_t *Dev, uint8 Reg, uint8 *Data, uint16 Len);
+
+#endif /* FSWV1_BARO_H */
@@ -0,0 +1,101 @@
+/******************************************************************************
+** File: fswv1_bmp280_comp.h
+**
+** Purpose:
+**   This file contains the BMP280 compensation interface for the FSWV1 app.
+**   The calibration coefficients are turned once into a compensation
+**   context. Both compensation paths read only that context, so they keep
+**   no state between calls and may run concurrently for several sensors.
+**
+**   Integer path: the datasheet's 32-bit temperature and 64-bit pressure
+**                 algorithm (BST-BMP280-DS001, 8.2), unchanged.
+**   Float path:   the same temperature stage, then pressure as a ratio of
+**                 two polynomials in t_fine with precomputed single
+**                 precision coefficients. No 64-bit multiply or divide.
+**
+** Notes:
+**   This header and fswv1_bmp280_comp.c do not depend on cFE or OSAL so the
+**   compensation can also be built into host tools (bmp280_comp_bench.c).
+**
+******************************************************************************/
+
+#ifndef FSWV1_BMP280_COMP_H
+#define FSWV1_BMP280_COMP_H
+
+#include <stdint.h>
+
+/*
+** Size of the calibration block dig_T1 (0x88) .. dig_P9 (0x9F)
+*/
+#define FSWV1_BMP280_CALIB_SIZE  24
+
+/*
+** Calibration coefficients, as stored in the sensor's NVM
+*/
+typedef struct
+{
+    uint16_t dig_T1;
+    int16_t  dig_T2;
+    int16_t  dig_T3;
+    uint16_t dig_P1;
+    int16_t  dig_P2;
+    int16_t  dig_P3;
+    int16_t  dig_P4;
+    int16_t  dig_P5;
+    int16_t  dig_P6;
+    int16_t  dig_P7;
+    int16_t  dig_P8;
+    int16_t  dig_P9;
+} FSWV1_BMP280_Calib_t;
+
+/*
+** Compensation context (FSWV1_BMP280_InitComp)
+**
+** With v = t_fine - 128000 and p0 = 2^20 - adc_P, the integer algorithm
+** computes, up to its truncations:
+**
+**   q        = (p0 - (A0 + A1*v + A2*v^2)) / (E0 + E1*v + E2*v^2)
+**   pressure = C0 + C1*q + C2*q^2
+**
+** The float path evaluates exactly this, with the scaling to hPa folded
+** into C0..C2.
+*/
+typedef struct
+{
+    FSWV1_BMP280_Calib_t Calib;   /* Integer path and the temperature stage */
+    float A0, A1, A2;             /* Offset subtracted from p0 */
+    float E0, E1, E2;             /* Sensitivity divisor */
+    float C0, C1, C2;             /* Second-order correction, hPa */
+} FSWV1_BMP280_Comp_t;
+
+/*
+** Unpack the little-endian calibration block read from 0x88
+*/
+void FSWV1_BMP280_ParseCalib(const uint8_t Raw[FSWV1_BMP280_CALIB_SIZE], FSWV1_BMP280_Calib_t *Calib);
+
+/*
+** Fill Comp from Calib. Call again whenever the calibration is reloaded.
+*/
+void FSWV1_BMP280_InitComp(FSWV1_BMP280_Comp_t *Comp, const FSWV1_BMP280_Calib_t *Calib);
+
+/*
+** Fine temperature (datasheet t_fine) of a 20-bit temperature reading
+*/
+int32_t FSWV1_BMP280_TFine(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT);
+
+/*
+** Integer path. *Temp is in 0.01 degC and *Press in Pa as Q24.8, exactly
+** as the datasheet functions return them (pressure 0 if the divisor is 0).
+*/
+void FSWV1_BMP280_CompensateInt(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT, int32_t AdcP,
+                                int32_t *Temp, uint32_t *Press);
+
+/*
+** Float path. *TempC is in degC and bit-identical to the integer result
+** divided by 100.0f. *PressHpa is in hPa and within 0.05 Pa of the integer
+** result over the operating range (bmp280_comp_bench.c checks the bound).
+*/
+void FSWV1_BMP280_CompensateFloat(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT, int32_t AdcP,
+                                  float *TempC, float *PressHpa);
+
+#endif /* FSWV1_BMP280_COMP_H */
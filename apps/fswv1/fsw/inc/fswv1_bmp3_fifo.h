@@ -0,0 +1,154 @@
+/******************************************************************************
+** File: fswv1_bmp3_fifo.h
+**
+** Purpose:
+**   This file contains the BMP388/BMP390 FIFO decoding, compensation and
+**   frame timing interface for the FSWV1 app.
+**
+**   Decoding:     a FIFO burst is split into temperature + pressure frames
+**                 in one pass, leaving an incomplete last frame unread.
+**   Compensation: the datasheet's floating point algorithm
+**                 (BST-BMP388-DS001, 9.2), evaluated as polynomials in
+**                 t_lin and the pressure reading.
+**   Frame timing: the frames carry no time of their own. Each burst's
+**                 frames are spaced one output period apart, with the
+**                 period tracked through the sensor time frame at the end
+**                 of the burst, and the newest frame is placed within one
+**                 period of the read.
+**
+** Notes:
+**   This header and fswv1_bmp3_fifo.c do not depend on cFE or OSAL so they
+**   can also be built into host tools (bmp3_fifo_bench.c).
+**
+******************************************************************************/
+
+#ifndef FSWV1_BMP3_FIFO_H
+#define FSWV1_BMP3_FIFO_H
+
+#include <stdint.h>
+
+/*
+** Size of the calibration block NVM_PAR_T1 (0x31) .. NVM_PAR_P11 (0x45)
+*/
+#define FSWV1_BMP3_CALIB_SIZE       21
+
+/*
+** FIFO geometry
+*/
+#define FSWV1_BMP3_FIFO_SIZE        512
+#define FSWV1_BMP3_FRAME_SIZE       7     /* Header, temperature, pressure */
+#define FSWV1_BMP3_TIME_FRAME_SIZE  4     /* Header, 24-bit sensor time */
+#define FSWV1_BMP3_FIFO_MAX_FRAMES  (FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE + 1)
+#define FSWV1_BMP3_FIFO_READ_MAX    (FSWV1_BMP3_FIFO_SIZE + FSWV1_BMP3_TIME_FRAME_SIZE)
+
+/*
+** FIFO frame headers
+*/
+#define FSWV1_BMP3_FH_TEMP_PRESS    0x94
+#define FSWV1_BMP3_FH_TEMP          0x90
+#define FSWV1_BMP3_FH_PRESS         0x84
+#define FSWV1_BMP3_FH_TIME          0xA0
+#define FSWV1_BMP3_FH_EMPTY         0x80
+#define FSWV1_BMP3_FH_CONFIG_ERROR  0x44
+#define FSWV1_BMP3_FH_CONFIG_CHANGE 0x48
+
+/*
+** INT_CTRL (0x19) bits and the value the driver writes: the watermark
+** interrupt on a push-pull, active-high pin, so a rising-edge data-ready
+** line (FSWV1_DRDY_FALLING_EDGE 0) fires when the watermark is reached
+*/
+#define FSWV1_BMP3_INT_OD           0x01  /* Open drain */
+#define FSWV1_BMP3_INT_LEVEL        0x02  /* Active high */
+#define FSWV1_BMP3_INT_LATCH        0x04
+#define FSWV1_BMP3_INT_FWTM_EN      0x08
+#define FSWV1_BMP3_INT_FFULL_EN     0x10
+#define FSWV1_BMP3_INT_DRDY_EN      0x40
+#define FSWV1_BMP3_INT_CTRL_FWTM    (FSWV1_BMP3_INT_FWTM_EN | FSWV1_BMP3_INT_LEVEL)
+
+/*
+** Sensor time: 24-bit counter at 25.6 kHz. The output data rates are
+** 200 Hz / 2^odr_sel, i.e. FSWV1_BMP3_ODR_BASE_TICKS << odr_sel ticks.
+*/
+#define FSWV1_BMP3_TICK_PS          39062500u
+#define FSWV1_BMP3_ODR_BASE_TICKS   128u
+#define FSWV1_BMP3_TIME_MASK        0xFFFFFFu
+
+/*
+** Calibration coefficients, scaled as in the datasheet (par_t1 .. par_p11)
+*/
+typedef struct
+{
+    double T1, T2, T3;
+    double P1, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11;
+} FSWV1_BMP3_Calib_t;
+
+/*
+** Raw readings of one FIFO frame (20-bit values in 24-bit fields)
+*/
+typedef struct
+{
+    uint32_t AdcT;
+    uint32_t AdcP;
+} FSWV1_BMP3_Frame_t;
+
+/*
+** What FSWV1_BMP3_DecodeFifo found besides the frames
+*/
+typedef struct
+{
+    uint32_t Consumed;        /* Bytes decoded; an incomplete last frame is not */
+    uint32_t Partial;         /* Frames with temperature or pressure only (dropped) */
+    uint32_t ConfigChanges;   /* Configuration change frames */
+    uint32_t ConfigErrors;    /* Configuration error frames */
+    uint32_t Invalid;         /* 1 if decoding stopped at an unknown header */
+    uint8_t  TimeValid;       /* A sensor time frame was found */
+    uint32_t SensorTime;      /* Its value (ticks) */
+} FSWV1_BMP3_FifoResult_t;
+
+/*
+** Frame clock (FSWV1_BMP3_ClockStamp)
+*/
+typedef struct
+{
+    uint64_t LastFrameNs;     /* Time given to the newest frame so far (0 = none) */
+    uint64_t RefReadNs;       /* Host time of the reference sensor time */
+    uint32_t RefSensorTime;
+    uint8_t  RefValid;
+    uint32_t TickPs;          /* Measured sensor time tick */
+    uint32_t PeriodTicks;     /* Output period in sensor time ticks */
+} FSWV1_BMP3_Clock_t;
+
+/*
+** Scale the calibration block read from 0x31
+*/
+void FSWV1_BMP3_ParseCalib(const uint8_t Raw[FSWV1_BMP3_CALIB_SIZE], FSWV1_BMP3_Calib_t *Calib);
+
+/*
+** Compensate one frame to degC and hPa
+*/
+void FSWV1_BMP3_Compensate(const FSWV1_BMP3_Calib_t *Calib, uint32_t AdcT, uint32_t AdcP,
+                           float *TempC, float *PressHpa);
+
+/*
+** Decode Len bytes read from FIFO_DATA. Returns the number of temperature
+** + pressure frames stored in Frames (at most MaxFrames). Decoding ends at
+** an empty frame, an unknown header or an incomplete frame.
+*/
+uint32_t FSWV1_BMP3_DecodeFifo(const uint8_t *Buf, uint32_t Len, FSWV1_BMP3_Frame_t *Frames,
+                               uint32_t MaxFrames, FSWV1_BMP3_FifoResult_t *Result);
+
+/*
+** Start a frame clock for an output period (after a FIFO flush). The
+** measured tick is kept across restarts.
+*/
+void FSWV1_BMP3_ClockInit(FSWV1_BMP3_Clock_t *Clock, uint32_t PeriodTicks);
+
+/*
+** Give the Count frames of a burst their times (oldest first in FrameNs).
+** ReadNs is the host time the FIFO read started; TimeValid/SensorTime are
+** from the burst's sensor time frame.
+*/
+void FSWV1_BMP3_ClockStamp(FSWV1_BMP3_Clock_t *Clock, uint32_t Count, uint64_t ReadNs,
+                           int TimeValid, uint32_t SensorTime, uint64_t *FrameNs);
+
+#endif /* FSWV1_BMP3_FIFO_H */
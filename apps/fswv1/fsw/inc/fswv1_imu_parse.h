@@ -0,0 +1,107 @@
+/******************************************************************************
+** File: fswv1_imu_parse.h
+**
+** Purpose:
+**   This file contains the IMU frame parser interface for the FSWV1 app.
+**   ASCII frame format:  "$,Ax,Ay,Az,Gx,Gy,Gz,Temperature,#"
+**                        (optionally "$,Ax,...,Temperature,N,#" with a
+**                        sender frame counter N)
+**   Binary frame format: COBS-encoded packet ending in 0x00 (see below)
+**
+** Notes:
+**   This header and fswv1_imu_parse.c do not depend on cFE or OSAL so the
+**   parser can also be built into host tools (uart_test.c,
+**   imu_parse_bench.c).
+**
+******************************************************************************/
+
+#ifndef FSWV1_IMU_PARSE_H
+#define FSWV1_IMU_PARSE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+** Number of float fields in a frame
+*/
+#define FSWV1_IMU_PARSE_FIELDS  7
+
+/*
+** Parser return codes
+*/
+#define FSWV1_IMU_PARSE_OK         0
+#define FSWV1_IMU_PARSE_BAD_START  (-1)   /* Frame does not begin with "$," */
+#define FSWV1_IMU_PARSE_BAD_FIELD  (-2)   /* A field is not a number or not followed by ',' */
+#define FSWV1_IMU_PARSE_BAD_COBS   (-3)   /* Binary frame is not valid COBS */
+#define FSWV1_IMU_PARSE_BAD_LENGTH (-4)   /* Binary frame decodes to an unknown length */
+#define FSWV1_IMU_PARSE_BAD_CRC    (-5)   /* Binary frame CRC mismatch */
+
+/*
+** Binary frame format
+** Each frame is COBS-encoded (no 0x00 inside) and ends with one 0x00
+** delimiter. Decoded, it holds (all little-endian):
+**
+**   uint8   Seq        Sender frame counter, wraps at 256
+**   values  7 fields   FLOAT: 7 x float32, or INT16: 7 x int16 scaled
+**                      by FSWV1_IMU_BIN_xxx_SCALE counts per unit
+**   uint16  Crc        CRC-16/CCITT-FALSE of Seq and the values
+**
+** The two layouts are told apart by their decoded length. An INT16 frame
+** is 19 bytes on the wire, against ~45-52 for the ASCII frame.
+*/
+#define FSWV1_IMU_BIN_FLOAT_LEN     (1 + FSWV1_IMU_PARSE_FIELDS * 4 + 2)
+#define FSWV1_IMU_BIN_INT16_LEN     (1 + FSWV1_IMU_PARSE_FIELDS * 2 + 2)
+#define FSWV1_IMU_BIN_MAX_DECODED   FSWV1_IMU_BIN_FLOAT_LEN
+#define FSWV1_IMU_BIN_MAX_ENCODED   (FSWV1_IMU_BIN_MAX_DECODED + 1)   /* Without delimiter */
+
+#define FSWV1_IMU_BIN_ACCEL_SCALE   1000.0f   /* Ax..Az: +/-32.767 */
+#define FSWV1_IMU_BIN_GYRO_SCALE    100.0f    /* Gx..Gz: +/-327.67 */
+#define FSWV1_IMU_BIN_TEMP_SCALE    100.0f    /* Temperature: +/-327.67 */
+
+/*
+** Parse one NUL-terminated frame into Values[FSWV1_IMU_PARSE_FIELDS].
+**
+** Accepts the same input as sscanf(Frame, "$,%f,%f,%f,%f,%f,%f,%f,#"):
+** leading white space is allowed before each number, and nothing after
+** the seventh field is checked. Each value is bit-identical to strtof()
+** in the "C" locale, whatever the process locale is.
+**
+** On FSWV1_IMU_PARSE_BAD_FIELD, *BadField (if not NULL) is set to the
+** zero-based index of the field that failed. Values before it are valid.
+** The parser does not allocate memory per frame; the "C" locale used for
+** the rare strtof_l fallback is created once, on first use.
+*/
+int FSWV1_IMU_ParseFrame(const char *Frame, float Values[FSWV1_IMU_PARSE_FIELDS], int *BadField);
+
+/*
+** Same as FSWV1_IMU_ParseFrame, and also reads an optional sender frame
+** counter placed after the seventh field: "$,Ax,...,Temperature,N,#".
+** N is an unsigned decimal integer (taken modulo 2^32). *HasSeq is set to
+** 1 and *Seq to N if the frame has one, otherwise *HasSeq is 0.
+*/
+int FSWV1_IMU_ParseFrameSeq(const char *Frame, float Values[FSWV1_IMU_PARSE_FIELDS], int *BadField,
+                            uint32_t *Seq, int *HasSeq);
+
+/*
+** Decode one binary frame. Encoded/Length is the frame without its 0x00
+** delimiter. Returns FSWV1_IMU_PARSE_OK or one of the BAD_COBS, BAD_LENGTH
+** and BAD_CRC codes; Values and *Seq are only written on success.
+*/
+int FSWV1_IMU_ParseBinary(const uint8_t *Encoded, size_t Length,
+                          float Values[FSWV1_IMU_PARSE_FIELDS], uint8_t *Seq);
+
+/*
+** Build one binary frame (INT16 layout if Int16 is non-zero, else FLOAT)
+** into Out, which must hold FSWV1_IMU_BIN_MAX_ENCODED + 1 bytes. Returns
+** the number of bytes written, including the 0x00 delimiter. INT16 values
+** are rounded and saturated.
+*/
+size_t FSWV1_IMU_EncodeBinary(const float Values[FSWV1_IMU_PARSE_FIELDS], uint8_t Seq,
+                              int Int16, uint8_t *Out);
+
+/*
+** CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+*/
+uint16_t FSWV1_IMU_Crc16(const uint8_t *Data, size_t Length);
+
+#endif /* FSWV1_IMU_PARSE_H */
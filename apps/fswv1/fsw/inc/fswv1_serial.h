@@ -0,0 +1,62 @@
+/******************************************************************************
+** File: fswv1_serial.h
+**
+** Purpose:
+**   This file contains the serial port interface shared by the IMU UART,
+**   the telemetry UART and uart_test.c.
+**
+** Notes:
+**   This header and fswv1_serial.c do not depend on cFE or OSAL so the
+**   same setup is used by host tools.
+**
+******************************************************************************/
+
+#ifndef FSWV1_SERIAL_H
+#define FSWV1_SERIAL_H
+
+#include <stdint.h>
+
+/*
+** Optional settings that could not be applied (FSWV1_SerialInfo_t.Warnings)
+** The port still works without them.
+*/
+#define FSWV1_SERIAL_WARN_LOW_LATENCY  0x01   /* ASYNC_LOW_LATENCY refused */
+#define FSWV1_SERIAL_WARN_HW_FIFO      0x02   /* xmit_fifo_size refused */
+#define FSWV1_SERIAL_WARN_BAUD         0x04   /* Driver rounded the baud rate by more than 2% */
+
+/*
+** Port settings (always 8N1, raw mode)
+*/
+typedef struct
+{
+    uint32_t BaudRate;      /* Any rate; not limited to the Bxxx constants */
+    int      FlowControl;   /* Non-zero enables RTS/CTS hardware flow control */
+    int      LowLatency;    /* Non-zero asks the driver to push received data at once */
+    int      HwXmitFifoDepth; /* UART hardware transmit FIFO depth (xmit_fifo_size), 0 = driver default */
+    uint8_t  Vmin;          /* Read wake-up byte count (VMIN) */
+    uint8_t  Vtime;         /* Read timeout in 0.1 s (VTIME) */
+} FSWV1_SerialConfig_t;
+
+/*
+** Open results
+*/
+typedef struct
+{
+    uint32_t    ActualBaud;  /* Rate reported by the driver after setup */
+    unsigned    Warnings;    /* FSWV1_SERIAL_WARN_xxx */
+    const char *FailedStep;  /* On failure, the step that failed (errno is kept) */
+} FSWV1_SerialInfo_t;
+
+/*
+** Open and configure Device (non-blocking, no controlling tty) and flush
+** its queues. Returns the descriptor, or -1 with errno set and
+** Info->FailedStep naming the step. Info may be NULL.
+*/
+int FSWV1_Serial_Open(const char *Device, const FSWV1_SerialConfig_t *Config, FSWV1_SerialInfo_t *Info);
+
+/*
+** Close a descriptor returned by FSWV1_Serial_Open
+*/
+void FSWV1_Serial_Close(int Fd);
+
+#endif /* FSWV1_SERIAL_H */
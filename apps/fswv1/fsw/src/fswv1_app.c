@@ -8,6 +8,10 @@
 
 #include "fswv1_app.h"
 #include "fswv1_app_version.h"
+#include <stdio.h>
+
+/* An unbounded command drain could hold off sampling indefinitely */
+CompileTimeAssert(FSWV1_APP_CMD_BUDGET_MSGS != 0 || FSWV1_APP_CMD_BUDGET_US != 0, CmdBudgetIsBounded);
 
 /*
 ** Global Data
@@ -22,7 +26,11 @@ FSWV1_APP_Data_t FSWV1_APP_Data;
 void FSWV1_APP_Main(void)
 {
     int32 status;
-    CFE_SB_Buffer_t *SBBufPtr;
+    uint32 missed;
+    uint64 cycle_start = 0;
+    uint64 cycle_exec;
+    uint64 last_cycle_start = 0;
+    uint64 ttq_window_end;
 
     /*
     ** Perform application specific initialization
@@ -40,106 +48,526 @@ void FSWV1_APP_Main(void)
     while (CFE_ES_RunLoop(&FSWV1_APP_Data.RunStatus) == true)
     {
         /*
-        ** Pend on receipt of command packet with timeout
+        ** Pend on the next cycle wakeup (scheduler message or internal timer)
         */
-        status = CFE_SB_ReceiveBuffer(&SBBufPtr, FSWV1_APP_Data.CommandPipe, 500);
+        status = FSWV1_WaitForWakeup(&missed);
 
         if (status == CFE_SUCCESS)
         {
-            FSWV1_APP_ProcessCommandPacket(SBBufPtr);
+            cycle_start = FSWV1_Sched_NowNs();
+            if (last_cycle_start != 0)
+            {
+                FSWV1_Perf_Record(FSWV1_APP_PERF_CYCLE_PERIOD, cycle_start - last_cycle_start);
+                FSWV1_RT_RecordPeriod(cycle_start - last_cycle_start);
+            }
+            last_cycle_start = cycle_start;
+
+            FSWV1_APP_Data.CycleCount++;
+            FSWV1_APP_Data.MissedCycles += missed;
+
+            FSWV1_APP_RunCycle();
+
+            cycle_exec = FSWV1_Sched_NowNs() - cycle_start;
+            FSWV1_Perf_Record(FSWV1_APP_PERF_CYCLE_EXEC, cycle_exec);
+            FSWV1_Deadline_EndCycle(cycle_exec);
+
+            ttq_window_end = cycle_start + (uint64)FSWV1_TTQ_LOOKAHEAD_US * 1000;
         }
         else if (status == CFE_SB_TIME_OUT)
         {
-            /*
-            ** Timeout occurred - perform periodic reading
-            */
-            
-            /* Read BMP280 sensor data (if enabled) */
-            if (FSWV1_APP_Data.SensorEnabled)
-            {
-                status = FSWV1_ReadSensor(&FSWV1_APP_Data.SensorData);
-                
-                if (status == CFE_SUCCESS)
-                {
-                    /* Update combined telemetry with BMP280 data */
-                    FSWV1_APP_Data.CombinedTlm.Payload.BMP_Temperature = 
-                        FSWV1_APP_Data.SensorData.Temperature;
-                    FSWV1_APP_Data.CombinedTlm.Payload.BMP_Pressure = 
-                        FSWV1_APP_Data.SensorData.Pressure;
-                    
-                    /* Print to terminal */
-                    OS_printf("FSWV1: BMP Temp=%.2f°C, Press=%.2f Pa\n",
-                             FSWV1_APP_Data.SensorData.Temperature,
-                             FSWV1_APP_Data.SensorData.Pressure);
-                }
-                else
-                {
-                    CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                                    "FSWV1: Sensor read error, status = 0x%08X", (unsigned int)status);
-                }
-            }
-            
-            /* Read IMU data from UART (always, independent of SensorEnabled) */
-            if (FSWV1_APP_Data.IMUEnabled)
-            {
-                status = FSWV1_ReadUART(&FSWV1_APP_Data.IMUData);
-                if (status == CFE_SUCCESS)
-                {
-                    /* Update combined telemetry with IMU data */
-                    FSWV1_APP_Data.CombinedTlm.Payload.Accel_X = FSWV1_APP_Data.IMUData.Accel_X;
-                    FSWV1_APP_Data.CombinedTlm.Payload.Accel_Y = FSWV1_APP_Data.IMUData.Accel_Y;
-                    FSWV1_APP_Data.CombinedTlm.Payload.Accel_Z = FSWV1_APP_Data.IMUData.Accel_Z;
-                    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_X = FSWV1_APP_Data.IMUData.Gyro_X;
-                    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_Y = FSWV1_APP_Data.IMUData.Gyro_Y;
-                    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_Z = FSWV1_APP_Data.IMUData.Gyro_Z;
-                    FSWV1_APP_Data.CombinedTlm.Payload.IMU_Temperature = FSWV1_APP_Data.IMUData.Temperature;
-                    
-                    /* Print IMU data */
-                    OS_printf("FSWV1: IMU Ax=%.2f Ay=%.2f Az=%.2f Gx=%.2f Gy=%.2f Gz=%.2f T=%.2f\n",
-                             FSWV1_APP_Data.IMUData.Accel_X, FSWV1_APP_Data.IMUData.Accel_Y, FSWV1_APP_Data.IMUData.Accel_Z,
-                             FSWV1_APP_Data.IMUData.Gyro_X, FSWV1_APP_Data.IMUData.Gyro_Y, FSWV1_APP_Data.IMUData.Gyro_Z,
-                             FSWV1_APP_Data.IMUData.Temperature);
-                }
-                /* IMU read errors are OK - just no data available yet */
-            }
-            
-            /* Always transmit telemetry (even if sensors disabled, send zeros) */
-            FSWV1_APP_Data.CombinedTlm.Payload.Timestamp = CFE_TIME_GetTime().Seconds;
-            
-            /* Update sequence count */
-            CFE_MSG_SetSequenceCount(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader),
-                                    FSWV1_APP_Data.CombinedTlmSeqCnt);
-            FSWV1_APP_Data.CombinedTlmSeqCnt++;
-            
-            /* Timestamp and transmit on Software Bus */
-            CFE_SB_TimeStampMsg(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader));
-            CFE_SB_TransmitMsg(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader), false);
-            
-            /* Send combined data via UDP */
-            FSWV1_SendUDP(&FSWV1_APP_Data.SensorData, &FSWV1_APP_Data.IMUData);
-            
-            /* Send combined data via Telemetry UART */
-            FSWV1_SendTelemetryUART(&FSWV1_APP_Data.SensorData, &FSWV1_APP_Data.IMUData);
+            /* Wakeups have stopped: the next pass is another timeout away */
+            ttq_window_end = FSWV1_Sched_NowNs() + (uint64)FSWV1_APP_WAKEUP_TIMEOUT_MS * 1000000;
         }
         else
         {
             CFE_EVS_SendEvent(FSWV1_APP_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
-                            "FSWV1: SB pipe read error, RC = 0x%08X", (unsigned int)status);
+                            "FSWV1: Wakeup read error, RC = 0x%08X", (unsigned int)status);
+
+            ttq_window_end = FSWV1_Sched_NowNs() + (uint64)FSWV1_TTQ_LOOKAHEAD_US * 1000;
         }
+
+        /*
+        ** Run time-tagged commands that are due, or due before the next pass
+        */
+        FSWV1_TTQ_Process(ttq_window_end);
+
+        /*
+        ** Service commands after the cycle so they never hold off sampling
+        */
+        FSWV1_APP_ProcessCommands();
     }
 
     /*
     ** Cleanup before exit
     */
+    FSWV1_CloseSched();
     FSWV1_CloseSensor();
     FSWV1_CloseUDP();
     FSWV1_CloseTelemetryUART();
+    FSWV1_CloseDataReady();
     FSWV1_CloseGPIO();
     FSWV1_CloseUART();
     
     CFE_ES_ExitApp(FSWV1_APP_Data.RunStatus);
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Send an instance's barometer telemetry packet and start a new one      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_SendBaroTlm(FSWV1_APP_BaroTlm_t *Tlm)
+{
+    FSWV1_BaroStats_t stats;
+
+    FSWV1_GetSensorInstanceStats(Tlm->Payload.Instance, &stats);
+    Tlm->Payload.Health = stats.Health;
+    Tlm->Payload.Chip = stats.Chip;
+    Tlm->Payload.TotalSamples = stats.Samples;
+    Tlm->Payload.NotReady = stats.NotReady;
+    Tlm->Payload.ReadErrors = stats.ReadErrors;
+
+    FSWV1_Time_StampMsg(CFE_MSG_PTR(Tlm->TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Tlm->TelemetryHeader), true);
+    Tlm->Payload.Count = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Publish the barometer samples finished since the last call             */
+/* Samples are batched per instance into barometer telemetry packets,    */
+/* each sent when full and at the end of the collection; the primary     */
+/* instance's newest sample also feeds the combined telemetry.             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_CollectSensors(void)
+{
+    const FSWV1_SensorData_t *sample;
+    const FSWV1_SensorData_t *primary = NULL;
+    FSWV1_APP_BaroTlm_t *tlm;
+    FSWV1_APP_BaroSample_t *entry;
+    uint32 count;
+    uint32 i;
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    if (FSWV1_SimSrc_ReadSensors(FSWV1_APP_Data.SensorSamples, FSWV1_BMP_DRAIN_MAX, &count) != CFE_SUCCESS)
+#else
+    if (FSWV1_ReadSensors(FSWV1_APP_Data.SensorSamples, FSWV1_BMP_DRAIN_MAX, &count) != CFE_SUCCESS)
+#endif
+    {
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        sample = &FSWV1_APP_Data.SensorSamples[i];
+        if (sample->Instance >= FSWV1_BMP_MAX_INSTANCES)
+        {
+            continue;
+        }
+
+        tlm = &FSWV1_APP_Data.BaroTlm[sample->Instance];
+        entry = &tlm->Payload.Samples[tlm->Payload.Count++];
+        entry->Time = sample->Timestamp;
+        entry->Temperature = sample->Temperature;
+        entry->Pressure = sample->Pressure;
+
+        if (tlm->Payload.Count == FSWV1_BMP_TLM_SAMPLES)
+        {
+            FSWV1_APP_SendBaroTlm(tlm);
+        }
+
+        if (sample->Instance == FSWV1_BMP_PRIMARY_INSTANCE)
+        {
+            primary = sample;
+        }
+    }
+
+    for (i = 0; i < FSWV1_BMP_MAX_INSTANCES; i++)
+    {
+        if (FSWV1_APP_Data.BaroTlm[i].Payload.Count > 0)
+        {
+            FSWV1_APP_SendBaroTlm(&FSWV1_APP_Data.BaroTlm[i]);
+        }
+    }
+
+    if (primary == NULL)
+    {
+        return;
+    }
+
+    FSWV1_APP_Data.SensorData = *primary;
+
+    /* Update combined telemetry with BMP280 data */
+    FSWV1_APP_Data.CombinedTlm.Payload.BMP_Temperature = 
+        FSWV1_APP_Data.SensorData.Temperature;
+    FSWV1_APP_Data.CombinedTlm.Payload.BMP_Pressure = 
+        FSWV1_APP_Data.SensorData.Pressure;
+    FSWV1_APP_Data.CombinedTlm.Payload.BMP_Time = FSWV1_APP_Data.SensorData.Timestamp;
+    
+#if FSWV1_APP_CONSOLE_DEBUG
+    /* Print to terminal (skipped while the cycle is overrunning) */
+    if (!FSWV1_Deadline_Degraded())
+    {
+        OS_printf("FSWV1: BMP Temp=%.2f°C, Press=%.2f Pa\n",
+                 FSWV1_APP_Data.SensorData.Temperature,
+                 FSWV1_APP_Data.SensorData.Pressure);
+    }
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* BMP280 rate group                                                       */
+/* EdgeNs is the data-ready edge that triggered the read (0 = timer); it  */
+/* replaces the I2C completion time as the sample time. Buses with a      */
+/* reader task are only woken here and their samples are collected at    */
+/* the start of a later cycle; buses without one are read right away.     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_SampleSensor(uint64 EdgeNs)
+{
+    uint64 start;
+    uint64 elapsed;
+
+    if (!FSWV1_APP_Data.SensorEnabled)
+    {
+        return;
+    }
+
+    /* Failures are counted per instance and reported on health changes */
+    start = FSWV1_Sched_NowNs();
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    FSWV1_SimSrc_TriggerSensors();
+#else
+    FSWV1_TriggerSensors(EdgeNs);
+#endif
+    elapsed = FSWV1_Sched_NowNs() - start;
+    FSWV1_Perf_Record(FSWV1_APP_PERF_READ_SENSOR, elapsed);
+    FSWV1_Deadline_StageTime(FSWV1_APP_STAGE_SENSOR, elapsed);
+
+    FSWV1_APP_CollectSensors();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Send an instance's IMU telemetry packet and start a new one            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_SendImuTlm(FSWV1_APP_ImuTlm_t *Tlm)
+{
+    FSWV1_Time_StampMsg(CFE_MSG_PTR(Tlm->TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Tlm->TelemetryHeader), true);
+    Tlm->Payload.Count = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Publish a drained batch under each sample's IMU instance               */
+/* Full packets go out as they fill; partial ones at the end of the pass. */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_PublishIMU(const FSWV1_IMUData_t *Samples, uint32 Count)
+{
+    FSWV1_APP_ImuTlm_t *tlm;
+    FSWV1_APP_ImuSample_t *out;
+    uint32 i;
+
+    for (i = 0; i < Count; i++)
+    {
+        if (Samples[i].Instance >= FSWV1_IMU_MAX_INSTANCES)
+        {
+            continue;
+        }
+
+        tlm = &FSWV1_APP_Data.ImuTlm[Samples[i].Instance];
+        out = &tlm->Payload.Samples[tlm->Payload.Count++];
+        out->Time = Samples[i].Timestamp;
+        out->Accel_X = Samples[i].Accel_X;
+        out->Accel_Y = Samples[i].Accel_Y;
+        out->Accel_Z = Samples[i].Accel_Z;
+        out->Gyro_X = Samples[i].Gyro_X;
+        out->Gyro_Y = Samples[i].Gyro_Y;
+        out->Gyro_Z = Samples[i].Gyro_Z;
+        out->Temperature = Samples[i].Temperature;
+
+        if (tlm->Payload.Count == FSWV1_IMU_TLM_SAMPLES)
+        {
+            FSWV1_APP_SendImuTlm(tlm);
+        }
+    }
+
+    for (i = 0; i < FSWV1_IMU_MAX_INSTANCES; i++)
+    {
+        if (FSWV1_APP_Data.ImuTlm[i].Payload.Count > 0)
+        {
+            FSWV1_APP_SendImuTlm(&FSWV1_APP_Data.ImuTlm[i]);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Print the newest primary IMU sample to the console                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_PrintIMU(void)
+{
+    OS_printf("FSWV1: IMU Ax=%.2f Ay=%.2f Az=%.2f Gx=%.2f Gy=%.2f Gz=%.2f T=%.2f\n",
+             FSWV1_APP_Data.IMUData.Accel_X, FSWV1_APP_Data.IMUData.Accel_Y, FSWV1_APP_Data.IMUData.Accel_Z,
+             FSWV1_APP_Data.IMUData.Gyro_X, FSWV1_APP_Data.IMUData.Gyro_Y, FSWV1_APP_Data.IMUData.Gyro_Z,
+             FSWV1_APP_Data.IMUData.Temperature);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* IMU rate group                                                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_SampleIMU(void)
+{
+    int32 status;
+    uint64 start;
+    uint64 elapsed;
+    uint32 i;
+
+    /* Read IMU data from UART (always, independent of SensorEnabled) */
+    if (!FSWV1_APP_Data.IMUEnabled)
+    {
+        return;
+    }
+
+    /* Take every sample that arrived since the last pass, all instances merged in time order */
+    start = FSWV1_Sched_NowNs();
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    status = FSWV1_SimSrc_ReadIMU(FSWV1_APP_Data.IMUSamples, FSWV1_IMU_DRAIN_MAX,
+                                  &FSWV1_APP_Data.IMUSampleCount);
+#else
+    status = FSWV1_ReadUARTFrames(FSWV1_APP_Data.IMUSamples, FSWV1_IMU_DRAIN_MAX,
+                                  &FSWV1_APP_Data.IMUSampleCount);
+#endif
+    elapsed = FSWV1_Sched_NowNs() - start;
+    FSWV1_Perf_Record(FSWV1_APP_PERF_READ_UART, elapsed);
+    FSWV1_Deadline_StageTime(FSWV1_APP_STAGE_IMU, elapsed);
+    if (status != CFE_SUCCESS || FSWV1_APP_Data.IMUSampleCount == 0)
+    {
+        /*
+        ** No samples is normal between frames; discarded, malformed and missing
+        ** frames are counted by the UART layer and reported in housekeeping
+        */
+        return;
+    }
+
+    FSWV1_APP_PublishIMU(FSWV1_APP_Data.IMUSamples, FSWV1_APP_Data.IMUSampleCount);
+
+    /* Newest sample of the primary instance */
+    for (i = FSWV1_APP_Data.IMUSampleCount; i > 0; i--)
+    {
+        if (FSWV1_APP_Data.IMUSamples[i - 1].Instance == FSWV1_IMU_PRIMARY_INSTANCE)
+        {
+            break;
+        }
+    }
+    if (i == 0)
+    {
+        return;
+    }
+
+    FSWV1_APP_Data.IMUData = FSWV1_APP_Data.IMUSamples[i - 1];
+
+    /* Update combined telemetry with the newest IMU sample */
+    FSWV1_APP_Data.CombinedTlm.Payload.Accel_X = FSWV1_APP_Data.IMUData.Accel_X;
+    FSWV1_APP_Data.CombinedTlm.Payload.Accel_Y = FSWV1_APP_Data.IMUData.Accel_Y;
+    FSWV1_APP_Data.CombinedTlm.Payload.Accel_Z = FSWV1_APP_Data.IMUData.Accel_Z;
+    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_X = FSWV1_APP_Data.IMUData.Gyro_X;
+    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_Y = FSWV1_APP_Data.IMUData.Gyro_Y;
+    FSWV1_APP_Data.CombinedTlm.Payload.Gyro_Z = FSWV1_APP_Data.IMUData.Gyro_Z;
+    FSWV1_APP_Data.CombinedTlm.Payload.IMU_Temperature = FSWV1_APP_Data.IMUData.Temperature;
+    FSWV1_APP_Data.CombinedTlm.Payload.IMU_Time = FSWV1_APP_Data.IMUData.Timestamp;
+
+#if FSWV1_APP_CONSOLE_DEBUG
+    /* Print IMU data (skipped while the cycle is overrunning) */
+    if (!FSWV1_Deadline_Degraded())
+    {
+        FSWV1_APP_PrintIMU();
+    }
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Combined telemetry rate group                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_APP_SendCombinedTlm(void)
+{
+    uint64 start;
+    uint64 elapsed;
+
+    /* Always transmit telemetry (even if sensors disabled, send zeros) */
+    FSWV1_APP_Data.CombinedTlm.Payload.Timestamp = FSWV1_Time_GetTime().Seconds;
+    
+    /* Update sequence count */
+    CFE_MSG_SetSequenceCount(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader),
+                            FSWV1_APP_Data.CombinedTlmSeqCnt);
+    FSWV1_APP_Data.CombinedTlmSeqCnt++;
+    
+    /* Timestamp and transmit on Software Bus */
+    FSWV1_Time_StampMsg(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(FSWV1_APP_Data.CombinedTlm.TelemetryHeader), false);
+    
+    /* Send combined data via UDP */
+    start = FSWV1_Sched_NowNs();
+    FSWV1_SendUDP(&FSWV1_APP_Data.SensorData, &FSWV1_APP_Data.IMUData);
+    elapsed = FSWV1_Sched_NowNs() - start;
+    FSWV1_Perf_Record(FSWV1_APP_PERF_SEND_UDP, elapsed);
+    FSWV1_Deadline_StageTime(FSWV1_APP_STAGE_UDP, elapsed);
+    
+    /* Send combined data via Telemetry UART */
+    start = FSWV1_Sched_NowNs();
+    FSWV1_SendTelemetryUART(&FSWV1_APP_Data.SensorData, &FSWV1_APP_Data.IMUData);
+    elapsed = FSWV1_Sched_NowNs() - start;
+    FSWV1_Perf_Record(FSWV1_APP_PERF_SEND_TLM_UART, elapsed);
+    FSWV1_Deadline_StageTime(FSWV1_APP_STAGE_UART, elapsed);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Data-ready edge - run the data-ready rate group now                     */
+/* Called by the event loop as soon as the line fires, and once per cycle */
+/* for the other wakeup sources. Several queued edges collapse into one   */
+/* acquisition stamped with the newest edge.                               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_APP_DataReady(void)
+{
+    uint64 edge_ns;
+    uint64 latency_us;
+
+    if (FSWV1_ReadDataReady(&edge_ns) != CFE_SUCCESS)
+    {
+        return;
+    }
+
+#if FSWV1_DRDY_RATE_GROUP == FSWV1_APP_RATE_GROUP_IMU
+    FSWV1_APP_SampleIMU();
+#else
+    FSWV1_APP_SampleSensor(edge_ns);
+#endif
+    FSWV1_APP_Data.RateGroups[FSWV1_DRDY_RATE_GROUP].RunCount++;
+
+    latency_us = (FSWV1_Time_MonoNs() - edge_ns) / 1000;
+    if (latency_us > FSWV1_APP_Data.DrdyMaxLatencyUs)
+    {
+        FSWV1_APP_Data.DrdyMaxLatencyUs = (uint32)latency_us;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Acquisition/telemetry cycle - runs every rate group that is due        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_APP_RunCycle(void)
+{
+    uint64 now = FSWV1_Sched_NowNs();
+
+    FSWV1_Deadline_BeginCycle();
+
+    /* Samples the barometer bus tasks finished since the last cycle */
+    FSWV1_APP_CollectSensors();
+
+    /* Edges not already handled by the event loop */
+    if (FSWV1_APP_Data.DrdyActive)
+    {
+        FSWV1_APP_DataReady();
+    }
+
+    if (!(FSWV1_APP_Data.DrdyActive && FSWV1_DRDY_RATE_GROUP == FSWV1_APP_RATE_GROUP_BMP280) &&
+        FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_BMP280, now))
+    {
+        FSWV1_APP_SampleSensor(0);
+    }
+
+    if (!(FSWV1_APP_Data.DrdyActive && FSWV1_DRDY_RATE_GROUP == FSWV1_APP_RATE_GROUP_IMU) &&
+        FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_IMU, now))
+    {
+        FSWV1_APP_SampleIMU();
+    }
+
+    if (FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_TLM, now))
+    {
+        FSWV1_APP_SendCombinedTlm();
+    }
+
+    if (FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_HK, now))
+    {
+        FSWV1_APP_ReportHousekeeping(NULL);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Drain pending commands from the command pipe (non-blocking)            */
+/* Stops when the pipe is empty or the message/time budget is used up;    */
+/* anything left stays queued for the next wakeup.                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_APP_ProcessCommands(void)
+{
+    int32 status = CFE_SUCCESS;
+    CFE_SB_Buffer_t *SBBufPtr;
+    uint64 start = FSWV1_Sched_NowNs();
+    uint64 budget_ns = (uint64)FSWV1_APP_Data.CmdBudgetUs * 1000;
+    uint32 processed = 0;
+
+    while (true)
+    {
+        /* Always take at least one command so the pipe cannot starve */
+        if (processed > 0)
+        {
+            if (FSWV1_APP_Data.CmdBudgetMsgs != 0 && processed >= FSWV1_APP_Data.CmdBudgetMsgs)
+            {
+                break;
+            }
+            if (budget_ns != 0 && (FSWV1_Sched_NowNs() - start) >= budget_ns)
+            {
+                break;
+            }
+        }
+
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, FSWV1_APP_Data.CommandPipe, CFE_SB_POLL);
+        if (status != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        FSWV1_APP_ProcessCommandPacket(SBBufPtr);
+        processed++;
+
+        FSWV1_APP_Data.CmdBurstCount++;
+        if (FSWV1_APP_Data.CmdBurstCount > FSWV1_APP_Data.CmdBurstHighWater)
+        {
+            FSWV1_APP_Data.CmdBurstHighWater = (uint16)FSWV1_APP_Data.CmdBurstCount;
+        }
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /* Budget used up before the pipe was seen empty */
+        FSWV1_APP_Data.CmdDeferredCount++;
+    }
+    else if (status == CFE_SB_NO_MESSAGE)
+    {
+        FSWV1_APP_Data.CmdBurstCount = 0;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "FSWV1: SB pipe read error, RC = 0x%08X", (unsigned int)status);
+    }
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
 /* Initialization                                                          */
@@ -148,6 +576,11 @@ void FSWV1_APP_Main(void)
 int32 FSWV1_APP_Init(void)
 {
     int32 status;
+    int32 gpio_status;
+#if FSWV1_APP_TIME_SOURCE != FSWV1_TIME_SOURCE_SIM
+    int32 uart_status;
+#endif
+    uint8 i;
 
     FSWV1_APP_Data.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
@@ -158,15 +591,22 @@ int32 FSWV1_APP_Init(void)
     FSWV1_APP_Data.ErrCounter = 0;
     FSWV1_APP_Data.SensorEnabled = true;
     FSWV1_APP_Data.IMUEnabled = true;
-    FSWV1_APP_Data.ReadRate = FSWV1_DEFAULT_READ_RATE;
-    FSWV1_APP_Data.CombinedTlmSeqCnt = 0;
+    FSWV1_InitRateGroups();
     FSWV1_APP_Data.CombinedTlmSeqCnt = 0;
     FSWV1_APP_Data.LedState = false;
+    FSWV1_APP_Data.CycleCount = 0;
+    FSWV1_APP_Data.MissedCycles = 0;
+    FSWV1_APP_Data.CmdBudgetMsgs = FSWV1_APP_CMD_BUDGET_MSGS;
+    FSWV1_APP_Data.CmdBudgetUs = FSWV1_APP_CMD_BUDGET_US;
+    FSWV1_APP_Data.CmdBurstCount = 0;
+    FSWV1_APP_Data.CmdBurstHighWater = 0;
+    FSWV1_APP_Data.CmdDeferredCount = 0;
 
     /*
     ** Initialize app configuration data
     */
     FSWV1_APP_Data.CommandPipe = CFE_SB_INVALID_PIPE;
+    FSWV1_APP_Data.WakeupPipe = CFE_SB_INVALID_PIPE;
 
     /*
     ** Register event filter table
@@ -232,6 +672,42 @@ int32 FSWV1_APP_Init(void)
                 CFE_SB_ValueToMsgId(FSWV1_APP_COMBINED_TLM_MID),
                 sizeof(FSWV1_APP_Data.CombinedTlm));
 
+    CFE_MSG_Init(CFE_MSG_PTR(FSWV1_APP_Data.PerfTlm.TelemetryHeader),
+                CFE_SB_ValueToMsgId(FSWV1_APP_PERF_TLM_MID),
+                sizeof(FSWV1_APP_Data.PerfTlm));
+
+    for (i = 0; i < FSWV1_BMP_MAX_INSTANCES; i++)
+    {
+        CFE_MSG_Init(CFE_MSG_PTR(FSWV1_APP_Data.BaroTlm[i].TelemetryHeader),
+                    CFE_SB_ValueToMsgId(FSWV1_APP_BARO_TLM_MID),
+                    sizeof(FSWV1_APP_Data.BaroTlm[i]));
+        FSWV1_APP_Data.BaroTlm[i].Payload.Instance = (uint8)i;
+    }
+
+    for (i = 0; i < FSWV1_IMU_MAX_INSTANCES; i++)
+    {
+        CFE_MSG_Init(CFE_MSG_PTR(FSWV1_APP_Data.ImuTlm[i].TelemetryHeader),
+                    CFE_SB_ValueToMsgId(FSWV1_APP_IMU_TLM_MID),
+                    sizeof(FSWV1_APP_Data.ImuTlm[i]));
+        FSWV1_APP_Data.ImuTlm[i].Payload.Instance = (uint8)i;
+    }
+
+    FSWV1_Perf_Reset();
+    FSWV1_Deadline_Reset();
+    FSWV1_TTQ_Init();
+
+    /*
+    ** Apply the real-time profile to the main task (not fatal)
+    */
+    FSWV1_RT_Init();
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    /*
+    ** Simulated time reads the synthetic sensors; the buses and IMU UARTs
+    ** are left closed
+    */
+    FSWV1_SimSrc_Reset();
+#else
     /*
     ** Initialize sensor
     */
@@ -242,6 +718,11 @@ int32 FSWV1_APP_Init(void)
                         "FSWV1: Sensor initialization failed, RC = 0x%08X", (unsigned int)status);
         /* Continue anyway - sensor might be simulated */
     }
+#if FSWV1_BMP_TASK_ENABLE
+    /* Buses without a task are read by the main task */
+    FSWV1_StartSensorTasks();
+#endif
+#endif
 
     /*
     ** Initialize UDP
@@ -268,23 +749,51 @@ int32 FSWV1_APP_Init(void)
     /*
     ** Initialize GPIO for LED control
     */
-    status = FSWV1_InitGPIO();
-    
+    gpio_status = FSWV1_InitGPIO();
+    if (gpio_status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_GPIO_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "FSWV1: GPIO initialization failed, RC = 0x%08X", (unsigned int)gpio_status);
+        /* Continue anyway - LED commands will fail gracefully */
+    }
+
+#if FSWV1_APP_TIME_SOURCE != FSWV1_TIME_SOURCE_SIM
     /*
     ** Initialize UART for IMU data
     */
-    status = FSWV1_InitUART();
-    if (status != CFE_SUCCESS)
+    uart_status = FSWV1_InitUART();
+    if (uart_status != CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
-                        "FSWV1: UART initialization failed, RC = 0x%08X", (unsigned int)status);
+                        "FSWV1: UART initialization failed, RC = 0x%08X", (unsigned int)uart_status);
         /* Continue anyway - UART is optional */
     }
+
+#if FSWV1_IMU_TASK_ENABLE && FSWV1_APP_WAKEUP_SOURCE != FSWV1_WAKEUP_SOURCE_EPOLL
+    /*
+    ** IMU reader task; falls back to polling from the main loop if it fails
+    */
+    if (uart_status == CFE_SUCCESS)
+    {
+        FSWV1_StartIMUTask();
+    }
+#endif
+#endif
+
+#if FSWV1_DRDY_ENABLE && FSWV1_APP_TIME_SOURCE != FSWV1_TIME_SOURCE_SIM
+    /*
+    ** Data-ready input; the rate group keeps its timer if the line is unavailable
+    */
+    FSWV1_APP_Data.DrdyActive = (FSWV1_InitDataReady() == CFE_SUCCESS);
+#endif
+
+    /*
+    ** Initialize cycle wakeup source (last: the event loop watches the UARTs)
+    */
+    status = FSWV1_InitSched();
     if (status != CFE_SUCCESS)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_GPIO_ERR_EID, CFE_EVS_EventType_ERROR,
-                        "FSWV1: GPIO initialization failed, RC = 0x%08X", (unsigned int)status);
-        /* Continue anyway - LED commands will fail gracefully */
+        return status;
     }
 
     CFE_EVS_SendEvent(FSWV1_APP_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
@@ -395,6 +904,69 @@ void FSWV1_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
             }
             break;
 
+        case FSWV1_APP_SET_RATE_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_SetRateCmd_t)))
+            {
+                FSWV1_APP_SetRate((FSWV1_APP_SetRateCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_RESET_PERF_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_ResetPerfCmd_t)))
+            {
+                FSWV1_APP_ResetPerf((FSWV1_APP_ResetPerfCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_SET_CMD_BUDGET_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_SetCmdBudgetCmd_t)))
+            {
+                FSWV1_APP_SetCmdBudget((FSWV1_APP_SetCmdBudgetCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_SET_RT_PROFILE_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_SetRtProfileCmd_t)))
+            {
+                FSWV1_APP_SetRtProfile((FSWV1_APP_SetRtProfileCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_RT_JITTER_RPT_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_RtJitterReportCmd_t)))
+            {
+                FSWV1_APP_RtJitterReport((FSWV1_APP_RtJitterReportCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_TIME_TAG_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_TimeTagCmd_t)))
+            {
+                FSWV1_APP_TimeTag((FSWV1_APP_TimeTagCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_TTQ_CLEAR_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_TtqClearCmd_t)))
+            {
+                FSWV1_APP_TtqClear((FSWV1_APP_TtqClearCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_SET_IMU_FORMAT_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_SetImuFormatCmd_t)))
+            {
+                FSWV1_APP_SetImuFormat((FSWV1_APP_SetImuFormatCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case FSWV1_APP_SET_BMP_PROFILE_CC:
+            if (FSWV1_APP_VerifyCommandLength(&SBBufPtr->Msg, sizeof(FSWV1_APP_SetBmpProfileCmd_t)))
+            {
+                FSWV1_APP_SetBmpProfile((FSWV1_APP_SetBmpProfileCmd_t *)SBBufPtr);
+            }
+            break;
+
         default:
             FSWV1_APP_Data.ErrCounter++;
             CFE_EVS_SendEvent(FSWV1_APP_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
@@ -411,6 +983,10 @@ void FSWV1_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 int32 FSWV1_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 {
     bool led_state;
+    uint8 i;
+    FSWV1_IMULinkStats_t link_stats;
+    FSWV1_IMULinkStats_t inst_stats;
+    FSWV1_BaroStats_t baro_stats;
     
     /*
     ** Update housekeeping telemetry
@@ -419,6 +995,107 @@ int32 FSWV1_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
     FSWV1_APP_Data.HkTlm.Payload.CommandErrorCounter = FSWV1_APP_Data.ErrCounter;
     FSWV1_APP_Data.HkTlm.Payload.SensorEnabled = FSWV1_APP_Data.SensorEnabled ? 1 : 0;
     FSWV1_APP_Data.HkTlm.Payload.ReadRate = FSWV1_APP_Data.ReadRate;
+    FSWV1_APP_Data.HkTlm.Payload.CycleCount = FSWV1_APP_Data.CycleCount;
+    FSWV1_APP_Data.HkTlm.Payload.MissedCycles = FSWV1_APP_Data.MissedCycles;
+    FSWV1_GetIMURingStats(&FSWV1_APP_Data.HkTlm.Payload.ImuRingOverflows,
+                          &FSWV1_APP_Data.HkTlm.Payload.ImuRingHighWater);
+
+    for (i = 0; i < FSWV1_APP_RATE_GROUP_COUNT; i++)
+    {
+        FSWV1_APP_Data.HkTlm.Payload.RateGroupHz[i] = FSWV1_APP_Data.RateGroups[i].RateHz;
+        FSWV1_APP_Data.HkTlm.Payload.RateGroupSkipped[i] = FSWV1_APP_Data.RateGroups[i].SkippedCount;
+    }
+
+    FSWV1_APP_Data.HkTlm.Payload.CmdBudgetMsgs = FSWV1_APP_Data.CmdBudgetMsgs;
+    FSWV1_APP_Data.HkTlm.Payload.CmdBudgetUs = FSWV1_APP_Data.CmdBudgetUs;
+    FSWV1_APP_Data.HkTlm.Payload.CmdBurstHighWater = FSWV1_APP_Data.CmdBurstHighWater;
+    FSWV1_APP_Data.HkTlm.Payload.CmdDeferredCount = FSWV1_APP_Data.CmdDeferredCount;
+
+    for (i = 0; i < FSWV1_APP_STAGE_COUNT; i++)
+    {
+        FSWV1_APP_Data.HkTlm.Payload.CycleOverruns[i] = FSWV1_APP_Data.Deadline.Overruns[i];
+    }
+    FSWV1_APP_Data.HkTlm.Payload.MaxCycleExecUs = (uint32)(FSWV1_APP_Data.Deadline.MaxExecNs / 1000);
+    FSWV1_APP_Data.HkTlm.Payload.DegradedEntries = FSWV1_APP_Data.Deadline.DegradedEntries;
+    FSWV1_APP_Data.HkTlm.Payload.Degraded = FSWV1_APP_Data.Deadline.Degraded ? 1 : 0;
+    FSWV1_APP_Data.HkTlm.Payload.RtProfile = FSWV1_RT_GetProfile();
+    FSWV1_APP_Data.HkTlm.Payload.TtqOccupancy = (uint16)FSWV1_APP_Data.Ttq.Occupancy;
+    FSWV1_APP_Data.HkTlm.Payload.TtqHighWater = (uint16)FSWV1_APP_Data.Ttq.HighWater;
+    FSWV1_APP_Data.HkTlm.Payload.TtqExecuted = FSWV1_APP_Data.Ttq.ExecutedCount;
+    FSWV1_APP_Data.HkTlm.Payload.TtqLate = FSWV1_APP_Data.Ttq.LateCount;
+    FSWV1_APP_Data.HkTlm.Payload.TtqMaxLateUs = FSWV1_APP_Data.Ttq.MaxLateUs;
+    FSWV1_APP_Data.HkTlm.Payload.TtqRejected = FSWV1_APP_Data.Ttq.RejectedCount;
+
+    FSWV1_GetUARTReadStats(&FSWV1_APP_Data.HkTlm.Payload.ImuUartReadCalls,
+                           &FSWV1_APP_Data.HkTlm.Payload.ImuUartBytesRead);
+    FSWV1_APP_Data.HkTlm.Payload.ImuUartBytesPerRead =
+        (FSWV1_APP_Data.HkTlm.Payload.ImuUartReadCalls > 0) ?
+        FSWV1_APP_Data.HkTlm.Payload.ImuUartBytesRead / FSWV1_APP_Data.HkTlm.Payload.ImuUartReadCalls : 0;
+    FSWV1_GetIMUParseStats(&FSWV1_APP_Data.HkTlm.Payload.ImuParseErrors,
+                           &FSWV1_APP_Data.HkTlm.Payload.ImuLastBadField);
+    FSWV1_APP_Data.HkTlm.Payload.ImuLastDrainCount = FSWV1_APP_Data.IMUSampleCount;
+    FSWV1_APP_Data.HkTlm.Payload.ImuDrainDropped = FSWV1_GetIMUDrainDropped();
+    FSWV1_GetIMUFormatStats(&FSWV1_APP_Data.HkTlm.Payload.ImuFormat,
+                            &FSWV1_APP_Data.HkTlm.Payload.ImuFormatActive,
+                            &FSWV1_APP_Data.HkTlm.Payload.ImuCrcErrors,
+                            &FSWV1_APP_Data.HkTlm.Payload.ImuResyncs);
+    FSWV1_GetIMULinkStats(&link_stats);
+    FSWV1_APP_Data.HkTlm.Payload.ImuFramesGood = link_stats.FramesGood;
+    FSWV1_APP_Data.HkTlm.Payload.ImuOverflows = link_stats.Overflows;
+    FSWV1_APP_Data.HkTlm.Payload.ImuTruncated = link_stats.Truncated;
+    FSWV1_APP_Data.HkTlm.Payload.ImuReadErrors = link_stats.ReadErrors;
+    FSWV1_APP_Data.HkTlm.Payload.ImuSeqGaps = link_stats.SeqGaps;
+    FSWV1_APP_Data.HkTlm.Payload.ImuSeqLost = link_stats.SeqLost;
+    FSWV1_APP_Data.HkTlm.Payload.ImuSeqResets = link_stats.SeqResets;
+    FSWV1_APP_Data.HkTlm.Payload.ImuIntervalUs = link_stats.IntervalUs;
+    FSWV1_APP_Data.HkTlm.Payload.ImuJitterUs = link_stats.JitterUs;
+    FSWV1_APP_Data.HkTlm.Payload.ImuMaxIntervalUs = link_stats.MaxIntervalUs;
+    FSWV1_GetIMUInstances(&FSWV1_APP_Data.HkTlm.Payload.ImuInstances,
+                          &FSWV1_APP_Data.HkTlm.Payload.ImuOpenMask);
+
+    for (i = 0; i < FSWV1_APP_Data.HkTlm.Payload.ImuInstances; i++)
+    {
+        FSWV1_GetIMUInstanceStats(i, &inst_stats, &FSWV1_APP_Data.HkTlm.Payload.ImuInstFormatActive[i]);
+        FSWV1_APP_Data.HkTlm.Payload.ImuInstFramesGood[i] = inst_stats.FramesGood;
+        FSWV1_APP_Data.HkTlm.Payload.ImuInstBadFrames[i] = inst_stats.BadFrames;
+        FSWV1_APP_Data.HkTlm.Payload.ImuInstSeqLost[i] = inst_stats.SeqLost;
+        FSWV1_APP_Data.HkTlm.Payload.ImuInstMaxIntervalUs[i] = inst_stats.MaxIntervalUs;
+    }
+
+    FSWV1_APP_Data.HkTlm.Payload.DrdyActive = FSWV1_APP_Data.DrdyActive ? 1 : 0;
+    FSWV1_GetDataReadyStats(&FSWV1_APP_Data.HkTlm.Payload.DrdyEdges,
+                            &FSWV1_APP_Data.HkTlm.Payload.DrdyMissed);
+    FSWV1_APP_Data.HkTlm.Payload.DrdyMaxLatencyUs = FSWV1_APP_Data.DrdyMaxLatencyUs;
+    FSWV1_GetSensorBusStats(&FSWV1_APP_Data.HkTlm.Payload.SensorI2cTransactions,
+                            &FSWV1_APP_Data.HkTlm.Payload.SensorI2cErrors,
+                            &FSWV1_APP_Data.HkTlm.Payload.SensorI2cBytes,
+                            &FSWV1_APP_Data.HkTlm.Payload.SensorI2cTxnPerSample);
+    FSWV1_GetSensorProfile(FSWV1_BMP_PRIMARY_INSTANCE, &FSWV1_APP_Data.HkTlm.Payload.BmpProfile,
+                           &FSWV1_APP_Data.HkTlm.Payload.BmpMeasTimeUs,
+                           &FSWV1_APP_Data.HkTlm.Payload.BmpNotReady);
+    FSWV1_GetSensorInstances(&FSWV1_APP_Data.HkTlm.Payload.BmpInstances,
+                             &FSWV1_APP_Data.HkTlm.Payload.BmpHealthyMask,
+                             &FSWV1_APP_Data.HkTlm.Payload.BmpBuses,
+                             &FSWV1_APP_Data.HkTlm.Payload.BmpBusTaskMask);
+
+    for (i = 0; i < FSWV1_APP_Data.HkTlm.Payload.BmpInstances; i++)
+    {
+        FSWV1_GetSensorInstanceStats(i, &baro_stats);
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstHealth[i] = baro_stats.Health;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstChip[i] = baro_stats.Chip;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstSamples[i] = baro_stats.Samples;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstNotReady[i] = baro_stats.NotReady;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstReadErrors[i] = baro_stats.ReadErrors;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstRecoveries[i] = baro_stats.Recoveries;
+        FSWV1_APP_Data.HkTlm.Payload.BmpInstFifoFull[i] = baro_stats.FifoFull;
+    }
+
+    for (i = 0; i < FSWV1_APP_Data.HkTlm.Payload.BmpBuses; i++)
+    {
+        FSWV1_GetSensorBusPassStats(i, &FSWV1_APP_Data.HkTlm.Payload.BmpBusPasses[i],
+                                    &FSWV1_APP_Data.HkTlm.Payload.BmpBusOverruns[i],
+                                    &FSWV1_APP_Data.HkTlm.Payload.BmpBusMaxPassUs[i]);
+    }
     
     /* Get current LED state */
     if (FSWV1_GetLED(&led_state) == CFE_SUCCESS)
@@ -431,9 +1108,23 @@ int32 FSWV1_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
         FSWV1_APP_Data.HkTlm.Payload.LedState = 0;
     }
 
-    CFE_SB_TimeStampMsg(CFE_MSG_PTR(FSWV1_APP_Data.HkTlm.TelemetryHeader));
+    FSWV1_Time_StampMsg(CFE_MSG_PTR(FSWV1_APP_Data.HkTlm.TelemetryHeader));
     CFE_SB_TransmitMsg(CFE_MSG_PTR(FSWV1_APP_Data.HkTlm.TelemetryHeader), true);
 
+    /* Performance statistics go out with every housekeeping packet */
+    FSWV1_Perf_SendTlm();
+
+#if !FSWV1_APP_CONSOLE_DEBUG
+    /* Latest readings on the console at the housekeeping rate, not per sample */
+    if (!FSWV1_Deadline_Degraded())
+    {
+        OS_printf("FSWV1: BMP Temp=%.2f°C, Press=%.2f Pa\n",
+                 FSWV1_APP_Data.SensorData.Temperature,
+                 FSWV1_APP_Data.SensorData.Pressure);
+        FSWV1_APP_PrintIMU();
+    }
+#endif
+
     return CFE_SUCCESS;
 }
 
@@ -459,8 +1150,38 @@ int32 FSWV1_APP_Noop(const FSWV1_APP_NoopCmd_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 int32 FSWV1_APP_ResetCounters(const FSWV1_APP_ResetCountersCmd_t *Msg)
 {
+    uint8 i;
+
     FSWV1_APP_Data.CmdCounter = 0;
     FSWV1_APP_Data.ErrCounter = 0;
+    FSWV1_APP_Data.CycleCount = 0;
+    FSWV1_APP_Data.MissedCycles = 0;
+
+    for (i = 0; i < FSWV1_APP_RATE_GROUP_COUNT; i++)
+    {
+        FSWV1_APP_Data.RateGroups[i].RunCount = 0;
+        FSWV1_APP_Data.RateGroups[i].SkippedCount = 0;
+    }
+
+    FSWV1_APP_Data.CmdBurstHighWater = 0;
+    FSWV1_APP_Data.CmdDeferredCount = 0;
+
+    /* Deadline statistics only; the current mode is left alone */
+    for (i = 0; i < FSWV1_APP_STAGE_COUNT; i++)
+    {
+        FSWV1_APP_Data.Deadline.Overruns[i] = 0;
+    }
+    FSWV1_APP_Data.Deadline.MaxExecNs = 0;
+    FSWV1_APP_Data.Deadline.DegradedEntries = 0;
+
+    FSWV1_APP_Data.DrdyMaxLatencyUs = 0;
+
+    /* Time-tag statistics; occupancy reflects the queue and is kept */
+    FSWV1_APP_Data.Ttq.HighWater = FSWV1_APP_Data.Ttq.Occupancy;
+    FSWV1_APP_Data.Ttq.ExecutedCount = 0;
+    FSWV1_APP_Data.Ttq.LateCount = 0;
+    FSWV1_APP_Data.Ttq.MaxLateUs = 0;
+    FSWV1_APP_Data.Ttq.RejectedCount = 0;
 
     CFE_EVS_SendEvent(FSWV1_APP_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION,
                      "FSWV1: RESET command");
@@ -654,3 +1375,260 @@ int32 FSWV1_APP_LedStatus(const FSWV1_APP_LedStatusCmd_t *Msg)
     
     return status;
 }
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* SET RATE command                                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_SetRate(const FSWV1_APP_SetRateCmd_t *Msg)
+{
+    int32 status;
+    
+    status = FSWV1_SetRateGroup(Msg->Payload.RateGroup, Msg->Payload.RateHz);
+    
+    if (status == CFE_SUCCESS)
+    {
+        FSWV1_APP_Data.CmdCounter++;
+        
+        CFE_EVS_SendEvent(FSWV1_APP_SET_RATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1: Rate group %u set to %u Hz",
+                         (unsigned int)Msg->Payload.RateGroup, (unsigned int)Msg->Payload.RateHz);
+    }
+    else
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_SET_RATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Invalid SET RATE group %u / rate %u Hz (max %u, the wakeup rate)",
+                         (unsigned int)Msg->Payload.RateGroup, (unsigned int)Msg->Payload.RateHz,
+                         (unsigned int)FSWV1_APP_WAKEUP_RATE_HZ);
+    }
+    
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Reset performance statistics command                                    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_ResetPerf(const FSWV1_APP_ResetPerfCmd_t *Msg)
+{
+    FSWV1_Perf_Reset();
+    FSWV1_RT_ResetJitter();
+    FSWV1_APP_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(FSWV1_APP_RESET_PERF_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: Performance statistics reset");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set command drain budget command                                        */
+/* Either limit may be 0 (none), but not both: an unbounded drain could   */
+/* hold off sampling for as long as commands keep arriving.                */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_SetCmdBudget(const FSWV1_APP_SetCmdBudgetCmd_t *Msg)
+{
+    if (Msg->Payload.MaxMsgs == 0 && Msg->Payload.MaxUs == 0)
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_CMD_BUDGET_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Command budget needs a message or time limit (both 0 rejected)");
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    FSWV1_APP_Data.CmdBudgetMsgs = Msg->Payload.MaxMsgs;
+    FSWV1_APP_Data.CmdBudgetUs = Msg->Payload.MaxUs;
+    FSWV1_APP_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(FSWV1_APP_CMD_BUDGET_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: Command budget set to %u msgs / %u us per wakeup",
+                     (unsigned int)Msg->Payload.MaxMsgs, (unsigned int)Msg->Payload.MaxUs);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set real-time profile command                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_SetRtProfile(const FSWV1_APP_SetRtProfileCmd_t *Msg)
+{
+    int32 status;
+    uint8 failed = 0;
+
+    if (Msg->Payload.Profile >= FSWV1_RT_PROFILE_COUNT)
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_RT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Invalid real-time profile %u", (unsigned int)Msg->Payload.Profile);
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    /* Each task's failures are reported by FSWV1_RT; this event sums them up */
+    status = FSWV1_RT_SetProfile(Msg->Payload.Profile, &failed);
+    if (status != CFE_SUCCESS)
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_RT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Real-time profile %u partially applied, failed:%s%s%s",
+                         (unsigned int)Msg->Payload.Profile,
+                         (failed & FSWV1_RT_FAILED_PRIORITY) ? " priority" : "",
+                         (failed & FSWV1_RT_FAILED_AFFINITY) ? " affinity" : "",
+                         (failed & FSWV1_RT_FAILED_MEMLOCK) ? " mlockall" : "");
+        return status;
+    }
+
+    FSWV1_APP_Data.CmdCounter++;
+    CFE_EVS_SendEvent(FSWV1_APP_RT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: Real-time profile %u applied", (unsigned int)Msg->Payload.Profile);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Real-time jitter report command                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_RtJitterReport(const FSWV1_APP_RtJitterReportCmd_t *Msg)
+{
+    FSWV1_APP_Data.CmdCounter++;
+    FSWV1_RT_ReportJitter();
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Time-tag command - queue a wrapped command for an absolute CFE time     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_TimeTag(const FSWV1_APP_TimeTagCmd_t *Msg)
+{
+    CFE_TIME_SysTime_t exec_time;
+    int32 status;
+
+    exec_time.Seconds = Msg->Payload.ExecSeconds;
+    exec_time.Subseconds = Msg->Payload.ExecSubseconds;
+
+    status = FSWV1_TTQ_Insert(exec_time, Msg->Payload.CommandCode, Msg->Payload.Args, Msg->Payload.ArgLength);
+
+    if (status == CFE_SUCCESS)
+    {
+        FSWV1_APP_Data.CmdCounter++;
+
+        CFE_EVS_SendEvent(FSWV1_APP_TTQ_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1: Command code %u tagged for %u.%06u (%u queued)",
+                         (unsigned int)Msg->Payload.CommandCode, (unsigned int)exec_time.Seconds,
+                         (unsigned int)CFE_TIME_Sub2MicroSecs(exec_time.Subseconds),
+                         (unsigned int)FSWV1_APP_Data.Ttq.Occupancy);
+    }
+    else
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        FSWV1_APP_Data.Ttq.RejectedCount++;
+
+        CFE_EVS_SendEvent(FSWV1_APP_TTQ_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Time tag for command code %u rejected (%s)",
+                         (unsigned int)Msg->Payload.CommandCode,
+                         status == CFE_ES_BAD_ARGUMENT ? "bad command or arguments" : "queue full");
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Clear the time-tagged command queue                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_TtqClear(const FSWV1_APP_TtqClearCmd_t *Msg)
+{
+    uint32 dropped = FSWV1_APP_Data.Ttq.Occupancy;
+
+    FSWV1_TTQ_Clear();
+    FSWV1_APP_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(FSWV1_APP_TTQ_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: Time-tagged command queue cleared (%u dropped)", (unsigned int)dropped);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set IMU wire format command                                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_SetImuFormat(const FSWV1_APP_SetImuFormatCmd_t *Msg)
+{
+    static const char *const FormatNames[FSWV1_IMU_FORMAT_COUNT] = { "ASCII", "BINARY", "AUTO" };
+
+    if (FSWV1_SetIMUFormat(Msg->Payload.Format) != CFE_SUCCESS)
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_IMU_FORMAT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Invalid IMU format %u", (unsigned int)Msg->Payload.Format);
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    FSWV1_APP_Data.CmdCounter++;
+    CFE_EVS_SendEvent(FSWV1_APP_IMU_FORMAT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: IMU format set to %s", FormatNames[Msg->Payload.Format]);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set BMP280 measurement profile command                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_APP_SetBmpProfile(const FSWV1_APP_SetBmpProfileCmd_t *Msg)
+{
+    const FSWV1_APP_SetBmpProfileCmd_Payload_t *p = &Msg->Payload;
+    FSWV1_APP_SetBmpProfileCmd_Payload_t active;
+    char target[8];
+    uint32 meas_us;
+    uint32 not_ready;
+    int32 status;
+
+    status = FSWV1_SetSensorProfile(p->Instance, p);
+    if (status != CFE_SUCCESS)
+    {
+        FSWV1_APP_Data.ErrCounter++;
+        CFE_EVS_SendEvent(FSWV1_APP_BMP_PROFILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: BMP %u profile osrs_t=%u osrs_p=%u filter=%u standby=%u mode=%u rejected, RC = 0x%08X",
+                         (unsigned int)p->Instance, (unsigned int)p->OsrsT, (unsigned int)p->OsrsP,
+                         (unsigned int)p->Filter, (unsigned int)p->Standby, (unsigned int)p->Mode,
+                         (unsigned int)status);
+        return status;
+    }
+
+    FSWV1_GetSensorProfile((p->Instance == FSWV1_BMP_ALL_INSTANCES) ? FSWV1_BMP_PRIMARY_INSTANCE : p->Instance,
+                           &active, &meas_us, &not_ready);
+    if (p->Instance == FSWV1_BMP_ALL_INSTANCES)
+    {
+        snprintf(target, sizeof(target), "all");
+    }
+    else
+    {
+        snprintf(target, sizeof(target), "%u", (unsigned int)p->Instance);
+    }
+
+    FSWV1_APP_Data.CmdCounter++;
+    CFE_EVS_SendEvent(FSWV1_APP_BMP_PROFILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1: BMP %s profile osrs_t=x%u osrs_p=x%u filter=%u standby=%u %s, conversion %u us",
+                     target,
+                     1u << (p->OsrsT - 1), 1u << (p->OsrsP - 1), p->Filter ? 1u << p->Filter : 0u,
+                     (unsigned int)p->Standby, (p->Mode == FSWV1_BMP_MODE_NORMAL) ? "normal" : "forced",
+                     (unsigned int)meas_us);
+
+    return CFE_SUCCESS;
+}
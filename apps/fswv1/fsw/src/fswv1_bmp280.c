@@ -0,0 +1,247 @@
+/******************************************************************************
+** File: fswv1_bmp280.c
+**
+** Purpose:
+**   This file contains the BMP280 barometer driver for the FSWV1 app.
+**
+**   One sample per read: the status and data registers are read in one
+**   transaction. In forced mode the next conversion is started in the
+**   same transaction.
+**
+******************************************************************************/
+
+#include "fswv1_baro.h"
+
+/*
+** BMP280 Register Definitions
+*/
+#define FSWV1_REG_CHIP_ID      0xD0
+#define FSWV1_REG_RESET        0xE0
+#define FSWV1_REG_STATUS       0xF3
+#define FSWV1_REG_CTRL_MEAS    0xF4
+#define FSWV1_REG_CONFIG       0xF5
+#define FSWV1_REG_PRESS_MSB    0xF7
+#define FSWV1_REG_TEMP_MSB     0xFA
+#define FSWV1_REG_CALIB_00     0x88
+
+#define FSWV1_CHIP_ID          0x58
+
+#define FSWV1_STATUS_MEASURING 0x08   /* Conversion running */
+#define FSWV1_STATUS_IM_UPDATE 0x01   /* NVM being copied to image registers */
+#define FSWV1_MODE_SLEEP       0x00
+#define FSWV1_STATUS_RUN_SIZE  10     /* status (0xF3) .. temp_xlsb (0xFC) */
+
+/* Normal mode standby times by code (microseconds) */
+static const uint32 StandbyUs[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Apply the measurement profile                                           */
+/* The sensor is put to sleep first so the config write is not ignored,   */
+/* then config and ctrl_meas are set, all in one write. Forced mode stays */
+/* asleep until the next read starts a conversion.                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP280_ApplyProfile(FSWV1_BaroDevice_t *Dev)
+{
+    const FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile = &Dev->Profile;
+    FSWV1_BMP280_State_t *s = &Dev->State.Bmp280;
+    uint8 ctrl;
+    uint8 pairs[6];
+    uint32 osrs_t;
+    uint32 osrs_p;
+    uint32 typ_us;
+    int32 status;
+
+    ctrl = (uint8)((Profile->OsrsT << 5) | (Profile->OsrsP << 2));
+
+    pairs[0] = FSWV1_REG_CTRL_MEAS;
+    pairs[1] = ctrl | FSWV1_MODE_SLEEP;
+    pairs[2] = FSWV1_REG_CONFIG;
+    pairs[3] = (uint8)((Profile->Standby << 5) | (Profile->Filter << 2));
+    pairs[4] = FSWV1_REG_CTRL_MEAS;
+    pairs[5] = ctrl | ((Profile->Mode == FSWV1_BMP_MODE_NORMAL) ? FSWV1_BMP_MODE_NORMAL : FSWV1_MODE_SLEEP);
+
+    status = FSWV1_Baro_WriteRegs(Dev, pairs, 3);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    s->CtrlMeas = ctrl;
+
+    /* Conversion time: 1.25 + 2.3 * osrs_t + 2.3 * osrs_p + 0.575 ms max, 1 + 2 + 2 + 0.5 typical */
+    osrs_t = 1u << (Profile->OsrsT - 1);
+    osrs_p = 1u << (Profile->OsrsP - 1);
+    Dev->MeasTimeUs = 1250 + 2300 * osrs_t + 2300 * osrs_p + 575;
+    typ_us = 1000 + 2000 * osrs_t + 2000 * osrs_p + 500;
+    s->OutputPeriodNs = (uint64)(typ_us + StandbyUs[Profile->Standby]) * 1000;
+
+    s->ConvPending = false;
+    s->LastSampleNs = 0;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Identify the chip, load its calibration and apply the profile          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP280_Probe(FSWV1_BaroDevice_t *Dev)
+{
+    uint8 chip_id = 0;
+    uint8 calib[FSWV1_BMP280_CALIB_SIZE];
+    FSWV1_RegRun_t id_calib[2] = {
+        {FSWV1_REG_CHIP_ID, 1, &chip_id},
+        {FSWV1_REG_CALIB_00, FSWV1_BMP280_CALIB_SIZE, calib}
+    };
+    FSWV1_BMP280_Calib_t calib_data;
+    int32 status;
+
+    /*
+    ** Read chip ID and calibration data in one transaction
+    */
+    status = FSWV1_Baro_ReadRegRuns(Dev, id_calib, 2, NULL, 0);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    if (chip_id != FSWV1_CHIP_ID)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    FSWV1_BMP280_ParseCalib(calib, &calib_data);
+    FSWV1_BMP280_InitComp(&Dev->State.Bmp280.Comp, &calib_data);
+    Dev->Chip = FSWV1_BMP_CHIP_BMP280;
+
+    return BMP280_ApplyProfile(Dev);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read sensor data                                                        */
+/* Returns OS_ERROR when there is no new conversion to read yet.          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP280_Read(FSWV1_BaroDevice_t *Dev, FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count)
+{
+    FSWV1_BMP280_State_t *s = &Dev->State.Bmp280;
+    FSWV1_SensorData_t *Data = &Samples[0];
+    uint8 regs[FSWV1_STATUS_RUN_SIZE];
+    FSWV1_RegRun_t run = {FSWV1_REG_STATUS, FSWV1_STATUS_RUN_SIZE, regs};
+    uint8 trigger[2] = {FSWV1_REG_CTRL_MEAS, 0};
+    uint8 *data = &regs[4];   /* 0xF7 */
+    uint8 busy_mask;
+    int32 adc_T, adc_P;
+#if !FSWV1_BMP_COMP_FLOAT
+    int32 temp;
+    uint32 press;
+#endif
+    int32 status;
+    uint64 now;
+    uint64 arrival;
+
+    *Count = 0;
+    if (MaxSamples == 0)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    /*
+    ** Read status and pressure/temperature data (10 bytes from 0xF3)
+    ** regs[0]: status, regs[4-6]: pressure, regs[7-9]: temperature
+    ** (MSB, LSB, XLSB). In forced mode the next conversion is started in
+    ** the same transaction.
+    */
+    now = FSWV1_Time_MonoNs();
+    trigger[1] = s->CtrlMeas | FSWV1_BMP_MODE_FORCED;
+
+    if (Dev->Profile.Mode == FSWV1_BMP_MODE_NORMAL)
+    {
+        /* No new conversion can have finished yet: leave the bus alone */
+        if (s->LastSampleNs != 0 && now - s->LastSampleNs < s->OutputPeriodNs)
+        {
+            Dev->NotReady++;
+            return OS_ERROR;
+        }
+
+        status = FSWV1_Baro_ReadReg(Dev, FSWV1_REG_STATUS, regs, FSWV1_STATUS_RUN_SIZE);
+        arrival = FSWV1_Time_MonoNs();
+        busy_mask = FSWV1_STATUS_IM_UPDATE;   /* Data registers are shadowed while measuring */
+    }
+    else if (!s->ConvPending || now < s->ConvDueNs)
+    {
+        /* Start the first conversion, or wait for the one running */
+        status = s->ConvPending ? CFE_SUCCESS : FSWV1_Baro_WriteRegs(Dev, trigger, 1);
+        if (status == CFE_SUCCESS && !s->ConvPending)
+        {
+            s->ConvPending = true;
+            s->ConvDueNs = FSWV1_Time_MonoNs() + (uint64)Dev->MeasTimeUs * 1000;
+        }
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+        Dev->NotReady++;
+        return OS_ERROR;
+    }
+    else
+    {
+        /* Collect the finished conversion and start the next one */
+        status = FSWV1_Baro_ReadRegRuns(Dev, &run, 1, trigger, 1);
+        arrival = s->ConvDueNs;
+        s->ConvPending = (status == CFE_SUCCESS);
+        s->ConvDueNs = FSWV1_Time_MonoNs() + (uint64)Dev->MeasTimeUs * 1000;
+        busy_mask = FSWV1_STATUS_MEASURING | FSWV1_STATUS_IM_UPDATE;
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (regs[0] & busy_mask)
+    {
+        Dev->NotReady++;
+        return OS_ERROR;
+    }
+    s->LastSampleNs = arrival;
+    Data->ArrivalNs = arrival;
+    Data->Instance = Dev->Instance;
+
+    /* Combine raw ADC values (20-bit) */
+    adc_P = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
+    adc_T = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
+
+    /* Compensate to °C and hPa */
+#if FSWV1_BMP_COMP_FLOAT
+    FSWV1_BMP280_CompensateFloat(&s->Comp, adc_T, adc_P, &Data->Temperature, &Data->Pressure);
+#else
+    FSWV1_BMP280_CompensateInt(&s->Comp, adc_T, adc_P, &temp, &press);
+    Data->Temperature = temp / 100.0f;
+    Data->Pressure = press / 25600.0f;
+#endif
+
+    /* Timestamp of the I2C read completion (forced mode: conversion end) */
+    Data->Timestamp = FSWV1_Time_MonoToTime(Data->ArrivalNs);
+
+    *Count = 1;
+    return CFE_SUCCESS;
+}
+
+/*
+** Driver
+*/
+const FSWV1_BaroDriver_t FSWV1_BMP280_Driver = {
+    "BMP280",
+    FSWV1_REG_CHIP_ID,
+    { FSWV1_CHIP_ID, 0 },
+    { FSWV1_BMP_CHIP_BMP280, FSWV1_BMP_CHIP_AUTO },
+    false,
+    BMP280_Probe,
+    BMP280_ApplyProfile,
+    BMP280_Read
+};
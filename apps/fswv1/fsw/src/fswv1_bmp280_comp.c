@@ -0,0 +1,164 @@
+/******************************************************************************
+** File: fswv1_bmp280_comp.c
+**
+** Purpose:
+**   This file contains the BMP280 compensation for the FSWV1 app: the
+**   datasheet integer algorithm and a float path with coefficients
+**   precomputed from the calibration.
+**
+** Notes:
+**   The temperature stage is the datasheet's 32-bit integer code in both
+**   paths. It is cheap, and keeping it makes the float path's temperature
+**   and t_fine identical to the integer path's.
+**
+**   The pressure stage of the integer algorithm is a fixed-point form of
+**
+**     q = (p0 - var2 / 2^31) * 3125 * 2^15 / var1
+**
+**   where var2 and var1 are quadratics in v = t_fine - 128000, followed by
+**   a quadratic correction in q. Dividing out the fixed-point scales once
+**   in FSWV1_BMP280_InitComp leaves nine constants, and each sample then
+**   costs two Horner quadratics, one float divide and one more quadratic.
+**   On 32-bit ARM the integer path's 64-bit divide is a library call.
+**
+******************************************************************************/
+
+#include "fswv1_bmp280_comp.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Unpack the calibration block (little-endian words from 0x88)           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP280_ParseCalib(const uint8_t Raw[FSWV1_BMP280_CALIB_SIZE], FSWV1_BMP280_Calib_t *Calib)
+{
+    /* Temperature calibration (6 bytes from 0x88) */
+    Calib->dig_T1 = (uint16_t)((Raw[1] << 8) | Raw[0]);
+    Calib->dig_T2 = (int16_t)((Raw[3] << 8) | Raw[2]);
+    Calib->dig_T3 = (int16_t)((Raw[5] << 8) | Raw[4]);
+
+    /* Pressure calibration (18 bytes from 0x8E) */
+    Calib->dig_P1 = (uint16_t)((Raw[7] << 8) | Raw[6]);
+    Calib->dig_P2 = (int16_t)((Raw[9] << 8) | Raw[8]);
+    Calib->dig_P3 = (int16_t)((Raw[11] << 8) | Raw[10]);
+    Calib->dig_P4 = (int16_t)((Raw[13] << 8) | Raw[12]);
+    Calib->dig_P5 = (int16_t)((Raw[15] << 8) | Raw[14]);
+    Calib->dig_P6 = (int16_t)((Raw[17] << 8) | Raw[16]);
+    Calib->dig_P7 = (int16_t)((Raw[19] << 8) | Raw[18]);
+    Calib->dig_P8 = (int16_t)((Raw[21] << 8) | Raw[20]);
+    Calib->dig_P9 = (int16_t)((Raw[23] << 8) | Raw[22]);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Precompute the float path coefficients                                  */
+/* Computed in double and rounded once to float.                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP280_InitComp(FSWV1_BMP280_Comp_t *Comp, const FSWV1_BMP280_Calib_t *Calib)
+{
+    const double p1 = Calib->dig_P1;
+
+    Comp->Calib = *Calib;
+
+    /* var2 / 2^31 = P6 v^2 / 2^31 + P5 v / 2^14 + P4 * 16 */
+    Comp->A0 = (float)(Calib->dig_P4 * 16.0);
+    Comp->A1 = (float)(Calib->dig_P5 / 16384.0);
+    Comp->A2 = (float)(Calib->dig_P6 / 2147483648.0);
+
+    /* var1 / (3125 * 2^15) = P1 / 6250 * (1 + P2 v / 2^35 + P3 v^2 / 2^55) */
+    Comp->E0 = (float)(p1 / 6250.0);
+    Comp->E1 = (float)(p1 * Calib->dig_P2 / (6250.0 * 34359738368.0));
+    Comp->E2 = (float)(p1 * Calib->dig_P3 / (6250.0 * 36028797018963968.0));
+
+    /* Pa = q + P8 q / 2^19 + P9 q^2 / 2^35 + P7 / 16, then to hPa */
+    Comp->C0 = (float)(Calib->dig_P7 / 16.0 / 100.0);
+    Comp->C1 = (float)((1.0 + Calib->dig_P8 / 524288.0) / 100.0);
+    Comp->C2 = (float)(Calib->dig_P9 / 34359738368.0 / 100.0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Fine temperature (from BMP280 datasheet)                               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32_t FSWV1_BMP280_TFine(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT)
+{
+    const FSWV1_BMP280_Calib_t *cal = &Comp->Calib;
+    int32_t var1, var2;
+
+    var1 = ((((AdcT >> 3) - ((int32_t)cal->dig_T1 << 1))) *
+            ((int32_t)cal->dig_T2)) >> 11;
+
+    var2 = (((((AdcT >> 4) - ((int32_t)cal->dig_T1)) *
+             ((AdcT >> 4) - ((int32_t)cal->dig_T1))) >> 12) *
+            ((int32_t)cal->dig_T3)) >> 14;
+
+    return var1 + var2;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Integer compensation (from BMP280 datasheet)                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP280_CompensateInt(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT, int32_t AdcP,
+                                int32_t *Temp, uint32_t *Press)
+{
+    const FSWV1_BMP280_Calib_t *cal = &Comp->Calib;
+    int32_t t_fine;
+    int64_t var1, var2, p;
+
+    t_fine = FSWV1_BMP280_TFine(Comp, AdcT);
+    *Temp = (t_fine * 5 + 128) >> 8;
+
+    var1 = ((int64_t)t_fine) - 128000;
+    var2 = var1 * var1 * (int64_t)cal->dig_P6;
+    var2 = var2 + ((var1 * (int64_t)cal->dig_P5) << 17);
+    var2 = var2 + (((int64_t)cal->dig_P4) << 35);
+    var1 = ((var1 * var1 * (int64_t)cal->dig_P3) >> 8) +
+           ((var1 * (int64_t)cal->dig_P2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)cal->dig_P1) >> 33;
+
+    if (var1 == 0)
+    {
+        *Press = 0; /* Avoid division by zero */
+        return;
+    }
+
+    p = 1048576 - AdcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)cal->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)cal->dig_P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)cal->dig_P7) << 4);
+
+    *Press = (uint32_t)p;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Float compensation with precomputed coefficients                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP280_CompensateFloat(const FSWV1_BMP280_Comp_t *Comp, int32_t AdcT, int32_t AdcP,
+                                  float *TempC, float *PressHpa)
+{
+    int32_t t_fine;
+    float v, offset, divisor, q;
+
+    t_fine = FSWV1_BMP280_TFine(Comp, AdcT);
+    *TempC = ((t_fine * 5 + 128) >> 8) / 100.0f;
+
+    v = (float)(t_fine - 128000);
+    offset = Comp->A0 + v * (Comp->A1 + v * Comp->A2);
+    divisor = Comp->E0 + v * (Comp->E1 + v * Comp->E2);
+
+    if (divisor == 0.0f)
+    {
+        *PressHpa = 0.0f;
+        return;
+    }
+
+    q = ((float)(1048576 - AdcP) - offset) / divisor;
+    *PressHpa = Comp->C0 + q * (Comp->C1 + q * Comp->C2);
+}
@@ -0,0 +1,350 @@
+/******************************************************************************
+** File: fswv1_bmp3.c
+**
+** Purpose:
+**   This file contains the BMP388/BMP390 barometer driver for the FSWV1 app.
+**
+**   The sensor runs in normal mode and stores every temperature + pressure
+**   frame in its 512-byte FIFO. A read is one transaction: a burst sized
+**   for a watermark's worth of frames plus one, and the sensor time frame.
+**   The status and fill level are only read when that burst comes back
+**   empty or without the sensor time, i.e. when the FIFO held more. The
+**   watermark interrupt can drive FSWV1_DRDY_LINE so bursts are read as
+**   soon as they are ready.
+**
+**   The measurement profile maps onto the chip as:
+**     OsrsT/OsrsP  x1..x16 (osr_t/osr_p 0..4)
+**     Filter       IIR coefficient code, same codes (0 = off .. 4 = 15)
+**     Standby      output data rate 200 Hz / 2^code (odr_sel 0..7)
+**     Mode         normal only; there is nothing to buffer in forced mode
+**
+******************************************************************************/
+
+#include "fswv1_baro.h"
+
+/*
+** BMP388/BMP390 Register Definitions
+*/
+#define BMP3_REG_CHIP_ID       0x00
+#define BMP3_REG_ERR           0x02
+#define BMP3_REG_EVENT         0x10
+#define BMP3_REG_FIFO_DATA     0x14
+#define BMP3_REG_FIFO_WTM_0    0x15
+#define BMP3_REG_FIFO_WTM_1    0x16
+#define BMP3_REG_FIFO_CONFIG_1 0x17
+#define BMP3_REG_FIFO_CONFIG_2 0x18
+#define BMP3_REG_INT_CTRL      0x19
+#define BMP3_REG_PWR_CTRL      0x1B
+#define BMP3_REG_OSR           0x1C
+#define BMP3_REG_ODR           0x1D
+#define BMP3_REG_CONFIG        0x1F
+#define BMP3_REG_CALIB         0x31
+#define BMP3_REG_CMD           0x7E
+
+#define BMP3_CHIP_ID_BMP388    0x50
+#define BMP3_CHIP_ID_BMP390    0x60
+
+#define BMP3_ERR_FATAL         0x01
+#define BMP3_ERR_CONF          0x04
+#define BMP3_EVENT_POR         0x01   /* Power-on reset since the last read */
+
+#define BMP3_PWR_SLEEP         0x03   /* press_en | temp_en, sleep mode */
+#define BMP3_PWR_NORMAL        0x33   /* press_en | temp_en, normal mode */
+#define BMP3_FIFO_CONFIG_1     0x1D   /* fifo_mode | time_en | press_en | temp_en */
+#define BMP3_FIFO_FILTERED     0x08   /* data_select: IIR filtered frames */
+#define BMP3_CMD_FIFO_FLUSH    0xB0
+
+#define BMP3_STATUS_RUN_SIZE   4      /* EVENT, INT_STATUS, FIFO_LENGTH_0/1 */
+
+/* A rate group trigger must not leave the FIFO filling faster than it is read */
+CompileTimeAssert(FSWV1_DEFAULT_READ_RATE == 0 || FSWV1_DEFAULT_READ_RATE * FSWV1_BMP3_FIFO_LATENCY_MS >= 1000,
+                  BmpReadRateKeepsUpWithWatermark);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Apply the measurement profile                                           */
+/* Checked before anything is written: the conversion must fit in the    */
+/* output period. The sensor sleeps while it is configured, the FIFO is  */
+/* flushed, and normal mode is started in a second write once the        */
+/* settings are in.                                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP3_ApplyProfile(FSWV1_BaroDevice_t *Dev)
+{
+    const FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile = &Dev->Profile;
+    FSWV1_BMP3_State_t *s = &Dev->State.Bmp3;
+    uint8 pairs[20];
+    uint8 start[2] = {BMP3_REG_PWR_CTRL, BMP3_PWR_NORMAL};
+    uint32 osr_t;
+    uint32 osr_p;
+    uint32 odr;
+    uint32 meas_us;
+    uint32 period_us;
+    uint32 frames;
+    int32 status;
+
+    if (Profile->Mode != FSWV1_BMP_MODE_NORMAL)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    osr_t = Profile->OsrsT - 1;
+    osr_p = Profile->OsrsP - 1;
+    odr = Profile->Standby;
+
+    /* Conversion time (datasheet 3.9.2): 234 + 392 + 2020 * 2^osr_p + 163 + 2020 * 2^osr_t us */
+    meas_us = 234 + 392 + (2020u << osr_p) + 163 + (2020u << osr_t);
+    period_us = 5000u << odr;
+    if (meas_us > period_us)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    /* Watermark: FSWV1_BMP3_FIFO_LATENCY_MS of frames, at least one */
+    frames = (FSWV1_BMP3_FIFO_LATENCY_MS * 1000) / period_us;
+    if (frames < 1)
+    {
+        frames = 1;
+    }
+    if (frames > FSWV1_BMP3_FIFO_WTM_MAX_FRAMES)
+    {
+        frames = FSWV1_BMP3_FIFO_WTM_MAX_FRAMES;
+    }
+
+    pairs[0] = BMP3_REG_PWR_CTRL;
+    pairs[1] = BMP3_PWR_SLEEP;
+    pairs[2] = BMP3_REG_OSR;
+    pairs[3] = (uint8)((osr_t << 3) | osr_p);
+    pairs[4] = BMP3_REG_ODR;
+    pairs[5] = (uint8)odr;
+    pairs[6] = BMP3_REG_CONFIG;
+    pairs[7] = (uint8)(Profile->Filter << 1);
+    pairs[8] = BMP3_REG_FIFO_WTM_0;
+    pairs[9] = (uint8)((frames * FSWV1_BMP3_FRAME_SIZE) & 0xFF);
+    pairs[10] = BMP3_REG_FIFO_WTM_1;
+    pairs[11] = (uint8)((frames * FSWV1_BMP3_FRAME_SIZE) >> 8);
+    pairs[12] = BMP3_REG_FIFO_CONFIG_1;
+    pairs[13] = BMP3_FIFO_CONFIG_1;
+    pairs[14] = BMP3_REG_FIFO_CONFIG_2;
+    pairs[15] = BMP3_FIFO_FILTERED;
+    pairs[16] = BMP3_REG_INT_CTRL;
+    pairs[17] = FSWV1_BMP3_INT_CTRL_FWTM;
+    pairs[18] = BMP3_REG_CMD;
+    pairs[19] = BMP3_CMD_FIFO_FLUSH;
+
+    status = FSWV1_Baro_WriteRegs(Dev, pairs, 10);
+    if (status == CFE_SUCCESS)
+    {
+        status = FSWV1_Baro_WriteRegs(Dev, start, 1);
+    }
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    s->WatermarkBytes = (uint16)(frames * FSWV1_BMP3_FRAME_SIZE);
+    FSWV1_BMP3_ClockInit(&s->Clock, FSWV1_BMP3_ODR_BASE_TICKS << odr);
+    Dev->MeasTimeUs = meas_us;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Identify the chip, load its calibration and apply the profile          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP3_Probe(FSWV1_BaroDevice_t *Dev)
+{
+    uint8 chip_id = 0;
+    uint8 calib[FSWV1_BMP3_CALIB_SIZE];
+    FSWV1_RegRun_t id_calib[2] = {
+        {BMP3_REG_CHIP_ID, 1, &chip_id},
+        {BMP3_REG_CALIB, FSWV1_BMP3_CALIB_SIZE, calib}
+    };
+    int32 status;
+
+    /*
+    ** Read chip ID and calibration data in one transaction
+    */
+    status = FSWV1_Baro_ReadRegRuns(Dev, id_calib, 2, NULL, 0);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    if (chip_id == BMP3_CHIP_ID_BMP388)
+    {
+        Dev->Chip = FSWV1_BMP_CHIP_BMP388;
+    }
+    else if (chip_id == BMP3_CHIP_ID_BMP390)
+    {
+        Dev->Chip = FSWV1_BMP_CHIP_BMP390;
+    }
+    else
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    FSWV1_BMP3_ParseCalib(calib, &Dev->State.Bmp3.Calib);
+
+    return BMP3_ApplyProfile(Dev);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read the error flags, events and FIFO fill in one transaction          */
+/* A reset or configuration error re-applies the profile and fails.       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP3_ReadStatus(FSWV1_BaroDevice_t *Dev, uint32 *FifoLength)
+{
+    uint8 err = 0;
+    uint8 regs[BMP3_STATUS_RUN_SIZE];
+    FSWV1_RegRun_t runs[2] = {
+        {BMP3_REG_ERR, 1, &err},
+        {BMP3_REG_EVENT, BMP3_STATUS_RUN_SIZE, regs}
+    };
+    int32 status;
+
+    status = FSWV1_Baro_ReadRegRuns(Dev, runs, 2, NULL, 0);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    if ((regs[0] & BMP3_EVENT_POR) || (err & (BMP3_ERR_FATAL | BMP3_ERR_CONF)))
+    {
+        BMP3_ApplyProfile(Dev);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    *FifoLength = (uint32)regs[2] | ((uint32)(regs[3] & 0x01) << 8);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read the FIFO                                                           */
+/* One burst of the watermark plus one frame: a FIFO holding fewer frames */
+/* returns them, the sensor time and empty frames, so an early read      */
+/* costs nothing extra. A burst without the sensor time left frames      */
+/* behind; the fill level is read and the rest drained. A burst with no  */
+/* frames checks the status and returns OS_ERROR. A reset or            */
+/* configuration error re-applies the profile and counts as a failed    */
+/* read.                                                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 BMP3_Read(FSWV1_BaroDevice_t *Dev, FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count)
+{
+    FSWV1_BMP3_State_t *s = &Dev->State.Bmp3;
+    uint8 buf[FSWV1_BMP3_FIFO_READ_MAX];
+    FSWV1_BMP3_Frame_t frames[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    uint64_t frame_ns[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    FSWV1_BMP3_FifoResult_t result;
+    uint32 length;
+    uint32 offset;
+    uint32 n;
+    uint32 i;
+    uint64 read_ns;
+    int32 status;
+
+    *Count = 0;
+
+    length = s->WatermarkBytes + FSWV1_BMP3_FRAME_SIZE + FSWV1_BMP3_TIME_FRAME_SIZE;
+
+    read_ns = FSWV1_Time_MonoNs();
+    status = FSWV1_Baro_ReadReg(Dev, BMP3_REG_FIFO_DATA, buf, (uint16)length);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    n = FSWV1_BMP3_DecodeFifo(buf, length, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &result);
+    if (result.Invalid || result.ConfigErrors > 0)
+    {
+        BMP3_ApplyProfile(Dev);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (n == 0 || !result.TimeValid)
+    {
+        status = BMP3_ReadStatus(Dev, &length);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+
+        if (n == 0)
+        {
+            Dev->NotReady++;
+            return OS_ERROR;
+        }
+
+        /*
+        ** Behind: drain the rest over the cut-off frame, which is re-read
+        */
+        offset = result.Consumed;
+        if (offset + length + FSWV1_BMP3_FRAME_SIZE > FSWV1_BMP3_FIFO_SIZE)
+        {
+            Dev->FifoFull++;   /* Oldest frames were overwritten */
+        }
+
+        length += FSWV1_BMP3_TIME_FRAME_SIZE;
+        if (offset + length > FSWV1_BMP3_FIFO_READ_MAX)
+        {
+            length = FSWV1_BMP3_FIFO_READ_MAX - offset;
+        }
+
+        read_ns = FSWV1_Time_MonoNs();
+        status = FSWV1_Baro_ReadReg(Dev, BMP3_REG_FIFO_DATA, &buf[offset], (uint16)length);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+
+        n += FSWV1_BMP3_DecodeFifo(&buf[offset], length, &frames[n], FSWV1_BMP3_FIFO_MAX_FRAMES - n, &result);
+        if (result.Invalid || result.ConfigErrors > 0)
+        {
+            BMP3_ApplyProfile(Dev);
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+    }
+
+    FSWV1_BMP3_ClockStamp(&s->Clock, n, read_ns, result.TimeValid, result.SensorTime, frame_ns);
+
+    /* Keep the newest if the caller has less room than the FIFO held */
+    i = (n > MaxSamples) ? n - MaxSamples : 0;
+    for (; i < n; i++)
+    {
+        FSWV1_BMP3_Compensate(&s->Calib, frames[i].AdcT, frames[i].AdcP,
+                              &Samples[*Count].Temperature, &Samples[*Count].Pressure);
+        Samples[*Count].ArrivalNs = frame_ns[i];
+        Samples[*Count].Timestamp = FSWV1_Time_MonoToTime(frame_ns[i]);
+        Samples[*Count].Instance = Dev->Instance;
+        (*Count)++;
+    }
+
+    if (*Count == 0)
+    {
+        Dev->NotReady++;
+        return OS_ERROR;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Driver
+*/
+const FSWV1_BaroDriver_t FSWV1_BMP3_Driver = {
+    "BMP388/BMP390",
+    BMP3_REG_CHIP_ID,
+    { BMP3_CHIP_ID_BMP388, BMP3_CHIP_ID_BMP390 },
+    { FSWV1_BMP_CHIP_BMP388, FSWV1_BMP_CHIP_BMP390 },
+    true,
+    BMP3_Probe,
+    BMP3_ApplyProfile,
+    BMP3_Read
+};
@@ -0,0 +1,278 @@
+/******************************************************************************
+** File: fswv1_bmp3_fifo.c
+**
+** Purpose:
+**   This file contains the BMP388/BMP390 FIFO decoding, compensation and
+**   frame timing for the FSWV1 app.
+**
+** Notes:
+**   The datasheet compensation sums eleven products of powers of t_lin and
+**   the pressure reading. Grouped by powers of the pressure reading it is
+**   three cubics/linears in t_lin, evaluated here in Horner form: the
+**   same terms with fewer multiplies.
+**
+**   Frame timing cannot come from the FIFO alone: a burst only says how
+**   many frames arrived since the last one. The output period is the
+**   nominal period in sensor time ticks times the measured tick length,
+**   which follows the sensor oscillator's drift. Successive bursts are
+**   then laid end to end, and the newest frame is kept between one period
+**   before the read and the read itself. When frames were lost the chain
+**   jumps forward; when the estimate ran ahead the burst is spread evenly
+**   back to the previous burst, so frame times never go backwards.
+**
+******************************************************************************/
+
+#include "fswv1_bmp3_fifo.h"
+
+/*
+** Shortest sensor time span used to measure the tick (100 ms), and the
+** largest accepted deviation from the nominal tick (the oscillator is
+** specified to a few percent)
+*/
+#define BMP3_CLOCK_MIN_TICKS   2560u
+#define BMP3_CLOCK_MAX_DEV_PS  (FSWV1_BMP3_TICK_PS / 10)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Scale the calibration block (datasheet 9.1, little-endian from 0x31)   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP3_ParseCalib(const uint8_t Raw[FSWV1_BMP3_CALIB_SIZE], FSWV1_BMP3_Calib_t *Calib)
+{
+    uint16_t t1 = (uint16_t)((Raw[1] << 8) | Raw[0]);
+    uint16_t t2 = (uint16_t)((Raw[3] << 8) | Raw[2]);
+    int8_t   t3 = (int8_t)Raw[4];
+    int16_t  p1 = (int16_t)((Raw[6] << 8) | Raw[5]);
+    int16_t  p2 = (int16_t)((Raw[8] << 8) | Raw[7]);
+    int8_t   p3 = (int8_t)Raw[9];
+    int8_t   p4 = (int8_t)Raw[10];
+    uint16_t p5 = (uint16_t)((Raw[12] << 8) | Raw[11]);
+    uint16_t p6 = (uint16_t)((Raw[14] << 8) | Raw[13]);
+    int8_t   p7 = (int8_t)Raw[15];
+    int8_t   p8 = (int8_t)Raw[16];
+    int16_t  p9 = (int16_t)((Raw[18] << 8) | Raw[17]);
+    int8_t   p10 = (int8_t)Raw[19];
+    int8_t   p11 = (int8_t)Raw[20];
+
+    Calib->T1 = t1 * 256.0;                                  /* 2^-8 */
+    Calib->T2 = t2 / 1073741824.0;                           /* 2^30 */
+    Calib->T3 = t3 / 281474976710656.0;                      /* 2^48 */
+    Calib->P1 = (p1 - 16384) / 1048576.0;                    /* 2^14, 2^20 */
+    Calib->P2 = (p2 - 16384) / 536870912.0;                  /* 2^14, 2^29 */
+    Calib->P3 = p3 / 4294967296.0;                           /* 2^32 */
+    Calib->P4 = p4 / 137438953472.0;                         /* 2^37 */
+    Calib->P5 = p5 * 8.0;                                    /* 2^-3 */
+    Calib->P6 = p6 / 64.0;                                   /* 2^6 */
+    Calib->P7 = p7 / 256.0;                                  /* 2^8 */
+    Calib->P8 = p8 / 32768.0;                                /* 2^15 */
+    Calib->P9 = p9 / 281474976710656.0;                      /* 2^48 */
+    Calib->P10 = p10 / 281474976710656.0;                    /* 2^48 */
+    Calib->P11 = p11 / 36893488147419103232.0;               /* 2^65 */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Compensate one frame (datasheet 9.2, regrouped)                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP3_Compensate(const FSWV1_BMP3_Calib_t *Calib, uint32_t AdcT, uint32_t AdcP,
+                           float *TempC, float *PressHpa)
+{
+    double d = (double)AdcT - Calib->T1;
+    double t = d * Calib->T2 + d * d * Calib->T3;    /* t_lin, degC */
+    double p = (double)AdcP;
+    double offset;
+    double sens;
+    double square;
+
+    offset = Calib->P5 + t * (Calib->P6 + t * (Calib->P7 + t * Calib->P8));
+    sens = Calib->P1 + t * (Calib->P2 + t * (Calib->P3 + t * Calib->P4));
+    square = Calib->P9 + t * Calib->P10 + p * Calib->P11;
+
+    *TempC = (float)t;
+    *PressHpa = (float)((offset + p * (sens + p * square)) / 100.0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Little-endian 24-bit field                                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint32_t BMP3_Get24(const uint8_t *b)
+{
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Decode a FIFO burst                                                     */
+/* Temperature comes before pressure in a frame (datasheet 3.6.3).        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t FSWV1_BMP3_DecodeFifo(const uint8_t *Buf, uint32_t Len, FSWV1_BMP3_Frame_t *Frames,
+                               uint32_t MaxFrames, FSWV1_BMP3_FifoResult_t *Result)
+{
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint32_t size;
+
+    Result->Partial = 0;
+    Result->ConfigChanges = 0;
+    Result->ConfigErrors = 0;
+    Result->Invalid = 0;
+    Result->TimeValid = 0;
+    Result->SensorTime = 0;
+
+    while (i < Len)
+    {
+        switch (Buf[i])
+        {
+            case FSWV1_BMP3_FH_TEMP_PRESS:
+                size = FSWV1_BMP3_FRAME_SIZE;
+                break;
+            case FSWV1_BMP3_FH_TEMP:
+            case FSWV1_BMP3_FH_PRESS:
+            case FSWV1_BMP3_FH_TIME:
+                size = 4;
+                break;
+            case FSWV1_BMP3_FH_CONFIG_ERROR:
+            case FSWV1_BMP3_FH_CONFIG_CHANGE:
+                size = 2;
+                break;
+            case FSWV1_BMP3_FH_EMPTY:
+                Result->Consumed = Len;   /* Read past the end of the FIFO */
+                return count;
+            default:
+                Result->Invalid = 1;
+                Result->Consumed = Len;
+                return count;
+        }
+
+        if (i + size > Len)
+        {
+            break;   /* Incomplete: the sensor sends it again on the next read */
+        }
+
+        switch (Buf[i])
+        {
+            case FSWV1_BMP3_FH_TEMP_PRESS:
+                if (count < MaxFrames)
+                {
+                    Frames[count].AdcT = BMP3_Get24(&Buf[i + 1]);
+                    Frames[count].AdcP = BMP3_Get24(&Buf[i + 4]);
+                    count++;
+                }
+                break;
+            case FSWV1_BMP3_FH_TIME:
+                Result->TimeValid = 1;
+                Result->SensorTime = BMP3_Get24(&Buf[i + 1]);
+                break;
+            case FSWV1_BMP3_FH_CONFIG_ERROR:
+                Result->ConfigErrors++;
+                break;
+            case FSWV1_BMP3_FH_CONFIG_CHANGE:
+                Result->ConfigChanges++;
+                break;
+            default:
+                Result->Partial++;
+                break;
+        }
+
+        i += size;
+    }
+
+    Result->Consumed = i;
+    return count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Start a frame clock                                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP3_ClockInit(FSWV1_BMP3_Clock_t *Clock, uint32_t PeriodTicks)
+{
+    if (Clock->TickPs == 0)
+    {
+        Clock->TickPs = FSWV1_BMP3_TICK_PS;
+    }
+
+    Clock->LastFrameNs = 0;
+    Clock->RefValid = 0;
+    Clock->PeriodTicks = PeriodTicks;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Time the frames of one burst                                            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_BMP3_ClockStamp(FSWV1_BMP3_Clock_t *Clock, uint32_t Count, uint64_t ReadNs,
+                           int TimeValid, uint32_t SensorTime, uint64_t *FrameNs)
+{
+    uint32_t ticks;
+    uint64_t tick_ps;
+    uint64_t period_ns;
+    uint64_t step_ns;
+    uint64_t last;
+    uint32_t i;
+
+    /*
+    ** Measure the tick over at least BMP3_CLOCK_MIN_TICKS, smoothed 1/8
+    */
+    if (TimeValid && Clock->RefValid)
+    {
+        ticks = (SensorTime - Clock->RefSensorTime) & FSWV1_BMP3_TIME_MASK;
+        if (ticks >= BMP3_CLOCK_MIN_TICKS && ReadNs > Clock->RefReadNs)
+        {
+            tick_ps = (ReadNs - Clock->RefReadNs) * 1000u / ticks;
+            if (tick_ps > FSWV1_BMP3_TICK_PS - BMP3_CLOCK_MAX_DEV_PS &&
+                tick_ps < FSWV1_BMP3_TICK_PS + BMP3_CLOCK_MAX_DEV_PS)
+            {
+                Clock->TickPs = (uint32_t)((int64_t)Clock->TickPs +
+                                           ((int64_t)tick_ps - (int64_t)Clock->TickPs) / 8);
+            }
+            Clock->RefSensorTime = SensorTime;
+            Clock->RefReadNs = ReadNs;
+        }
+    }
+    else if (TimeValid)
+    {
+        Clock->RefSensorTime = SensorTime;
+        Clock->RefReadNs = ReadNs;
+        Clock->RefValid = 1;
+    }
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    period_ns = (uint64_t)Clock->PeriodTicks * Clock->TickPs / 1000u;
+    step_ns = period_ns;
+
+    /*
+    ** Newest frame: one period after the last for every new frame, kept
+    ** within (ReadNs - period, ReadNs]
+    */
+    last = (Clock->LastFrameNs != 0) ? Clock->LastFrameNs + Count * period_ns : ReadNs;
+    if (last > ReadNs)
+    {
+        last = ReadNs;
+        if (Clock->LastFrameNs != 0 && last > Clock->LastFrameNs)
+        {
+            step_ns = (last - Clock->LastFrameNs) / Count;
+        }
+    }
+    else if (last + period_ns < ReadNs)
+    {
+        last = ReadNs - period_ns;
+    }
+
+    for (i = 0; i < Count; i++)
+    {
+        FrameNs[i] = last - (uint64_t)(Count - 1 - i) * step_ns;
+    }
+
+    Clock->LastFrameNs = last;
+}
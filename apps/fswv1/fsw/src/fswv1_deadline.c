@@ -0,0 +1,218 @@
+/******************************************************************************
+** File: fswv1_deadline.c
+**
+** Purpose:
+**   This file contains the cycle deadline monitor for the FSWV1 app.
+**   Every cycle the stages (sensor, IMU, UDP, telemetry UART) report how
+**   long they took; at the end of the cycle the execution time is compared
+**   with FSWV1_APP_CYCLE_DEADLINE_US. An overrun is charged to the slowest
+**   stage of that cycle.
+**
+**   After FSWV1_DEADLINE_DEGRADE_COUNT consecutive overruns the app enters
+**   degraded mode, in which optional work (console prints and ASCII
+**   telemetry formatting) is skipped. It returns to normal after
+**   FSWV1_DEADLINE_RECOVER_COUNT consecutive cycles meet the deadline.
+**
+** Notes:
+**   Mode change events are limited to one per FSWV1_DEADLINE_EVENT_MIN_MS.
+**   Changes inside that window are coalesced: they are counted, and when
+**   the window expires the mode the app is in then is reported, so ground
+**   always ends up seeing the current mode.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <string.h>
+
+/*
+** Static variables
+*/
+static uint64 Deadline_StageNs[FSWV1_APP_STAGE_COUNT];
+static uint32 Deadline_ConsecutiveMisses = 0;
+static uint32 Deadline_ConsecutiveMet = 0;
+static uint64 Deadline_LastEventNs = 0;
+static uint32 Deadline_SuppressedEvents = 0;
+static bool   Deadline_ReportedDegraded = false;   /* Mode in the last event sent */
+static bool   Deadline_EventPending = false;       /* A change waits for the window to expire */
+static uint8  Deadline_PendingCause = 0;
+static uint64 Deadline_PendingExecNs = 0;
+
+static const char *Deadline_StageNames[FSWV1_APP_STAGE_COUNT] = { "sensor", "IMU", "UDP", "UART" };
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Reset the monitor (counters, streaks and mode)                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Deadline_Reset(void)
+{
+    memset(&FSWV1_APP_Data.Deadline, 0, sizeof(FSWV1_APP_Data.Deadline));
+    memset(Deadline_StageNs, 0, sizeof(Deadline_StageNs));
+
+    Deadline_ConsecutiveMisses = 0;
+    Deadline_ConsecutiveMet = 0;
+    Deadline_LastEventNs = 0;
+    Deadline_SuppressedEvents = 0;
+    Deadline_ReportedDegraded = false;
+    Deadline_EventPending = false;
+    Deadline_PendingCause = 0;
+    Deadline_PendingExecNs = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Start of a cycle - clear the per-stage times                            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Deadline_BeginCycle(void)
+{
+    memset(Deadline_StageNs, 0, sizeof(Deadline_StageNs));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Record time spent in a stage during the current cycle                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Deadline_StageTime(uint8 Stage, uint64 DurationNs)
+{
+    if (Stage < FSWV1_APP_STAGE_COUNT)
+    {
+        Deadline_StageNs[Stage] += DurationNs;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Send a mode change event, or hold it until the rate limit window ends  */
+/* A held change is sent by DeadlineFlushEvent with the mode current at   */
+/* that time; Cause and ExecNs describe the latest entry to degraded.     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void DeadlineModeEvent(uint64 NowNs, uint8 Cause, uint64 ExecNs)
+{
+    if (FSWV1_APP_Data.Deadline.Degraded)
+    {
+        Deadline_PendingCause = Cause;
+        Deadline_PendingExecNs = ExecNs;
+    }
+
+    if (Deadline_LastEventNs != 0 &&
+        (NowNs - Deadline_LastEventNs) < (uint64)FSWV1_DEADLINE_EVENT_MIN_MS * 1000000ULL)
+    {
+        Deadline_SuppressedEvents++;
+        Deadline_EventPending = true;
+        return;
+    }
+
+    Deadline_EventPending = false;
+    Deadline_ReportedDegraded = FSWV1_APP_Data.Deadline.Degraded;
+    Cause = Deadline_PendingCause;
+    ExecNs = Deadline_PendingExecNs;
+
+    if (FSWV1_APP_Data.Deadline.Degraded)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_DEADLINE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1: Degraded mode after %u overruns (last %u us, slowest stage %s), %u events suppressed",
+                         (unsigned int)FSWV1_DEADLINE_DEGRADE_COUNT, (unsigned int)(ExecNs / 1000),
+                         Deadline_StageNames[Cause], (unsigned int)Deadline_SuppressedEvents);
+    }
+    else
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_DEADLINE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1: Normal mode after %u cycles within deadline, %u events suppressed",
+                         (unsigned int)FSWV1_DEADLINE_RECOVER_COUNT, (unsigned int)Deadline_SuppressedEvents);
+    }
+
+    Deadline_LastEventNs = NowNs;
+    Deadline_SuppressedEvents = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Send a held mode change once the rate limit window has expired          */
+/* Nothing is sent if the mode went back to the one last reported; the   */
+/* suppressed changes are then counted in the next event.                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void DeadlineFlushEvent(uint64 NowNs)
+{
+    if (!Deadline_EventPending ||
+        (NowNs - Deadline_LastEventNs) < (uint64)FSWV1_DEADLINE_EVENT_MIN_MS * 1000000ULL)
+    {
+        return;
+    }
+
+    if (FSWV1_APP_Data.Deadline.Degraded == Deadline_ReportedDegraded)
+    {
+        Deadline_EventPending = false;
+        return;
+    }
+
+    DeadlineModeEvent(NowNs, Deadline_PendingCause, Deadline_PendingExecNs);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* End of a cycle - check the deadline and update the mode                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Deadline_EndCycle(uint64 ExecNs)
+{
+    FSWV1_DeadlineMonitor_t *mon = &FSWV1_APP_Data.Deadline;
+    uint8 cause = 0;
+    uint8 i;
+
+    if (ExecNs > mon->MaxExecNs)
+    {
+        mon->MaxExecNs = ExecNs;
+    }
+
+    if (Deadline_EventPending)
+    {
+        DeadlineFlushEvent(FSWV1_Sched_NowNs());
+    }
+
+    if (ExecNs <= (uint64)FSWV1_APP_CYCLE_DEADLINE_US * 1000)
+    {
+        Deadline_ConsecutiveMisses = 0;
+        Deadline_ConsecutiveMet++;
+
+        if (mon->Degraded && Deadline_ConsecutiveMet >= FSWV1_DEADLINE_RECOVER_COUNT)
+        {
+            mon->Degraded = false;
+            DeadlineModeEvent(FSWV1_Sched_NowNs(), 0, ExecNs);
+        }
+        return;
+    }
+
+    /* Overrun: charge it to the slowest stage */
+    for (i = 1; i < FSWV1_APP_STAGE_COUNT; i++)
+    {
+        if (Deadline_StageNs[i] > Deadline_StageNs[cause])
+        {
+            cause = i;
+        }
+    }
+
+    mon->Overruns[cause]++;
+    Deadline_ConsecutiveMet = 0;
+    Deadline_ConsecutiveMisses++;
+
+    if (!mon->Degraded && Deadline_ConsecutiveMisses >= FSWV1_DEADLINE_DEGRADE_COUNT)
+    {
+        mon->Degraded = true;
+        mon->DegradedEntries++;
+        DeadlineModeEvent(FSWV1_Sched_NowNs(), cause, ExecNs);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* True while optional work should be skipped                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool FSWV1_Deadline_Degraded(void)
+{
+    return FSWV1_APP_Data.Deadline.Degraded;
+}
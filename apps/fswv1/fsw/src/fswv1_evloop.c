@@ -0,0 +1,302 @@
+/******************************************************************************
+** File: fswv1_evloop.c
+**
+** Purpose:
+**   This file contains the epoll based event loop used when
+**   FSWV1_APP_WAKEUP_SOURCE is FSWV1_WAKEUP_SOURCE_EPOLL.
+**
+**   One epoll set waits on:
+**   - a timerfd that ticks at FSWV1_APP_CYCLE_RATE_HZ (starts each cycle)
+**   - the IMU UARTs (readable: frames are parsed into the IMU rings at once)
+**   - the telemetry UART (writable: queued telemetry is flushed; only
+**     armed while output is pending)
+**   - the data-ready GPIO line, if requested (an edge runs the data-ready
+**     rate group immediately, see FSWV1_APP_DataReady)
+**
+** Notes:
+**   The UDP telemetry socket is an OSAL socket, which does not expose its
+**   descriptor, and datagram sends do not block, so it is not part of the
+**   set. Software Bus pipes are not descriptors either; commands are
+**   drained by the main loop after every tick.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#define EVLOOP_MAX_EVENTS 8
+
+/*
+** Event tags stored in epoll_event.data.u32
+*/
+#define EVLOOP_TAG_TIMER     1
+#define EVLOOP_TAG_IMU_UART  2
+#define EVLOOP_TAG_TLM_UART  3
+#define EVLOOP_TAG_DRDY      4
+
+/*
+** Static variables
+*/
+static int epoll_fd = -1;
+static int timer_fd = -1;
+static uint32 imu_watched = 0;   /* IMU UARTs in the set */
+static int tlm_fd = -1;
+static bool tlm_out_armed = false;
+static int drdy_fd = -1;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Add or modify a descriptor in the epoll set                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int EventLoopCtl(int op, int fd, uint32 events, uint32 tag)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u32 = tag;
+
+    return epoll_ctl(epoll_fd, op, fd, &ev);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize the event loop                                               */
+/* Must run after the UARTs have been opened.                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_InitEventLoop(void)
+{
+    struct itimerspec its;
+    long period_ns;
+    uint8 i;
+    int fd;
+
+    if (FSWV1_APP_CYCLE_RATE_HZ == 0 || FSWV1_APP_CYCLE_RATE_HZ > FSWV1_APP_MAX_CYCLE_RATE_HZ)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: Invalid cycle rate %u Hz (max %u)",
+                         (unsigned int)FSWV1_APP_CYCLE_RATE_HZ, (unsigned int)FSWV1_APP_MAX_CYCLE_RATE_HZ);
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: epoll_create1 failed: %s", strerror(errno));
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    /*
+    ** Cycle timer
+    */
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: timerfd_create failed: %s", strerror(errno));
+        FSWV1_CloseEventLoop();
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    period_ns = 1000000000L / FSWV1_APP_CYCLE_RATE_HZ;
+    its.it_interval.tv_sec = period_ns / 1000000000L;
+    its.it_interval.tv_nsec = period_ns % 1000000000L;
+    its.it_value = its.it_interval;
+
+    if (timerfd_settime(timer_fd, 0, &its, NULL) < 0 ||
+        EventLoopCtl(EPOLL_CTL_ADD, timer_fd, EPOLLIN, EVLOOP_TAG_TIMER) < 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: Failed to arm cycle timer: %s", strerror(errno));
+        FSWV1_CloseEventLoop();
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    /*
+    ** IMU UART input, every instance that opened (any one being readable
+    ** services them all, see FSWV1_ServiceUART)
+    */
+    imu_watched = 0;
+    for (i = 0; i < FSWV1_IMU_MAX_INSTANCES; i++)
+    {
+        fd = FSWV1_GetUARTFd(i);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        if (EventLoopCtl(EPOLL_CTL_ADD, fd, EPOLLIN, EVLOOP_TAG_IMU_UART) < 0)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_EVLOOP: Failed to watch IMU UART %u: %s", (unsigned int)i, strerror(errno));
+            continue;
+        }
+        imu_watched++;
+    }
+
+    /*
+    ** Telemetry UART output (registered idle; EPOLLOUT armed on demand)
+    */
+    tlm_fd = FSWV1_GetTelemetryUARTFd();
+    tlm_out_armed = false;
+    if (tlm_fd >= 0 && EventLoopCtl(EPOLL_CTL_ADD, tlm_fd, 0, EVLOOP_TAG_TLM_UART) < 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: Failed to watch telemetry UART: %s", strerror(errno));
+        tlm_fd = -1;
+    }
+
+    /*
+    ** Data-ready line (edge events are queued by the kernel, so level-style
+    ** EPOLLIN fires until they are read)
+    */
+    drdy_fd = FSWV1_GetDataReadyFd();
+    if (drdy_fd >= 0 && EventLoopCtl(EPOLL_CTL_ADD, drdy_fd, EPOLLIN, EVLOOP_TAG_DRDY) < 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_EVLOOP: Failed to watch data-ready line: %s", strerror(errno));
+        drdy_fd = -1;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_SCHED_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_EVLOOP: Event loop at %u Hz (IMU UARTs %u watched, TLM UART %s, DRDY %s)",
+                     (unsigned int)FSWV1_APP_CYCLE_RATE_HZ,
+                     (unsigned int)imu_watched,
+                     tlm_fd >= 0 ? "watched" : "absent",
+                     drdy_fd >= 0 ? "watched" : "absent");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Arm EPOLLOUT on the telemetry UART only while output is queued          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void EventLoopUpdateTlmInterest(void)
+{
+    bool want_out;
+
+    if (tlm_fd < 0)
+    {
+        return;
+    }
+
+    want_out = (FSWV1_TelemetryUARTPending() > 0);
+    if (want_out != tlm_out_armed)
+    {
+        if (EventLoopCtl(EPOLL_CTL_MOD, tlm_fd, want_out ? EPOLLOUT : 0, EVLOOP_TAG_TLM_UART) == 0)
+        {
+            tlm_out_armed = want_out;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Wait for the next cycle tick, servicing I/O as it becomes ready        */
+/* Returns CFE_SUCCESS on a tick, CFE_SB_TIME_OUT if nothing happened     */
+/* within FSWV1_APP_WAKEUP_TIMEOUT_MS.                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_EventLoopWait(uint32 *MissedCycles)
+{
+    struct epoll_event events[EVLOOP_MAX_EVENTS];
+    uint64 expirations;
+    bool tick = false;
+    int n;
+    int i;
+
+    *MissedCycles = 0;
+
+    if (epoll_fd < 0)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    while (!tick)
+    {
+        /* Telemetry queued by the previous cycle needs EPOLLOUT */
+        EventLoopUpdateTlmInterest();
+
+        n = epoll_wait(epoll_fd, events, EVLOOP_MAX_EVENTS, FSWV1_APP_WAKEUP_TIMEOUT_MS);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+
+        if (n == 0)
+        {
+            return CFE_SB_TIME_OUT;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            switch (events[i].data.u32)
+            {
+                case EVLOOP_TAG_TIMER:
+                    if (read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations) &&
+                        expirations > 0)
+                    {
+                        *MissedCycles += (uint32)(expirations - 1);
+                        tick = true;
+                    }
+                    break;
+
+                case EVLOOP_TAG_IMU_UART:
+                    FSWV1_ServiceUART();
+                    break;
+
+                case EVLOOP_TAG_TLM_UART:
+                    FSWV1_FlushTelemetryUART();
+                    break;
+
+                case EVLOOP_TAG_DRDY:
+                    FSWV1_APP_DataReady();
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Close the event loop (cleanup)                                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_CloseEventLoop(void)
+{
+    /* The UART descriptors belong to their own modules */
+    imu_watched = 0;
+    tlm_fd = -1;
+    tlm_out_armed = false;
+    drdy_fd = -1;
+
+    if (timer_fd >= 0)
+    {
+        close(timer_fd);
+        timer_fd = -1;
+    }
+
+    if (epoll_fd >= 0)
+    {
+        close(epoll_fd);
+        epoll_fd = -1;
+    }
+}
@@ -2,7 +2,8 @@
 ** File: fswv1_gpio.c
 **
 ** Purpose:
-**   This file contains GPIO functions for LED control on Raspberry Pi 5.
+**   This file contains GPIO functions for LED control on Raspberry Pi 5,
+**   and the data-ready (DRDY) input that triggers sensor acquisition.
 **   Uses libgpiod v2.x API properly.
 **
 ** Requirements:
@@ -14,6 +15,7 @@
 #include <gpiod.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 
 /*
 ** GPIO Configuration
@@ -30,6 +32,17 @@ static struct gpiod_chip *chip = NULL;
 static struct gpiod_line_request *request = NULL;
 static unsigned int offset = LED_GPIO_PIN;
 
+/*
+** Data-ready input (separate request; may be on another chip, e.g. gpio-sim)
+*/
+static struct gpiod_chip *drdy_chip = NULL;
+static struct gpiod_line_request *drdy_request = NULL;
+static struct gpiod_edge_event_buffer *drdy_events = NULL;
+static bool drdy_seq_valid = false;
+static unsigned long drdy_last_seqno = 0;
+static uint32 drdy_edges = 0;    /* Edges seen (from the kernel sequence numbers) */
+static uint32 drdy_missed = 0;   /* Edges that did not get their own acquisition */
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
 /* Initialize GPIO for LED control using libgpiod v2.x                    */
@@ -281,3 +294,184 @@ void FSWV1_CloseGPIO(void)
     
     OS_printf("FSWV1_GPIO: GPIO cleanup complete\n");
 }
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Request the data-ready input line with edge detection                  */
+/* Edges are timestamped by the kernel on CLOCK_MONOTONIC, the clock of   */
+/* FSWV1_Time_MonoNs.                                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_InitDataReady(void)
+{
+    struct gpiod_line_settings *settings = NULL;
+    struct gpiod_line_config *config = NULL;
+    struct gpiod_request_config *req_cfg = NULL;
+    unsigned int line = FSWV1_DRDY_LINE;
+    int ret = -1;
+
+    if (drdy_request)
+    {
+        return CFE_SUCCESS;
+    }
+
+    drdy_chip = gpiod_chip_open(FSWV1_DRDY_CHIP_PATH);
+    if (!drdy_chip)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_DRDY_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_GPIO: Failed to open DRDY chip %s: %s",
+                         FSWV1_DRDY_CHIP_PATH, strerror(errno));
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    settings = gpiod_line_settings_new();
+    config = gpiod_line_config_new();
+    req_cfg = gpiod_request_config_new();
+    drdy_events = gpiod_edge_event_buffer_new(FSWV1_DRDY_EVENT_BUFFER);
+
+    if (settings && config && req_cfg && drdy_events)
+    {
+        /* Input, one edge, kernel timestamps on the monotonic clock */
+        gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+        gpiod_line_settings_set_edge_detection(settings, FSWV1_DRDY_FALLING_EDGE ?
+                                               GPIOD_LINE_EDGE_FALLING : GPIOD_LINE_EDGE_RISING);
+        gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC);
+        gpiod_line_settings_set_debounce_period_us(settings, FSWV1_DRDY_DEBOUNCE_US);
+
+        ret = gpiod_line_config_add_line_settings(config, &line, 1, settings);
+        if (ret == 0)
+        {
+            gpiod_request_config_set_consumer(req_cfg, "fswv1_drdy");
+            gpiod_request_config_set_event_buffer_size(req_cfg, FSWV1_DRDY_EVENT_BUFFER);
+            drdy_request = gpiod_chip_request_lines(drdy_chip, req_cfg, config);
+        }
+    }
+
+    /* Clean up temporary objects */
+    if (req_cfg)
+    {
+        gpiod_request_config_free(req_cfg);
+    }
+    if (config)
+    {
+        gpiod_line_config_free(config);
+    }
+    if (settings)
+    {
+        gpiod_line_settings_free(settings);
+    }
+
+    if (!drdy_request)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_DRDY_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_GPIO: Failed to request DRDY line %u on %s: %s",
+                         line, FSWV1_DRDY_CHIP_PATH, strerror(errno));
+        FSWV1_CloseDataReady();
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    drdy_seq_valid = false;
+
+    CFE_EVS_SendEvent(FSWV1_APP_DRDY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_GPIO: DRDY on %s line %u (%s edge) triggers rate group %u",
+                     FSWV1_DRDY_CHIP_PATH, line, FSWV1_DRDY_FALLING_EDGE ? "falling" : "rising",
+                     (unsigned int)FSWV1_DRDY_RATE_GROUP);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Data-ready descriptor for the event loop (-1 if not requested)         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_GetDataReadyFd(void)
+{
+    return drdy_request ? gpiod_line_request_get_fd(drdy_request) : -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Take the data-ready edges queued since the last call (non-blocking)    */
+/* Returns CFE_SUCCESS with the newest edge's kernel timestamp, or        */
+/* OS_ERROR if no edge is waiting. Older edges in the batch, and any the  */
+/* kernel dropped (gaps in the sequence numbers), count as missed.        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_ReadDataReady(uint64 *EdgeNs)
+{
+    struct gpiod_edge_event *event;
+    unsigned long seqno;
+    uint32 edges;
+    int ret;
+
+    if (!drdy_request)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    ret = gpiod_line_request_wait_edge_events(drdy_request, 0);
+    if (ret <= 0)
+    {
+        return OS_ERROR;
+    }
+
+    ret = gpiod_line_request_read_edge_events(drdy_request, drdy_events, FSWV1_DRDY_EVENT_BUFFER);
+    if (ret <= 0)
+    {
+        return OS_ERROR;
+    }
+
+    event = gpiod_edge_event_buffer_get_event(drdy_events, (unsigned long)(ret - 1));
+    seqno = gpiod_edge_event_get_global_seqno(event);
+    *EdgeNs = gpiod_edge_event_get_timestamp_ns(event);
+
+    edges = drdy_seq_valid ? (uint32)(seqno - drdy_last_seqno) : (uint32)ret;
+    drdy_last_seqno = seqno;
+    drdy_seq_valid = true;
+
+    __atomic_store_n(&drdy_edges, drdy_edges + edges, __ATOMIC_RELAXED);
+    if (edges > 1)
+    {
+        __atomic_store_n(&drdy_missed, drdy_missed + edges - 1, __ATOMIC_RELAXED);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get data-ready statistics for housekeeping                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetDataReadyStats(uint32 *Edges, uint32 *Missed)
+{
+    *Edges = __atomic_load_n(&drdy_edges, __ATOMIC_RELAXED);
+    *Missed = __atomic_load_n(&drdy_missed, __ATOMIC_RELAXED);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Release the data-ready line (cleanup)                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_CloseDataReady(void)
+{
+    if (drdy_request)
+    {
+        gpiod_line_request_release(drdy_request);
+        drdy_request = NULL;
+    }
+
+    if (drdy_events)
+    {
+        gpiod_edge_event_buffer_free(drdy_events);
+        drdy_events = NULL;
+    }
+
+    if (drdy_chip)
+    {
+        gpiod_chip_close(drdy_chip);
+        drdy_chip = NULL;
+    }
+}
@@ -0,0 +1,597 @@
+/******************************************************************************
+** File: fswv1_imu_parse.c
+**
+** Purpose:
+**   This file contains the IMU frame parsers for the FSWV1 app: the ASCII
+**   parser, which replaces sscanf("$,%f,...,#") with a single pass over the
+**   frame that reports which field failed, and the COBS/CRC-16 binary
+**   frame codec.
+**
+** Notes:
+**   Numbers are converted with Clinger's fast path. When the decimal
+**   significand fits in 24 bits and the power of ten is at most 10^10,
+**   both are exact floats, so one IEEE float multiply or divide gives the
+**   correctly rounded result, the same one strtof() returns. Sensor output
+**   such as "-0.12" or "9.81" always takes this path. Anything else (long
+**   significands, large exponents, hex, inf, nan) goes to strtof_l() in the
+**   "C" locale, so results stay identical to strtof and independent of the
+**   process locale.
+**
+**   The fast path needs float operations evaluated in float precision
+**   (FLT_EVAL_METHOD == 0, true for ARM and x86-64 SSE) and must not be
+**   built with -ffast-math.
+**
+******************************************************************************/
+
+#define _GNU_SOURCE
+#include "fswv1_imu_parse.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+#include <float.h>
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define PARSE_FAST_PATH 1
+#else
+#define PARSE_FAST_PATH 0
+#endif
+
+#define PARSE_MAX_DIGITS     19               /* Significant digits that fit in uint64 */
+#define PARSE_MAX_EXACT_MANT (1ULL << 24)     /* Largest exact float significand */
+#define PARSE_MAX_EXACT_POW  10               /* 10^10 = 2^10 * 5^10, 5^10 < 2^24 */
+
+static const float Parse_Pow10[PARSE_MAX_EXACT_POW + 1] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/*
+** Binary INT16 scale factors, in field order
+*/
+static const float Parse_BinScale[FSWV1_IMU_PARSE_FIELDS] =
+{
+    FSWV1_IMU_BIN_ACCEL_SCALE, FSWV1_IMU_BIN_ACCEL_SCALE, FSWV1_IMU_BIN_ACCEL_SCALE,
+    FSWV1_IMU_BIN_GYRO_SCALE, FSWV1_IMU_BIN_GYRO_SCALE, FSWV1_IMU_BIN_GYRO_SCALE,
+    FSWV1_IMU_BIN_TEMP_SCALE
+};
+
+/*
+** CRC-16/CCITT-FALSE, one nibble at a time
+*/
+static const uint16_t Parse_Crc16Nibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*
+** "C" locale for the strtof_l fallback, created on first use
+*/
+static locale_t Parse_CLocale = (locale_t)0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Character classes (locale independent)                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool ParseIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static bool ParseIsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Slow path: strtof in the "C" locale                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool ParseFloatSlow(const char *Str, const char **End, float *Value)
+{
+    locale_t loc = __atomic_load_n(&Parse_CLocale, __ATOMIC_ACQUIRE);
+    locale_t expected = (locale_t)0;
+    char *end;
+
+    if (loc == (locale_t)0)
+    {
+        loc = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+        if (loc != (locale_t)0 &&
+            !__atomic_compare_exchange_n(&Parse_CLocale, &expected, loc, false,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            /* Another thread got there first */
+            freelocale(loc);
+            loc = expected;
+        }
+    }
+
+    if (loc != (locale_t)0)
+    {
+        *Value = strtof_l(Str, &end, loc);
+    }
+    else
+    {
+        *Value = strtof(Str, &end);
+    }
+
+    if (end == Str)
+    {
+        return false;
+    }
+
+    *End = end;
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Parse one number starting at Str (leading white space allowed)         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool ParseFloat(const char *Str, const char **End, float *Value)
+{
+#if PARSE_FAST_PATH
+    const char *p = Str;
+    const char *q;
+    uint64_t mant = 0;
+    int digits = 0;
+    int exp10 = 0;
+    int exp_val = 0;
+    bool exp_neg = false;
+    bool neg = false;
+    bool truncated = false;
+    unsigned int d;
+    float f;
+
+    while (ParseIsSpace(*p))
+    {
+        p++;
+    }
+
+    if (*p == '+' || *p == '-')
+    {
+        neg = (*p == '-');
+        p++;
+    }
+
+    /* inf, nan, hex and malformed input are left to strtof */
+    if (!(ParseIsDigit(*p) || (*p == '.' && ParseIsDigit(p[1]))) ||
+        (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')))
+    {
+        return ParseFloatSlow(Str, End, Value);
+    }
+
+    /* Integer part */
+    while (*p == '0')
+    {
+        p++;
+    }
+    for (; (d = (unsigned int)(*p - '0')) < 10; p++)
+    {
+        if (digits < PARSE_MAX_DIGITS)
+        {
+            mant = mant * 10 + d;
+            digits++;
+        }
+        else
+        {
+            exp10++;
+            truncated = true;
+        }
+    }
+
+    /* Fraction */
+    if (*p == '.')
+    {
+        p++;
+        if (mant == 0)
+        {
+            for (; *p == '0'; p++)
+            {
+                exp10--;
+            }
+        }
+        for (; (d = (unsigned int)(*p - '0')) < 10; p++)
+        {
+            if (digits < PARSE_MAX_DIGITS)
+            {
+                mant = mant * 10 + d;
+                digits++;
+                exp10--;
+            }
+            else
+            {
+                truncated = true;
+            }
+        }
+    }
+
+    /* Exponent (only consumed if at least one digit follows) */
+    if (*p == 'e' || *p == 'E')
+    {
+        q = p + 1;
+        if (*q == '+' || *q == '-')
+        {
+            exp_neg = (*q == '-');
+            q++;
+        }
+        if (ParseIsDigit(*q))
+        {
+            for (; ParseIsDigit(*q); q++)
+            {
+                if (exp_val < 100000)
+                {
+                    exp_val = exp_val * 10 + (*q - '0');
+                }
+            }
+            exp10 += exp_neg ? -exp_val : exp_val;
+            p = q;
+        }
+    }
+
+    if (mant == 0)
+    {
+        *Value = neg ? -0.0f : 0.0f;
+        *End = p;
+        return true;
+    }
+
+    /* Trailing zeros ("9.8100000") can often be folded into the exponent */
+    while (mant > PARSE_MAX_EXACT_MANT && (mant % 10) == 0)
+    {
+        mant /= 10;
+        exp10++;
+    }
+
+    if (truncated || mant > PARSE_MAX_EXACT_MANT ||
+        exp10 > PARSE_MAX_EXACT_POW || exp10 < -PARSE_MAX_EXACT_POW)
+    {
+        return ParseFloatSlow(Str, End, Value);
+    }
+
+    /* Both operands are exact, so this single operation rounds correctly */
+    f = (float)mant;
+    if (exp10 < 0)
+    {
+        f = f / Parse_Pow10[-exp10];
+    }
+    else
+    {
+        f = f * Parse_Pow10[exp10];
+    }
+
+    *Value = neg ? -f : f;
+    *End = p;
+    return true;
+#else
+    return ParseFloatSlow(Str, End, Value);
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Parse the seven fields of an IMU frame                                  */
+/* On success *Rest points just past the seventh number.                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int ParseFields(const char *Frame, float Values[FSWV1_IMU_PARSE_FIELDS], int *BadField,
+                       const char **Rest)
+{
+    const char *p = Frame;
+    const char *end = Frame;
+    int i;
+
+    if (p[0] != '$' || p[1] != ',')
+    {
+        return FSWV1_IMU_PARSE_BAD_START;
+    }
+    p += 2;
+
+    for (i = 0; i < FSWV1_IMU_PARSE_FIELDS; i++)
+    {
+        if (!ParseFloat(p, &end, &Values[i]))
+        {
+            break;
+        }
+
+        /*
+        ** sscanf also consumes an exponent marker with no digits ("1e,",
+        ** "1e+,"), which strtof leaves unread; the value is unchanged.
+        */
+        if (*end == 'e' || *end == 'E')
+        {
+            end++;
+            if (*end == '+' || *end == '-')
+            {
+                end++;
+            }
+        }
+
+        /* Every field but the last must be followed by ',' */
+        if (i < FSWV1_IMU_PARSE_FIELDS - 1 && *end != ',')
+        {
+            break;
+        }
+
+        p = end + 1;
+    }
+
+    if (i < FSWV1_IMU_PARSE_FIELDS)
+    {
+        if (BadField != NULL)
+        {
+            *BadField = i;
+        }
+        return FSWV1_IMU_PARSE_BAD_FIELD;
+    }
+
+    *Rest = end;
+    return FSWV1_IMU_PARSE_OK;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Parse one IMU frame                                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_IMU_ParseFrame(const char *Frame, float Values[FSWV1_IMU_PARSE_FIELDS], int *BadField)
+{
+    const char *rest;
+
+    return ParseFields(Frame, Values, BadField, &rest);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Parse one IMU frame and its optional sender counter                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_IMU_ParseFrameSeq(const char *Frame, float Values[FSWV1_IMU_PARSE_FIELDS], int *BadField,
+                            uint32_t *Seq, int *HasSeq)
+{
+    const char *rest;
+    const char *p;
+    uint32_t seq = 0;
+    int status;
+
+    *HasSeq = 0;
+
+    status = ParseFields(Frame, Values, BadField, &rest);
+    if (status != FSWV1_IMU_PARSE_OK || rest[0] != ',')
+    {
+        return status;
+    }
+
+    /* ",N,#" after the seventh field; anything else is ignored as before */
+    p = rest + 1;
+    if (!ParseIsDigit(*p))
+    {
+        return status;
+    }
+    while (ParseIsDigit(*p))
+    {
+        seq = seq * 10 + (uint32_t)(*p - '0');   /* Wraps modulo 2^32 */
+        p++;
+    }
+
+    if (p[0] == ',' && p[1] == '#')
+    {
+        *Seq = seq;
+        *HasSeq = 1;
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* CRC-16/CCITT-FALSE                                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t FSWV1_IMU_Crc16(const uint8_t *Data, size_t Length)
+{
+    uint16_t crc = 0xFFFF;
+    size_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ Parse_Crc16Nibble[(crc >> 12) ^ (Data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ Parse_Crc16Nibble[(crc >> 12) ^ (Data[i] & 0x0F)]);
+    }
+
+    return crc;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* COBS decode; returns the decoded length, or 0 if the input is invalid  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static size_t ParseCobsDecode(const uint8_t *In, size_t Length, uint8_t *Out, size_t MaxOut)
+{
+    size_t in = 0;
+    size_t out = 0;
+    uint8_t code;
+    uint8_t i;
+
+    while (in < Length)
+    {
+        code = In[in++];
+        if (code == 0)
+        {
+            return 0;
+        }
+
+        for (i = 1; i < code; i++)
+        {
+            if (in >= Length || In[in] == 0 || out >= MaxOut)
+            {
+                return 0;
+            }
+            Out[out++] = In[in++];
+        }
+
+        /* Each block except a full one (0xFF) or the last stands for a zero */
+        if (code != 0xFF && in < Length)
+        {
+            if (out >= MaxOut)
+            {
+                return 0;
+            }
+            Out[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* COBS encode and append the 0x00 delimiter; returns bytes written       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static size_t ParseCobsEncode(const uint8_t *In, size_t Length, uint8_t *Out)
+{
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    size_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        if (In[i] == 0)
+        {
+            Out[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+        else
+        {
+            Out[out++] = In[i];
+            code++;
+            if (code == 0xFF)
+            {
+                Out[code_pos] = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+
+    Out[code_pos] = code;
+    Out[out++] = 0;
+
+    return out;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Decode one binary frame                                                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_IMU_ParseBinary(const uint8_t *Encoded, size_t Length,
+                          float Values[FSWV1_IMU_PARSE_FIELDS], uint8_t *Seq)
+{
+    uint8_t pkt[FSWV1_IMU_BIN_MAX_DECODED];
+    size_t len;
+    const uint8_t *v;
+    uint32_t bits;
+    int16_t raw;
+    int i;
+
+    len = ParseCobsDecode(Encoded, Length, pkt, sizeof(pkt));
+    if (len == 0)
+    {
+        return FSWV1_IMU_PARSE_BAD_COBS;
+    }
+
+    if (len != FSWV1_IMU_BIN_FLOAT_LEN && len != FSWV1_IMU_BIN_INT16_LEN)
+    {
+        return FSWV1_IMU_PARSE_BAD_LENGTH;
+    }
+
+    if (FSWV1_IMU_Crc16(pkt, len - 2) != (uint16_t)(pkt[len - 2] | (pkt[len - 1] << 8)))
+    {
+        return FSWV1_IMU_PARSE_BAD_CRC;
+    }
+
+    v = &pkt[1];
+    for (i = 0; i < FSWV1_IMU_PARSE_FIELDS; i++)
+    {
+        if (len == FSWV1_IMU_BIN_FLOAT_LEN)
+        {
+            bits = (uint32_t)v[0] | ((uint32_t)v[1] << 8) | ((uint32_t)v[2] << 16) | ((uint32_t)v[3] << 24);
+            memcpy(&Values[i], &bits, sizeof(bits));
+            v += 4;
+        }
+        else
+        {
+            raw = (int16_t)(uint16_t)(v[0] | (v[1] << 8));
+            Values[i] = (float)raw / Parse_BinScale[i];
+            v += 2;
+        }
+    }
+
+    *Seq = pkt[0];
+
+    return FSWV1_IMU_PARSE_OK;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Build one binary frame                                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+size_t FSWV1_IMU_EncodeBinary(const float Values[FSWV1_IMU_PARSE_FIELDS], uint8_t Seq,
+                              int Int16, uint8_t *Out)
+{
+    uint8_t pkt[FSWV1_IMU_BIN_MAX_DECODED];
+    size_t len = 0;
+    uint32_t bits;
+    uint16_t crc;
+    float scaled;
+    int32_t raw;
+    int i;
+
+    pkt[len++] = Seq;
+
+    for (i = 0; i < FSWV1_IMU_PARSE_FIELDS; i++)
+    {
+        if (Int16)
+        {
+            scaled = Values[i] * Parse_BinScale[i];
+            if (!(scaled > -32768.0f))
+            {
+                raw = -32768;   /* Also catches NaN */
+            }
+            else if (scaled >= 32767.0f)
+            {
+                raw = 32767;
+            }
+            else
+            {
+                raw = (int32_t)(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+            }
+            pkt[len++] = (uint8_t)(raw & 0xFF);
+            pkt[len++] = (uint8_t)((raw >> 8) & 0xFF);
+        }
+        else
+        {
+            memcpy(&bits, &Values[i], sizeof(bits));
+            pkt[len++] = (uint8_t)(bits & 0xFF);
+            pkt[len++] = (uint8_t)((bits >> 8) & 0xFF);
+            pkt[len++] = (uint8_t)((bits >> 16) & 0xFF);
+            pkt[len++] = (uint8_t)((bits >> 24) & 0xFF);
+        }
+    }
+
+    crc = FSWV1_IMU_Crc16(pkt, len);
+    pkt[len++] = (uint8_t)(crc & 0xFF);
+    pkt[len++] = (uint8_t)(crc >> 8);
+
+    return ParseCobsEncode(pkt, len, Out);
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+** File: fswv1_imu_ring.c
+**
+** Purpose:
+**   This file contains the lock-free single-producer/single-consumer ring
+**   used to pass IMU samples from the IMU reader child task to the main task.
+**
+** Notes:
+**   Head and Tail are free-running counters; the slot index is the counter
+**   masked by FSWV1_IMU_RING_SIZE - 1. The producer publishes a sample with
+**   a release store of Head after the sample is written, and the consumer
+**   frees a slot with a release store of Tail after the sample is copied out.
+**   When the ring is full the newest sample is dropped and counted, so the
+**   producer never touches consumer-owned state.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <string.h>
+
+#if (FSWV1_IMU_RING_SIZE & (FSWV1_IMU_RING_SIZE - 1)) != 0
+#error "FSWV1_IMU_RING_SIZE must be a power of two"
+#endif
+
+#define FSWV1_IMU_RING_MASK (FSWV1_IMU_RING_SIZE - 1)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize ring (call before the producer starts)                       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_IMURing_Init(FSWV1_IMURing_t *Ring)
+{
+    memset(Ring, 0, sizeof(*Ring));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Push a sample (producer only)                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool FSWV1_IMURing_Push(FSWV1_IMURing_t *Ring, const FSWV1_IMUData_t *Sample)
+{
+    uint32 head = Ring->Head;
+    uint32 tail = __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE);
+    uint32 used = head - tail;
+
+    if (used >= FSWV1_IMU_RING_SIZE)
+    {
+        __atomic_store_n(&Ring->Overflows, Ring->Overflows + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    Ring->Samples[head & FSWV1_IMU_RING_MASK] = *Sample;
+    __atomic_store_n(&Ring->Head, head + 1, __ATOMIC_RELEASE);
+
+    if (used + 1 > Ring->HighWater)
+    {
+        __atomic_store_n(&Ring->HighWater, used + 1, __ATOMIC_RELAXED);
+    }
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Pop the oldest sample (consumer only)                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool FSWV1_IMURing_Pop(FSWV1_IMURing_t *Ring, FSWV1_IMUData_t *Sample)
+{
+    uint32 tail = Ring->Tail;
+    uint32 head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    *Sample = Ring->Samples[tail & FSWV1_IMU_RING_MASK];
+    __atomic_store_n(&Ring->Tail, tail + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Oldest sample without removing it, or NULL if empty (consumer only)    */
+/* The sample stays valid until the consumer pops it.                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const FSWV1_IMUData_t *FSWV1_IMURing_Peek(const FSWV1_IMURing_t *Ring)
+{
+    uint32 tail = Ring->Tail;
+    uint32 head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return NULL;
+    }
+
+    return &Ring->Samples[tail & FSWV1_IMU_RING_MASK];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Current occupancy (approximate when called from a third party)         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 FSWV1_IMURing_Count(const FSWV1_IMURing_t *Ring)
+{
+    uint32 head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+    uint32 tail = __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE);
+
+    return head - tail;
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+** File: fswv1_perf.c
+**
+** Purpose:
+**   This file contains the hot-path latency measurement for the FSWV1 app.
+**   Each probe keeps count, min, max, sum and a log2 histogram of durations
+**   measured with CLOCK_MONOTONIC. The statistics are published in the
+**   FSWV1_APP_PERF_TLM_MID packet alongside housekeeping.
+**
+** Notes:
+**   Recording is a clock read, a count-leading-zeros and a few adds, so it
+**   stays enabled in flight builds. Probes are only recorded from the main
+**   task; no locking is done.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <string.h>
+
+/*
+** Bucket b holds durations below 2^(b + PERF_BUCKET_SHIFT) ns
+*/
+#define PERF_BUCKET_SHIFT 10
+
+/*
+** Per-probe accumulator (nanoseconds)
+*/
+typedef struct
+{
+    uint32 Count;
+    uint64 SumNs;
+    uint64 MinNs;
+    uint64 MaxNs;
+    uint32 Buckets[FSWV1_APP_PERF_BUCKETS];
+} FSWV1_PerfProbeAcc_t;
+
+/*
+** Static variables
+*/
+static FSWV1_PerfProbeAcc_t Perf_Probes[FSWV1_APP_PERF_PROBE_COUNT];
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Record one duration                                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Perf_Record(uint8 Probe, uint64 DurationNs)
+{
+    FSWV1_PerfProbeAcc_t *acc;
+    uint64 scaled;
+    uint32 bucket;
+
+    if (Probe >= FSWV1_APP_PERF_PROBE_COUNT)
+    {
+        return;
+    }
+
+    acc = &Perf_Probes[Probe];
+
+    /* Bucket index = number of significant bits above the ~1 us unit */
+    scaled = DurationNs >> PERF_BUCKET_SHIFT;
+    bucket = (scaled == 0) ? 0 : (uint32)(64 - __builtin_clzll(scaled));
+    if (bucket >= FSWV1_APP_PERF_BUCKETS)
+    {
+        bucket = FSWV1_APP_PERF_BUCKETS - 1;
+    }
+
+    acc->Buckets[bucket]++;
+    acc->SumNs += DurationNs;
+
+    if (acc->Count == 0 || DurationNs < acc->MinNs)
+    {
+        acc->MinNs = DurationNs;
+    }
+    if (DurationNs > acc->MaxNs)
+    {
+        acc->MaxNs = DurationNs;
+    }
+
+    acc->Count++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Record the time elapsed since StartNs (from FSWV1_Sched_NowNs)         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Perf_Stop(uint8 Probe, uint64 StartNs)
+{
+    FSWV1_Perf_Record(Probe, FSWV1_Sched_NowNs() - StartNs);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Reset all probes                                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Perf_Reset(void)
+{
+    memset(Perf_Probes, 0, sizeof(Perf_Probes));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Convert nanoseconds to saturated microseconds                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 PerfNsToUs(uint64 Ns)
+{
+    uint64 us = Ns / 1000;
+
+    return (us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32)us;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Build and transmit the performance telemetry packet                    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Perf_SendTlm(void)
+{
+    const FSWV1_PerfProbeAcc_t *acc;
+    FSWV1_APP_PerfProbe_t *out;
+    uint32 target;
+    uint32 cumulative;
+    uint32 probe;
+    uint32 b;
+
+    for (probe = 0; probe < FSWV1_APP_PERF_PROBE_COUNT; probe++)
+    {
+        acc = &Perf_Probes[probe];
+        out = &FSWV1_APP_Data.PerfTlm.Payload.Probes[probe];
+
+        out->Count = acc->Count;
+        out->MinUs = PerfNsToUs(acc->MinNs);
+        out->MaxUs = PerfNsToUs(acc->MaxNs);
+        out->MeanUs = (acc->Count > 0) ? PerfNsToUs(acc->SumNs / acc->Count) : 0;
+        memcpy(out->Buckets, acc->Buckets, sizeof(out->Buckets));
+
+        /* p99: upper edge of the first bucket reaching 99% of samples */
+        out->P99Us = 0;
+        if (acc->Count > 0)
+        {
+            target = acc->Count - (acc->Count / 100);
+            cumulative = 0;
+            for (b = 0; b < FSWV1_APP_PERF_BUCKETS; b++)
+            {
+                cumulative += acc->Buckets[b];
+                if (cumulative >= target)
+                {
+                    break;
+                }
+            }
+
+            if (b >= FSWV1_APP_PERF_BUCKETS - 1)
+            {
+                out->P99Us = out->MaxUs;
+            }
+            else
+            {
+                out->P99Us = PerfNsToUs(1ULL << (b + PERF_BUCKET_SHIFT));
+                if (out->P99Us > out->MaxUs)
+                {
+                    out->P99Us = out->MaxUs;
+                }
+            }
+        }
+    }
+
+    FSWV1_Time_StampMsg(CFE_MSG_PTR(FSWV1_APP_Data.PerfTlm.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(FSWV1_APP_Data.PerfTlm.TelemetryHeader), true);
+}
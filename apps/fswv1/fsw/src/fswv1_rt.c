@@ -0,0 +1,444 @@
+/******************************************************************************
+** File: fswv1_rt.c
+**
+** Purpose:
+**   This file contains the real-time scheduling profile for the FSWV1 app.
+**
+**   FSWV1_RT_PROFILE_DEFAULT keeps whatever policy, priority and CPU set
+**   OSAL gave each task. FSWV1_RT_PROFILE_REALTIME moves the main task, the
+**   IMU reader task and the barometer bus tasks to SCHED_FIFO at
+**   FSWV1_RT_xxx_PRIORITY, pins them to FSWV1_RT_xxx_CPUMASK and prefaults
+**   their stacks. With FSWV1_RT_LOCK_PROCESS_MEMORY it also locks all
+**   memory (mlockall), turns off heap trimming and mmap allocations and
+**   prefaults the heap, so the cycle never takes a page fault. Those
+**   settings apply to the whole cFE process, not just this app, so they
+**   are off by default.
+**
+**   Every task registers itself with FSWV1_RT_RegisterTask() from its own
+**   context. The original settings are saved there, so switching back to
+**   the default profile (SET_RT_PROFILE_CC) restores them exactly.
+**
+**   Cycle periods are accumulated per profile, and RT_JITTER_REPORT_CC
+**   prints one event per profile so the two can be compared on target.
+**
+** Notes:
+**   SCHED_FIFO, affinity and mlockall need CAP_SYS_NICE / CAP_IPC_LOCK (or
+**   root). Failures are reported as events and are not fatal; the app keeps
+**   running with whatever could be applied.
+**
+******************************************************************************/
+
+#define _GNU_SOURCE
+#include "fswv1_app.h"
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+
+/*
+** Registered task (original OSAL settings are kept for the default profile)
+*/
+typedef struct
+{
+    char               Name[16];
+    bool               Registered;
+    pthread_t          Thread;
+    int                OrigPolicy;
+    struct sched_param OrigParam;
+    cpu_set_t          OrigCpus;
+} FSWV1_RTTask_t;
+
+/*
+** Cycle period accumulator for one profile
+*/
+typedef struct
+{
+    uint32 Count;
+    double SumNs;
+    double SumSqNs;
+    uint64 MinNs;
+    uint64 MaxNs;
+} FSWV1_RTJitter_t;
+
+/*
+** Static variables
+*/
+static FSWV1_RTTask_t RT_Tasks[FSWV1_RT_TASK_COUNT];
+static FSWV1_RTJitter_t RT_Jitter[FSWV1_RT_PROFILE_COUNT];
+static uint8 RT_Profile = FSWV1_RT_PROFILE_DEFAULT;
+static bool RT_MemoryLocked = false;
+
+static const char *RT_ProfileNames[FSWV1_RT_PROFILE_COUNT] = { "default", "realtime" };
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Real-time settings of a task (every barometer bus task shares one)     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int RTTaskPriority(uint8 Task)
+{
+    if (Task == FSWV1_RT_TASK_MAIN)
+    {
+        return FSWV1_RT_MAIN_PRIORITY;
+    }
+    if (Task == FSWV1_RT_TASK_IMU)
+    {
+        return FSWV1_RT_IMU_PRIORITY;
+    }
+    return FSWV1_RT_BMP_PRIORITY;
+}
+
+static uint32 RTTaskCpuMask(uint8 Task)
+{
+    if (Task == FSWV1_RT_TASK_MAIN)
+    {
+        return FSWV1_RT_MAIN_CPUMASK;
+    }
+    if (Task == FSWV1_RT_TASK_IMU)
+    {
+        return FSWV1_RT_IMU_CPUMASK;
+    }
+    return FSWV1_RT_BMP_CPUMASK;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Touch every page of the next FSWV1_RT_STACK_PREFAULT_BYTES of stack    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void __attribute__((noinline)) RTPrefaultStack(void)
+{
+    volatile uint8 buf[FSWV1_RT_STACK_PREFAULT_BYTES];
+    long page = sysconf(_SC_PAGESIZE);
+    size_t i;
+
+    if (page <= 0)
+    {
+        page = 4096;
+    }
+
+    for (i = 0; i < sizeof(buf); i += (size_t)page)
+    {
+        buf[i] = 0;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Lock memory and prefault the heap                                       */
+/* The heap is grown once, touched and released; with trimming and mmap    */
+/* disabled the pages stay in the process for later allocations.           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 RTLockMemory(void)
+{
+    uint8 *heap;
+
+    if (RT_MemoryLocked || !FSWV1_RT_LOCK_PROCESS_MEMORY)
+    {
+        return CFE_SUCCESS;
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_RT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_RT: mlockall failed: %s", strerror(errno));
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_RT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_RT: Memory locked and heap trimming/mmap disabled for the whole cFE process");
+
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    heap = malloc(FSWV1_RT_HEAP_PREFAULT_BYTES);
+    if (heap != NULL)
+    {
+        memset(heap, 0, FSWV1_RT_HEAP_PREFAULT_BYTES);
+        free(heap);
+    }
+
+    RT_MemoryLocked = true;
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Undo RTLockMemory (pages already faulted in stay resident)              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RTUnlockMemory(void)
+{
+    if (RT_MemoryLocked)
+    {
+        munlockall();
+        RT_MemoryLocked = false;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Apply the current profile to one registered task                        */
+/* Both settings are tried; returns the FSWV1_RT_FAILED_xxx that failed   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint8 RTApplyTask(uint8 Task)
+{
+    FSWV1_RTTask_t *t = &RT_Tasks[Task];
+    struct sched_param param;
+    cpu_set_t cpus;
+    uint8 failed = 0;
+    int policy;
+    int cpu;
+    int rc;
+
+    if (!t->Registered)
+    {
+        return 0;
+    }
+
+    if (RT_Profile == FSWV1_RT_PROFILE_REALTIME)
+    {
+        policy = SCHED_FIFO;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = RTTaskPriority(Task);
+
+        CPU_ZERO(&cpus);
+        for (cpu = 0; cpu < 32; cpu++)
+        {
+            if (RTTaskCpuMask(Task) & (1U << cpu))
+            {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+    }
+    else
+    {
+        policy = t->OrigPolicy;
+        param = t->OrigParam;
+        cpus = t->OrigCpus;
+    }
+
+    rc = pthread_setschedparam(t->Thread, policy, &param);
+    if (rc != 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_RT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_RT: %s task priority not applied: %s", t->Name, strerror(rc));
+        failed |= FSWV1_RT_FAILED_PRIORITY;
+    }
+
+    if (RT_Profile != FSWV1_RT_PROFILE_REALTIME || RTTaskCpuMask(Task) != 0)
+    {
+        rc = pthread_setaffinity_np(t->Thread, sizeof(cpus), &cpus);
+        if (rc != 0)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_RT_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_RT: %s task affinity not applied: %s", t->Name, strerror(rc));
+            failed |= FSWV1_RT_FAILED_AFFINITY;
+        }
+    }
+
+    return failed;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize the real-time profile (called from FSWV1_APP_Init)          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_RT_Init(void)
+{
+    uint8 i;
+
+    memset(RT_Tasks, 0, sizeof(RT_Tasks));
+    memset(RT_Jitter, 0, sizeof(RT_Jitter));
+    RT_Profile = FSWV1_RT_PROFILE;
+
+    snprintf(RT_Tasks[FSWV1_RT_TASK_MAIN].Name, sizeof(RT_Tasks[0].Name), "main");
+    snprintf(RT_Tasks[FSWV1_RT_TASK_IMU].Name, sizeof(RT_Tasks[0].Name), "IMU");
+    for (i = FSWV1_RT_TASK_BMP; i < FSWV1_RT_TASK_COUNT; i++)
+    {
+        snprintf(RT_Tasks[i].Name, sizeof(RT_Tasks[i].Name), "BMP bus %u", (unsigned int)(i - FSWV1_RT_TASK_BMP));
+    }
+
+    if (RT_Profile == FSWV1_RT_PROFILE_REALTIME)
+    {
+        RTLockMemory();
+    }
+
+    return FSWV1_RT_RegisterTask(FSWV1_RT_TASK_MAIN);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Register the calling task and apply the current profile to it          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_RT_RegisterTask(uint8 Task)
+{
+    FSWV1_RTTask_t *t;
+
+    if (Task >= FSWV1_RT_TASK_COUNT)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    t = &RT_Tasks[Task];
+    t->Thread = pthread_self();
+    pthread_getschedparam(t->Thread, &t->OrigPolicy, &t->OrigParam);
+    pthread_getaffinity_np(t->Thread, sizeof(t->OrigCpus), &t->OrigCpus);
+    __atomic_store_n(&t->Registered, true, __ATOMIC_RELEASE);
+
+    if (RT_Profile == FSWV1_RT_PROFILE_REALTIME)
+    {
+        RTPrefaultStack();
+    }
+
+    if (RTApplyTask(Task) != 0)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Forget a task that is about to exit                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_RT_UnregisterTask(uint8 Task)
+{
+    if (Task < FSWV1_RT_TASK_COUNT)
+    {
+        __atomic_store_n(&RT_Tasks[Task].Registered, false, __ATOMIC_RELEASE);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Switch every registered task to another profile                         */
+/* FailedMask gets the FSWV1_RT_FAILED_xxx settings that could not be     */
+/* applied to at least one task; the others stay applied.                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_RT_SetProfile(uint8 Profile, uint8 *FailedMask)
+{
+    uint8 failed = 0;
+    uint8 i;
+
+    if (Profile >= FSWV1_RT_PROFILE_COUNT || FailedMask == NULL)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    RT_Profile = Profile;
+
+    if (Profile == FSWV1_RT_PROFILE_REALTIME)
+    {
+        if (RTLockMemory() != CFE_SUCCESS)
+        {
+            failed |= FSWV1_RT_FAILED_MEMLOCK;
+        }
+        RTPrefaultStack();
+    }
+    else
+    {
+        RTUnlockMemory();
+    }
+
+    for (i = 0; i < FSWV1_RT_TASK_COUNT; i++)
+    {
+        failed |= RTApplyTask(i);
+    }
+
+    *FailedMask = failed;
+
+    return (failed == 0) ? CFE_SUCCESS : CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Current profile                                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint8 FSWV1_RT_GetProfile(void)
+{
+    return RT_Profile;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Accumulate a cycle period under the current profile                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_RT_RecordPeriod(uint64 PeriodNs)
+{
+    FSWV1_RTJitter_t *j = &RT_Jitter[RT_Profile];
+
+    if (j->Count == 0 || PeriodNs < j->MinNs)
+    {
+        j->MinNs = PeriodNs;
+    }
+    if (PeriodNs > j->MaxNs)
+    {
+        j->MaxNs = PeriodNs;
+    }
+
+    j->SumNs += (double)PeriodNs;
+    j->SumSqNs += (double)PeriodNs * (double)PeriodNs;
+    j->Count++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Report cycle period jitter for every profile that has samples           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_RT_ReportJitter(void)
+{
+    const FSWV1_RTJitter_t *j;
+    double mean;
+    double var;
+    uint8 p;
+
+    for (p = 0; p < FSWV1_RT_PROFILE_COUNT; p++)
+    {
+        j = &RT_Jitter[p];
+        if (j->Count == 0)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_RT_JITTER_INF_EID, CFE_EVS_EventType_INFORMATION,
+                             "FSWV1_RT: %s: no cycles recorded", RT_ProfileNames[p]);
+            continue;
+        }
+
+        mean = j->SumNs / j->Count;
+        var = j->SumSqNs / j->Count - mean * mean;
+        if (var < 0.0)
+        {
+            var = 0.0;
+        }
+
+        CFE_EVS_SendEvent(FSWV1_APP_RT_JITTER_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1_RT: %s: n=%u period mean=%.1f sd=%.1f min=%.1f max=%.1f us",
+                         RT_ProfileNames[p], (unsigned int)j->Count, mean / 1000.0, sqrt(var) / 1000.0,
+                         (double)j->MinNs / 1000.0, (double)j->MaxNs / 1000.0);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Clear the jitter accumulators                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_RT_ResetJitter(void)
+{
+    memset(RT_Jitter, 0, sizeof(RT_Jitter));
+}
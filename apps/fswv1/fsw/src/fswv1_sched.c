@@ -0,0 +1,380 @@
+/******************************************************************************
+** File: fswv1_sched.c
+**
+** Purpose:
+**   This file contains the cycle scheduling functions for the FSWV1 app.
+**   Each acquisition/telemetry cycle is started by a wakeup: the
+**   FSWV1_APP_WAKEUP_MID message from sch_lab, an internal OSAL timer, or
+**   the timerfd of the epoll event loop (see fswv1_evloop.c).
+**
+** Notes:
+**   Wakeups are delivered on their own pipe (or semaphore) so that command
+**   traffic on FSWV1_APP_Data.CommandPipe can never reset or consume them.
+**   Wakeups that pile up while a cycle is still running are counted as
+**   missed cycles instead of being executed back-to-back.
+**
+**   Within a cycle, each subsystem runs in its own rate group. A group is
+**   due when CLOCK_MONOTONIC reaches its absolute deadline; the deadline is
+**   then advanced by whole periods, so rates are drift-free and only
+**   limited in resolution by the wakeup rate.
+**
+**   With the simulated time source (FSWV1_TIME_SOURCE_SIM) there is no
+**   wakeup to wait for: each call to FSWV1_WaitForWakeup advances the
+**   simulated clock by one cycle period and returns at once.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+
+CompileTimeAssert(FSWV1_APP_WAKEUP_RATE_HZ > 0 && FSWV1_APP_WAKEUP_RATE_HZ <= FSWV1_APP_MAX_CYCLE_RATE_HZ,
+                  WakeupRateInRange);
+CompileTimeAssert(FSWV1_DEFAULT_READ_RATE <= FSWV1_APP_WAKEUP_RATE_HZ &&
+                  FSWV1_DEFAULT_IMU_RATE <= FSWV1_APP_WAKEUP_RATE_HZ &&
+                  FSWV1_DEFAULT_TLM_RATE <= FSWV1_APP_WAKEUP_RATE_HZ &&
+                  FSWV1_DEFAULT_HK_RATE <= FSWV1_APP_WAKEUP_RATE_HZ,
+                  DefaultRatesFitWakeupRate);
+
+/*
+** Static variables
+*/
+static bool Sched_Initialized = false;
+
+#if FSWV1_APP_TIME_SOURCE != FSWV1_TIME_SOURCE_SIM && FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_TIMER
+static osal_id_t Sched_TimerId = OS_OBJECT_ID_UNDEFINED;
+static osal_id_t Sched_TickSem = OS_OBJECT_ID_UNDEFINED;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Internal timer callback - runs in the OSAL timebase context             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_SchedTimerCallback(osal_id_t TimerId)
+{
+    OS_CountSemGive(Sched_TickSem);
+}
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize cycle scheduling                                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_InitSched(void)
+{
+    int32 status;
+
+    if (Sched_Initialized)
+    {
+        return CFE_SUCCESS;
+    }
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    status = (FSWV1_APP_CYCLE_RATE_HZ == 0 || FSWV1_APP_CYCLE_RATE_HZ > FSWV1_APP_MAX_CYCLE_RATE_HZ) ?
+             CFE_ES_BAD_ARGUMENT : CFE_SUCCESS;
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Invalid cycle rate %u Hz (max %u)",
+                         (unsigned int)FSWV1_APP_CYCLE_RATE_HZ, (unsigned int)FSWV1_APP_MAX_CYCLE_RATE_HZ);
+        return status;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_SCHED_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_SCHED: Simulated clock at %u Hz for %u s (0 = unlimited), cycles run back-to-back",
+                     (unsigned int)FSWV1_APP_CYCLE_RATE_HZ, (unsigned int)FSWV1_SIM_DURATION_S);
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_TIMER
+    uint32 accuracy_us;
+    uint32 period_us = 1000000 / FSWV1_APP_CYCLE_RATE_HZ;
+
+    if (FSWV1_APP_CYCLE_RATE_HZ == 0 || FSWV1_APP_CYCLE_RATE_HZ > FSWV1_APP_MAX_CYCLE_RATE_HZ)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Invalid cycle rate %u Hz (max %u)",
+                         (unsigned int)FSWV1_APP_CYCLE_RATE_HZ, (unsigned int)FSWV1_APP_MAX_CYCLE_RATE_HZ);
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    status = OS_CountSemCreate(&Sched_TickSem, "FSWV1_TICK", 0, 0);
+    if (status != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Failed to create tick semaphore, RC = %d", (int)status);
+        return status;
+    }
+
+    status = OS_TimerCreate(&Sched_TimerId, "FSWV1_CYCLE", &accuracy_us, FSWV1_SchedTimerCallback);
+    if (status != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Failed to create cycle timer, RC = %d", (int)status);
+        OS_CountSemDelete(Sched_TickSem);
+        Sched_TickSem = OS_OBJECT_ID_UNDEFINED;
+        return status;
+    }
+
+    status = OS_TimerSet(Sched_TimerId, period_us, period_us);
+    if (status != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Failed to start cycle timer, RC = %d", (int)status);
+        OS_TimerDelete(Sched_TimerId);
+        OS_CountSemDelete(Sched_TickSem);
+        Sched_TimerId = OS_OBJECT_ID_UNDEFINED;
+        Sched_TickSem = OS_OBJECT_ID_UNDEFINED;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_SCHED_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_SCHED: Internal timer wakeup at %u Hz (accuracy %u us)",
+                     (unsigned int)FSWV1_APP_CYCLE_RATE_HZ, (unsigned int)accuracy_us);
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_EPOLL
+    status = FSWV1_InitEventLoop();
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+#else
+    /*
+    ** Wakeups from sch_lab get their own pipe so commands never delay them
+    */
+    status = CFE_SB_CreatePipe(&FSWV1_APP_Data.WakeupPipe,
+                              FSWV1_APP_WAKEUP_PIPE_DEPTH,
+                              "FSWV1_WAKEUP_PIPE");
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Error creating wakeup pipe, RC = 0x%08X", (unsigned int)status);
+        return status;
+    }
+
+    status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(FSWV1_APP_WAKEUP_MID),
+                             FSWV1_APP_Data.WakeupPipe);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_SCHED_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_SCHED: Error subscribing to WAKEUP, RC = 0x%08X", (unsigned int)status);
+        return status;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_SCHED_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_SCHED: Waiting for wakeup MID 0x%04X from scheduler at %u Hz",
+                     (unsigned int)FSWV1_APP_WAKEUP_MID, (unsigned int)FSWV1_APP_SCH_CYCLE_RATE_HZ);
+#endif
+
+    Sched_Initialized = true;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Wait for the next cycle wakeup                                          */
+/* Returns CFE_SUCCESS on wakeup, CFE_SB_TIME_OUT if none arrived within  */
+/* FSWV1_APP_WAKEUP_TIMEOUT_MS. Extra queued wakeups are drained and      */
+/* reported through MissedCycles.                                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_WaitForWakeup(uint32 *MissedCycles)
+{
+    int32 status;
+
+    if (MissedCycles == NULL)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    *MissedCycles = 0;
+
+    if (!Sched_Initialized)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    status = FSWV1_Time_SimTick() ? CFE_SUCCESS : CFE_SB_TIME_OUT;
+    if (status != CFE_SUCCESS)
+    {
+        /* Simulated duration reached: end the run */
+        if (FSWV1_APP_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_SCHED_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                             "FSWV1_SCHED: Simulated run of %u s complete after %u cycles",
+                             (unsigned int)FSWV1_SIM_DURATION_S, (unsigned int)FSWV1_APP_Data.CycleCount);
+            FSWV1_APP_Data.RunStatus = CFE_ES_RunStatus_APP_EXIT;
+        }
+        return status;
+    }
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_TIMER
+    status = OS_CountSemTimedWait(Sched_TickSem, FSWV1_APP_WAKEUP_TIMEOUT_MS);
+    if (status == OS_SEM_TIMEOUT)
+    {
+        return CFE_SB_TIME_OUT;
+    }
+    if (status != OS_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Any further ticks already posted are cycles we could not run */
+    while (OS_CountSemTimedWait(Sched_TickSem, 0) == OS_SUCCESS)
+    {
+        (*MissedCycles)++;
+    }
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_EPOLL
+    status = FSWV1_EventLoopWait(MissedCycles);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+#else
+    CFE_SB_Buffer_t *SBBufPtr;
+
+    status = CFE_SB_ReceiveBuffer(&SBBufPtr, FSWV1_APP_Data.WakeupPipe, FSWV1_APP_WAKEUP_TIMEOUT_MS);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Any further wakeups already queued are cycles we could not run */
+    while (CFE_SB_ReceiveBuffer(&SBBufPtr, FSWV1_APP_Data.WakeupPipe, CFE_SB_POLL) == CFE_SUCCESS)
+    {
+        (*MissedCycles)++;
+    }
+#endif
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Close cycle scheduling (cleanup)                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_CloseSched(void)
+{
+    if (!Sched_Initialized)
+    {
+        return;
+    }
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    /* Nothing to release */
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_TIMER
+    if (OS_ObjectIdDefined(Sched_TimerId))
+    {
+        OS_TimerDelete(Sched_TimerId);
+        Sched_TimerId = OS_OBJECT_ID_UNDEFINED;
+    }
+
+    if (OS_ObjectIdDefined(Sched_TickSem))
+    {
+        OS_CountSemDelete(Sched_TickSem);
+        Sched_TickSem = OS_OBJECT_ID_UNDEFINED;
+    }
+#elif FSWV1_APP_WAKEUP_SOURCE == FSWV1_WAKEUP_SOURCE_EPOLL
+    FSWV1_CloseEventLoop();
+#else
+    CFE_SB_DeletePipe(FSWV1_APP_Data.WakeupPipe);
+    FSWV1_APP_Data.WakeupPipe = CFE_SB_INVALID_PIPE;
+#endif
+
+    Sched_Initialized = false;
+
+    OS_printf("FSWV1_SCHED: Cycle scheduling stopped\n");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Monotonic time in nanoseconds                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 FSWV1_Sched_NowNs(void)
+{
+    return FSWV1_Time_MonoNs();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize rate groups to their default rates                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_InitRateGroups(void)
+{
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_BMP280, FSWV1_DEFAULT_READ_RATE);
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_IMU, FSWV1_DEFAULT_IMU_RATE);
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_TLM, FSWV1_DEFAULT_TLM_RATE);
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_HK, FSWV1_DEFAULT_HK_RATE);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set a rate group rate (0 disables the group)                           */
+/* The new schedule starts one period from now. Rates above the cycle    */
+/* wakeup rate cannot be met and are rejected.                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SetRateGroup(uint8 Group, uint32 RateHz)
+{
+    FSWV1_RateGroup_t *rg;
+
+    if (Group >= FSWV1_APP_RATE_GROUP_COUNT || RateHz > FSWV1_APP_WAKEUP_RATE_HZ)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    rg = &FSWV1_APP_Data.RateGroups[Group];
+
+    rg->RateHz = RateHz;
+    rg->PeriodNs = (RateHz > 0) ? (1000000000ULL / RateHz) : 0;
+    rg->NextDeadlineNs = FSWV1_Sched_NowNs() + rg->PeriodNs;
+
+    if (Group == FSWV1_APP_RATE_GROUP_BMP280)
+    {
+        FSWV1_APP_Data.ReadRate = RateHz;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Check whether a rate group is due and advance its deadline             */
+/* A deadline is due at the wakeup nearest to it: it counts as reached   */
+/* FSWV1_RATE_GROUP_TOLERANCE_NS (half a cycle) early. Deadlines are not */
+/* phased to the wakeups, so without this a group at the cycle rate would */
+/* lag a whole period or count skips on wakeup jitter. If more than one   */
+/* deadline has been reached (slow wakeups or an overrun), the group runs */
+/* once and the extra deadlines are counted as skipped.                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool FSWV1_RateGroupDue(uint8 Group, uint64 NowNs)
+{
+    FSWV1_RateGroup_t *rg;
+    uint64 behind;
+
+    if (Group >= FSWV1_APP_RATE_GROUP_COUNT)
+    {
+        return false;
+    }
+
+    rg = &FSWV1_APP_Data.RateGroups[Group];
+    NowNs += FSWV1_RATE_GROUP_TOLERANCE_NS;
+
+    if (rg->RateHz == 0 || NowNs < rg->NextDeadlineNs)
+    {
+        return false;
+    }
+
+    rg->NextDeadlineNs += rg->PeriodNs;
+
+    if (NowNs >= rg->NextDeadlineNs)
+    {
+        behind = (NowNs - rg->NextDeadlineNs) / rg->PeriodNs + 1;
+        rg->SkippedCount += (uint32)behind;
+        rg->NextDeadlineNs += behind * rg->PeriodNs;
+    }
+
+    rg->RunCount++;
+
+    return true;
+}
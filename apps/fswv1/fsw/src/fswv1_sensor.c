@@ -5,360 +5,1081 @@
 **   This file contains the sensor interface and UDP functions for FSWV1 app.
 **   Uses native I2C file descriptors (not OSAL) to match working implementation.
 **
+**   Every register access is one I2C_RDWR transaction: the register address
+**   write and the data read are joined by a repeated start, so another bus
+**   master cannot address the sensor in between and each access costs one
+**   system call. Register runs needed together are batched into one
+**   transaction as well.
+**
+**   Each entry of FSWV1_BMP_DEVICES is a barometer instance with its own
+**   chip driver (fswv1_baro.h), calibration, measurement profile and
+**   health. The chip is identified at probe time unless the entry names
+**   it. Entries on the same bus device share one descriptor (I2C_RDWR
+**   carries the address in every message). Each bus has a reader task that
+**   reads all of its devices when FSWV1_TriggerSensors wakes it, so the
+**   buses work in parallel and the main task never waits on the I2C
+**   adapter. Finished samples wait in a ring per device until
+**   FSWV1_ReadSensors collects them; a FIFO read can return many at once.
+**
+** Notes:
+**   A device's state belongs to whoever reads its bus: the bus task while
+**   it runs, otherwise the main task. Profile commands take the bus lock,
+**   which the reader holds for a whole pass.
+**
 ******************************************************************************/
 
-#include "fswv1_app.h"
+#include "fswv1_baro.h"
+#include <stdio.h>
 #include <string.h>
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
 /*
-** FSWV1 Register Definitions
+** Barometer configuration entry (FSWV1_BMP_DEVICES)
 */
-#define FSWV1_REG_CHIP_ID      0xD0
-#define FSWV1_REG_RESET        0xE0
-#define FSWV1_REG_STATUS       0xF3
-#define FSWV1_REG_CTRL_MEAS    0xF4
-#define FSWV1_REG_CONFIG       0xF5
-#define FSWV1_REG_PRESS_MSB    0xF7
-#define FSWV1_REG_TEMP_MSB     0xFA
-#define FSWV1_REG_CALIB_00     0x88
+typedef struct
+{
+    const char *Bus;       /* I2C bus device */
+    uint8       Address;   /* 7-bit slave address (0x76 or 0x77) */
+    uint8       Chip;      /* FSWV1_BMP_CHIP_xxx, omitted = detect */
+} FSWV1_BaroConfig_t;
+
+static const FSWV1_BaroConfig_t Baro_ConfigTable[] = { FSWV1_BMP_DEVICES };
+
+#define BARO_DEVICE_COUNT (sizeof(Baro_ConfigTable) / sizeof(Baro_ConfigTable[0]))
 
-#define FSWV1_CHIP_ID          0x58
+CompileTimeAssert(BARO_DEVICE_COUNT <= FSWV1_BMP_MAX_INSTANCES, BmpDevicesExceedInstances);
+CompileTimeAssert((FSWV1_BMP_RING_SIZE & (FSWV1_BMP_RING_SIZE - 1)) == 0, BmpRingSizePowerOfTwo);
 
 /*
-** Calibration data structure
+** Chip drivers, tried in this order when identifying a device
 */
-typedef struct
-{
-    uint16_t dig_T1;
-    int16_t dig_T2;
-    int16_t dig_T3;
-    uint16_t dig_P1;
-    int16_t dig_P2;
-    int16_t dig_P3;
-    int16_t dig_P4;
-    int16_t dig_P5;
-    int16_t dig_P6;
-    int16_t dig_P7;
-    int16_t dig_P8;
-    int16_t dig_P9;
-} FSWV1_CalibData_t;
+static const FSWV1_BaroDriver_t *const Baro_Drivers[] = {
+    &FSWV1_BMP280_Driver,
+    &FSWV1_BMP3_Driver
+};
+
+#define BARO_DRIVER_COUNT (sizeof(Baro_Drivers) / sizeof(Baro_Drivers[0]))
+
+CompileTimeAssert(BARO_DRIVER_COUNT <= FSWV1_I2C_MAX_RUNS, BaroDriverIdsFitOneTransaction);
 
 /*
-** Static variables - using native file descriptor instead of OSAL
+** I2C bus (one per distinct bus device in FSWV1_BMP_DEVICES)
+** Fd and the statistics are only touched with Lock held.
 */
-static int I2C_Fd = -1;  /* Native file descriptor */
-static FSWV1_CalibData_t CalibData;
-static int32 t_fine; /* Used in compensation calculations */
+struct FSWV1_I2CBus
+{
+    const char     *Path;
+    int             Fd;                /* Native file descriptor */
+    osal_id_t       Lock;              /* Held for every pass and profile change */
+    osal_id_t       Trigger;           /* Wakes the reader task */
+    osal_id_t       Done;              /* Given by the reader task on exit */
+    CFE_ES_TaskId_t TaskId;
+    volatile bool   TaskRunning;
+    bool            TaskStarted;       /* A reader task was created for this bus */
+    bool            TaskClaimed;       /* A reader task has taken this bus */
+    bool            Pending;           /* Triggered and the pass not finished yet */
+    uint64          TriggerNs;         /* Sample time for the pending pass (0 = read time) */
+    char            TaskName[OS_MAX_API_NAME];
+
+    uint32 Transactions;               /* I2C_RDWR ioctls issued */
+    uint32 Errors;                     /* Transactions that failed */
+    uint32 Bytes;                      /* Address, register and data bytes on the bus */
+    uint32 Passes;                     /* Read passes over the bus's devices */
+    uint32 Overruns;                   /* Triggers that found a pass still pending */
+    uint32 MaxPassUs;                  /* Longest pass */
+};
 
 /*
-** Forward declarations
+** Static variables - using native file descriptors instead of OSAL
 */
-static int32 FSWV1_ReadCalibrationData(void);
-static int32 FSWV1_CompensateTemperature(int32 adc_T);
-static uint32 FSWV1_CompensatePressure(int32 adc_P);
+static FSWV1_I2CBus_t Baro_Buses[FSWV1_BMP_MAX_BUSES];
+static uint32 Baro_BusCount = 0;
+static FSWV1_BaroDevice_t Baro_Devices[BARO_DEVICE_COUNT];
+static bool Baro_Initialized = false;
+
+/* Samples of one read, before they go into the device ring (bus lock held) */
+static FSWV1_SensorData_t Baro_ReadBuf[FSWV1_BMP_MAX_BUSES][FSWV1_BARO_READ_MAX];
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* I2C Write Register (using native write)                                */
+/* Issue one I2C_RDWR transaction (one START, repeated starts, one STOP)  */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static int32 FSWV1_WriteReg(uint8 reg, uint8 value)
+static int32 FSWV1_I2CTransfer(FSWV1_I2CBus_t *bus, struct i2c_msg *msgs, uint32 count)
 {
-    uint8 buf[2] = {reg, value};
-    
-    if (write(I2C_Fd, buf, 2) != 2)
+    struct i2c_rdwr_ioctl_data xfer;
+    uint32 i;
+
+    xfer.msgs = msgs;
+    xfer.nmsgs = count;
+
+    bus->Transactions++;
+    for (i = 0; i < count; i++)
+    {
+        bus->Bytes += 1 + msgs[i].len;   /* Address byte + payload */
+    }
+
+    if (ioctl(bus->Fd, I2C_RDWR, &xfer) != (int)count)
     {
+        bus->Errors++;
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
-    
+
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* I2C Read Registers (using native read/write)                           */
+/* I2C Write Registers                                                     */
+/* Both chip families take register/value pairs in one write (no auto-   */
+/* increment on writes); they are applied in order.                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_Baro_WriteRegs(FSWV1_BaroDevice_t *Dev, const uint8 *Pairs, uint8 Count)
+{
+    struct i2c_msg msg;
+
+    msg.addr = Dev->Address;
+    msg.flags = 0;
+    msg.len = (uint16)(Count * 2);
+    msg.buf = (uint8 *)Pairs;
+
+    return FSWV1_I2CTransfer(Dev->Bus, &msg, 1);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* I2C Read Register Runs                                                  */
+/* Each run is an address write and a data read; all runs, and then the  */
+/* register/value pairs if any, go out in one transaction.                 */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static int32 FSWV1_ReadReg(uint8 reg, uint8 *data, uint8 len)
+int32 FSWV1_Baro_ReadRegRuns(FSWV1_BaroDevice_t *Dev, const FSWV1_RegRun_t *Runs, uint32 Count,
+                             const uint8 *Pairs, uint8 PairCount)
 {
-    /* Write register address */
-    if (write(I2C_Fd, &reg, 1) != 1)
+    struct i2c_msg msgs[FSWV1_I2C_MAX_RUNS * 2 + 1];
+    uint8 regs[FSWV1_I2C_MAX_RUNS];
+    uint32 nmsgs;
+    uint32 i;
+
+    if (Count == 0 || Count > FSWV1_I2C_MAX_RUNS)
     {
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        return CFE_ES_BAD_ARGUMENT;
     }
-    
-    /* Read data */
-    if (read(I2C_Fd, data, len) != len)
+
+    for (i = 0; i < Count; i++)
     {
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        regs[i] = Runs[i].Reg;
+
+        msgs[2 * i].addr = Dev->Address;
+        msgs[2 * i].flags = 0;
+        msgs[2 * i].len = 1;
+        msgs[2 * i].buf = &regs[i];
+
+        msgs[2 * i + 1].addr = Dev->Address;
+        msgs[2 * i + 1].flags = I2C_M_RD;
+        msgs[2 * i + 1].len = Runs[i].Len;
+        msgs[2 * i + 1].buf = Runs[i].Data;
     }
-    
-    return CFE_SUCCESS;
+    nmsgs = Count * 2;
+
+    if (PairCount > 0)
+    {
+        msgs[nmsgs].addr = Dev->Address;
+        msgs[nmsgs].flags = 0;
+        msgs[nmsgs].len = (uint16)(PairCount * 2);
+        msgs[nmsgs].buf = (uint8 *)Pairs;
+        nmsgs++;
+    }
+
+    return FSWV1_I2CTransfer(Dev->Bus, msgs, nmsgs);
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Initialize FSWV1 sensor                                               */
+/* I2C Read Registers (one run)                                            */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-int32 FSWV1_InitSensor(void)
+int32 FSWV1_Baro_ReadReg(FSWV1_BaroDevice_t *Dev, uint8 Reg, uint8 *Data, uint16 Len)
 {
-    uint8 chip_id;
+    FSWV1_RegRun_t run = {Reg, Len, Data};
 
-    /*
-    ** Open I2C device using native open() (not OSAL)
-    */
-    I2C_Fd = open(FSWV1_I2C_DEVICE, O_RDWR);
-    if (I2C_Fd < 0)
+    return FSWV1_Baro_ReadRegRuns(Dev, &run, 1, NULL, 0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Pick a device's driver (bus lock held)                                  */
+/* A chip named in the table selects its driver directly. Otherwise the  */
+/* ID register of every driver is read in one transaction and the first  */
+/* driver that recognises its ID wins.                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 FSWV1_DetectSensor(FSWV1_BaroDevice_t *dev, uint8 *chip_id)
+{
+    FSWV1_RegRun_t runs[BARO_DRIVER_COUNT];
+    uint8 ids[BARO_DRIVER_COUNT];
+    const FSWV1_BaroDriver_t *drv;
+    uint32 d, k;
+    int32 status;
+
+    *chip_id = 0;
+
+    for (d = 0; d < BARO_DRIVER_COUNT; d++)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to open I2C device %s", FSWV1_I2C_DEVICE);
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        drv = Baro_Drivers[d];
+        ids[d] = 0;
+        runs[d].Reg = drv->IdReg;
+        runs[d].Len = 1;
+        runs[d].Data = &ids[d];
+
+        for (k = 0; k < 2 && dev->ConfigChip != FSWV1_BMP_CHIP_AUTO; k++)
+        {
+            if (drv->Chip[k] == dev->ConfigChip)
+            {
+                dev->Driver = drv;
+                return CFE_SUCCESS;
+            }
+        }
+    }
+
+    if (dev->ConfigChip != FSWV1_BMP_CHIP_AUTO)
+    {
+        return CFE_ES_BAD_ARGUMENT;
     }
 
+    status = FSWV1_Baro_ReadRegRuns(dev, runs, BARO_DRIVER_COUNT, NULL, 0);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    for (d = 0; d < BARO_DRIVER_COUNT; d++)
+    {
+        drv = Baro_Drivers[d];
+        for (k = 0; k < 2; k++)
+        {
+            if (drv->ChipId[k] != 0 && ids[d] == drv->ChipId[k])
+            {
+                dev->Driver = drv;
+                *chip_id = ids[d];
+                return CFE_SUCCESS;
+            }
+        }
+    }
+
+    *chip_id = ids[0];
+    return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Identify a device and bring it up with its profile (bus lock held)     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 FSWV1_ProbeSensor(FSWV1_BaroDevice_t *dev, uint8 *chip_id)
+{
+    const FSWV1_BaroDriver_t *previous = dev->Driver;
+    int32 status;
+
+    *chip_id = 0;
+
+    if (dev->ConfigChip == FSWV1_BMP_CHIP_AUTO || dev->Driver == NULL)
+    {
+        dev->Driver = NULL;
+        status = FSWV1_DetectSensor(dev, chip_id);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    /* A different chip found at a re-probe starts from clean driver state */
+    if (dev->Driver != previous)
+    {
+        memset(&dev->State, 0, sizeof(dev->State));
+    }
+
+    return dev->Driver->Probe(dev);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Open a bus device                                                       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 FSWV1_OpenBus(FSWV1_I2CBus_t *bus, uint32 index)
+{
+    unsigned long funcs = 0;
+    char name[OS_MAX_API_NAME];
+    int32 status;
+
     /*
-    ** Set I2C slave address using ioctl (native, not OSAL)
+    ** Open I2C device using native open() (not OSAL)
     */
-    if (ioctl(I2C_Fd, I2C_SLAVE, FSWV1_I2C_ADDRESS) < 0)
+    bus->Fd = open(bus->Path, O_RDWR);
+    if (bus->Fd < 0)
     {
         CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to set I2C slave address 0x%02X", FSWV1_I2C_ADDRESS);
-        close(I2C_Fd);
-        I2C_Fd = -1;
+                         "FSWV1: Failed to open I2C device %s", bus->Path);
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
 
     /*
-    ** Read and verify chip ID
+    ** The adapter must support combined (repeated start) transfers;
+    ** the slave address goes in each message, so I2C_SLAVE is not needed
     */
-    if (FSWV1_ReadReg(FSWV1_REG_CHIP_ID, &chip_id, 1) != CFE_SUCCESS)
+    if (ioctl(bus->Fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C))
     {
         CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to read chip ID");
-        close(I2C_Fd);
-        I2C_Fd = -1;
+                         "FSWV1: %s does not support I2C_RDWR transfers", bus->Path);
+        close(bus->Fd);
+        bus->Fd = -1;
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
 
-    if (chip_id != FSWV1_CHIP_ID)
+    snprintf(name, sizeof(name), "FSWV1_I2C%u", (unsigned int)index);
+    status = OS_MutSemCreate(&bus->Lock, name, 0);
+    if (status == OS_SUCCESS)
+    {
+        snprintf(name, sizeof(name), "FSWV1_I2CTRG%u", (unsigned int)index);
+        status = OS_BinSemCreate(&bus->Trigger, name, OS_SEM_EMPTY, 0);
+        if (status == OS_SUCCESS)
+        {
+            snprintf(name, sizeof(name), "FSWV1_I2CDON%u", (unsigned int)index);
+            status = OS_BinSemCreate(&bus->Done, name, OS_SEM_EMPTY, 0);
+            if (status != OS_SUCCESS)
+            {
+                OS_BinSemDelete(bus->Trigger);
+                bus->Trigger = OS_OBJECT_ID_UNDEFINED;
+            }
+        }
+        if (status != OS_SUCCESS)
+        {
+            OS_MutSemDelete(bus->Lock);
+            bus->Lock = OS_OBJECT_ID_UNDEFINED;
+        }
+    }
+    if (status != OS_SUCCESS)
     {
         CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Invalid chip ID: 0x%02X (expected 0x58)", chip_id);
-        close(I2C_Fd);
-        I2C_Fd = -1;
+                         "FSWV1: Failed to create %s semaphores, RC = %d", bus->Path, (int)status);
+        close(bus->Fd);
+        bus->Fd = -1;
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
 
-    OS_printf("FSWV1: Chip ID verified: 0x%02X\n", chip_id);
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize FSWV1 sensors                                                */
+/* Opens every bus in FSWV1_BMP_DEVICES and probes every device. Devices  */
+/* that do not answer start out failed and are re-probed later, so the   */
+/* call succeeds as long as one device was found.                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_InitSensor(void)
+{
+    FSWV1_APP_SetBmpProfileCmd_Payload_t profile = {
+        FSWV1_BMP_OSRS_T, FSWV1_BMP_OSRS_P, FSWV1_BMP_FILTER, FSWV1_BMP_STANDBY, FSWV1_BMP_MODE, 0, {0}
+    };
+    FSWV1_BaroDevice_t *dev;
+    FSWV1_I2CBus_t *bus;
+    uint32 found = 0;
+    uint32 i, b;
+    uint8 chip_id;
+    int32 status;
+
+    memset(Baro_Buses, 0, sizeof(Baro_Buses));
+    memset(Baro_Devices, 0, sizeof(Baro_Devices));
+    Baro_BusCount = 0;
 
     /*
-    ** Configure sensor
-    ** ctrl_meas: 0x27 = osrs_t x1, osrs_p x1, normal mode
+    ** One bus per distinct device path
     */
-    if (FSWV1_WriteReg(FSWV1_REG_CTRL_MEAS, 0x27) != CFE_SUCCESS)
+    for (i = 0; i < BARO_DEVICE_COUNT; i++)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to configure CTRL_MEAS");
-        close(I2C_Fd);
-        I2C_Fd = -1;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        dev = &Baro_Devices[i];
+        dev->Address = Baro_ConfigTable[i].Address;
+        dev->ConfigChip = Baro_ConfigTable[i].Chip;
+        dev->Instance = (uint8)i;
+        dev->Health = FSWV1_BMP_HEALTH_FAILED;
+        dev->Profile = profile;
+        dev->Profile.Instance = (uint8)i;
+
+        for (b = 0; b < Baro_BusCount; b++)
+        {
+            if (strcmp(Baro_Buses[b].Path, Baro_ConfigTable[i].Bus) == 0)
+            {
+                break;
+            }
+        }
+
+        if (b == Baro_BusCount)
+        {
+            if (Baro_BusCount == FSWV1_BMP_MAX_BUSES)
+            {
+                CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "FSWV1: Barometer %u: more than %u I2C buses configured",
+                                 (unsigned int)i, (unsigned int)FSWV1_BMP_MAX_BUSES);
+                continue;
+            }
+
+            bus = &Baro_Buses[Baro_BusCount++];
+            bus->Path = Baro_ConfigTable[i].Bus;
+            bus->Fd = -1;
+            if (FSWV1_OpenBus(bus, b) != CFE_SUCCESS)
+            {
+                continue;
+            }
+        }
+
+        if (Baro_Buses[b].Fd >= 0)
+        {
+            dev->Bus = &Baro_Buses[b];
+        }
     }
 
     /*
-    ** config: 0x00 = standby 0.5ms, filter off
+    ** Probe every device on an open bus
     */
-    if (FSWV1_WriteReg(FSWV1_REG_CONFIG, 0x00) != CFE_SUCCESS)
+    for (i = 0; i < BARO_DEVICE_COUNT; i++)
+    {
+        dev = &Baro_Devices[i];
+        if (dev->Bus == NULL)
+        {
+            continue;
+        }
+
+        status = FSWV1_ProbeSensor(dev, &chip_id);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1: Barometer %u (%s 0x%02X) not found, chip ID 0x%02X, RC = 0x%08X",
+                             (unsigned int)i, dev->Bus->Path, (unsigned int)dev->Address,
+                             (unsigned int)chip_id, (unsigned int)status);
+            continue;
+        }
+
+        dev->Health = FSWV1_BMP_HEALTH_OK;
+        found++;
+        OS_printf("FSWV1: Barometer %u (%s) on %s at 0x%02X initialized\n",
+                  (unsigned int)i, dev->Driver->Name, dev->Bus->Path, (unsigned int)dev->Address);
+    }
+
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        if (Baro_Buses[b].Fd >= 0)
+        {
+            Baro_Initialized = true;
+        }
+    }
+
+    if (found == 0)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to configure CONFIG");
-        close(I2C_Fd);
-        I2C_Fd = -1;
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
 
-    /* Wait for sensor to stabilize */
+    /* Wait for sensors to stabilize */
     usleep(10000);  /* 10ms */
-    
+
+    OS_printf("FSWV1: %u of %u barometers initialized on %u buses\n",
+              (unsigned int)found, (unsigned int)BARO_DEVICE_COUNT, (unsigned int)Baro_BusCount);
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read or re-probe one device and track its health (bus lock held)       */
+/* Good samples go into the device's ring. A single register read is     */
+/* stamped with TriggerNs when the pass was started by a data-ready edge; */
+/* FIFO drivers time their frames themselves.                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_ServiceDevice(FSWV1_BaroDevice_t *dev, FSWV1_SensorData_t *buf, uint64 TriggerNs)
+{
+    uint32 count = 0;
+    uint32 head;
+    uint32 txns;
+    uint32 i;
+    uint8 chip_id;
+    int32 status;
+
+    if (dev->Health == FSWV1_BMP_HEALTH_FAILED)
+    {
+        if (++dev->ProbeWait < FSWV1_BMP_REPROBE_PASSES)
+        {
+            return;
+        }
+
+        dev->ProbeWait = 0;
+        if (FSWV1_ProbeSensor(dev, &chip_id) == CFE_SUCCESS)
+        {
+            dev->Health = FSWV1_BMP_HEALTH_OK;
+            dev->ConsecErrors = 0;
+            dev->Recoveries++;
+            CFE_EVS_SendEvent(FSWV1_APP_BMP_HEALTH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                             "FSWV1: Barometer %u (%s, %s 0x%02X) recovered",
+                             (unsigned int)dev->Instance, dev->Driver->Name, dev->Bus->Path,
+                             (unsigned int)dev->Address);
+        }
+        return;
+    }
+
+    txns = dev->Bus->Transactions;
+    status = dev->Driver->Read(dev, buf, FSWV1_BARO_READ_MAX, &count);
+    dev->SampleTxns = dev->Bus->Transactions - txns;
+    if (status == OS_ERROR)   /* Nothing new yet */
+    {
+        return;
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        dev->ReadErrors++;
+        dev->ConsecErrors++;
+        dev->Health = FSWV1_BMP_HEALTH_DEGRADED;
+
+        if (dev->ConsecErrors >= FSWV1_BMP_FAIL_LIMIT)
+        {
+            dev->Health = FSWV1_BMP_HEALTH_FAILED;
+            dev->ProbeWait = 0;
+            CFE_EVS_SendEvent(FSWV1_APP_BMP_HEALTH_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1: Barometer %u (%s 0x%02X) failed after %u read errors",
+                             (unsigned int)dev->Instance, dev->Bus->Path, (unsigned int)dev->Address,
+                             (unsigned int)dev->ConsecErrors);
+        }
+        return;
+    }
+
+    dev->ConsecErrors = 0;
+    dev->Health = FSWV1_BMP_HEALTH_OK;
+
+    if (TriggerNs != 0 && !dev->Driver->Fifo && count == 1)
+    {
+        buf[0].ArrivalNs = TriggerNs;
+        buf[0].Timestamp = FSWV1_Time_MonoToTime(TriggerNs);
+    }
+
     /*
-    ** Read calibration data
+    ** Push into the ring; when the main task has fallen behind by a whole
+    ** ring the newest samples are dropped
     */
-    if (FSWV1_ReadCalibrationData() != CFE_SUCCESS)
+    head = dev->Head;
+    for (i = 0; i < count; i++)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to read calibration data");
-        close(I2C_Fd);
-        I2C_Fd = -1;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        if (head - __atomic_load_n(&dev->Tail, __ATOMIC_ACQUIRE) >= FSWV1_BMP_RING_SIZE)
+        {
+            dev->Dropped += count - i;
+            break;
+        }
+
+        dev->Ring[head & (FSWV1_BMP_RING_SIZE - 1)] = buf[i];
+        head++;
+        dev->Samples++;
     }
+    __atomic_store_n(&dev->Head, head, __ATOMIC_RELEASE);
+}
 
-    OS_printf("FSWV1: Sensor initialized successfully\n");
-    return CFE_SUCCESS;
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read every device on a bus once                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_SensorBusPass(FSWV1_I2CBus_t *bus)
+{
+    uint64 trigger_ns;
+    uint64 start;
+    uint64 pass_us;
+    uint32 i;
+
+    trigger_ns = bus->TriggerNs;
+
+    OS_MutSemTake(bus->Lock);
+    start = FSWV1_Time_MonoNs();
+
+    for (i = 0; i < BARO_DEVICE_COUNT; i++)
+    {
+        if (Baro_Devices[i].Bus == bus)
+        {
+            FSWV1_ServiceDevice(&Baro_Devices[i], Baro_ReadBuf[bus - Baro_Buses], trigger_ns);
+        }
+    }
+
+    pass_us = (FSWV1_Time_MonoNs() - start) / 1000;
+    bus->Passes++;
+    if (pass_us > bus->MaxPassUs)
+    {
+        bus->MaxPassUs = (uint32)pass_us;
+    }
+    OS_MutSemGive(bus->Lock);
+
+    __atomic_store_n(&bus->Pending, false, __ATOMIC_RELEASE);
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Read calibration data from sensor                                      */
+/* Barometer bus reader child task (one per bus)                          */
+/* Takes the first started bus that has no reader yet, then runs a pass  */
+/* each time FSWV1_TriggerSensors wakes it.                                */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static int32 FSWV1_ReadCalibrationData(void)
+static void FSWV1_SensorBusTask(void)
 {
-    uint8 calib[24];
-    
-    /* Read temperature calibration (6 bytes from 0x88) */
-    if (FSWV1_ReadReg(0x88, calib, 6) != CFE_SUCCESS)
+    FSWV1_I2CBus_t *bus = NULL;
+    bool unclaimed;
+    uint8 rt_task;
+    uint32 b;
+    int32 status;
+
+    for (b = 0; b < Baro_BusCount && bus == NULL; b++)
+    {
+        unclaimed = false;
+        if (Baro_Buses[b].TaskRunning &&
+            __atomic_compare_exchange_n(&Baro_Buses[b].TaskClaimed, &unclaimed, true,
+                                        false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            bus = &Baro_Buses[b];
+        }
+    }
+
+    if (bus == NULL)
+    {
+        CFE_ES_ExitChildTask();
+        return;
+    }
+
+    rt_task = (uint8)(FSWV1_RT_TASK_BMP + (bus - Baro_Buses));
+    FSWV1_RT_RegisterTask(rt_task);
+
+    while (bus->TaskRunning)
+    {
+        status = OS_BinSemTimedWait(bus->Trigger, FSWV1_BMP_TASK_POLL_MS);
+
+        if (status == OS_SUCCESS && bus->TaskRunning)
+        {
+            FSWV1_SensorBusPass(bus);
+        }
+        else if (status != OS_SUCCESS && status != OS_SEM_TIMEOUT)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1: %s reader task wait failed, RC = %d", bus->Path, (int)status);
+            break;
+        }
+    }
+
+    FSWV1_RT_UnregisterTask(rt_task);
+    bus->TaskRunning = false;
+    __atomic_store_n(&bus->Pending, false, __ATOMIC_RELEASE);
+
+    /* Last touch of the bus: FSWV1_CloseSensor may delete it from here on */
+    OS_BinSemGive(bus->Done);
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Start one reader task per open bus                                      */
+/* A bus whose task fails to start is read by the main task instead.     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_StartSensorTasks(void)
+{
+    FSWV1_I2CBus_t *bus;
+    uint32 started = 0;
+    uint32 b;
+    int32 status = CFE_SUCCESS;
+
+    if (!Baro_Initialized)
     {
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
-    
-    CalibData.dig_T1 = (calib[1] << 8) | calib[0];
-    CalibData.dig_T2 = (calib[3] << 8) | calib[2];
-    CalibData.dig_T3 = (calib[5] << 8) | calib[4];
-    
-    /* Read pressure calibration (18 bytes from 0x8E) */
-    if (FSWV1_ReadReg(0x8E, calib, 18) != CFE_SUCCESS)
+
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        bus = &Baro_Buses[b];
+        if (bus->Fd < 0 || bus->TaskRunning)
+        {
+            continue;
+        }
+
+        snprintf(bus->TaskName, sizeof(bus->TaskName), "%s%u", FSWV1_BMP_TASK_NAME, (unsigned int)b);
+        bus->TaskRunning = true;
+
+        status = CFE_ES_CreateChildTask(&bus->TaskId, bus->TaskName, FSWV1_SensorBusTask,
+                                        CFE_ES_TASK_STACK_ALLOCATE, FSWV1_BMP_TASK_STACK_SIZE,
+                                        FSWV1_BMP_TASK_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            bus->TaskRunning = false;
+            CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1: Failed to create %s reader task, RC = 0x%08X",
+                             bus->Path, (unsigned int)status);
+            continue;
+        }
+
+        bus->TaskStarted = true;
+        started++;
+    }
+
+    if (started > 0)
+    {
+        CFE_EVS_SendEvent(FSWV1_APP_BMP_HEALTH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1: Barometer reader tasks started on %u of %u buses",
+                         (unsigned int)started, (unsigned int)Baro_BusCount);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Start a read pass on every bus                                          */
+/* EdgeNs is the data-ready edge that triggered the read (0 = timer); it  */
+/* replaces the I2C completion time as the sample time. Buses with a      */
+/* reader task are only woken; the others are read here.                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_TriggerSensors(uint64 EdgeNs)
+{
+    FSWV1_I2CBus_t *bus;
+    uint32 b;
+
+    if (!Baro_Initialized)
     {
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
-    
-    CalibData.dig_P1 = (calib[1] << 8) | calib[0];
-    CalibData.dig_P2 = (calib[3] << 8) | calib[2];
-    CalibData.dig_P3 = (calib[5] << 8) | calib[4];
-    CalibData.dig_P4 = (calib[7] << 8) | calib[6];
-    CalibData.dig_P5 = (calib[9] << 8) | calib[8];
-    CalibData.dig_P6 = (calib[11] << 8) | calib[10];
-    CalibData.dig_P7 = (calib[13] << 8) | calib[12];
-    CalibData.dig_P8 = (calib[15] << 8) | calib[14];
-    CalibData.dig_P9 = (calib[17] << 8) | calib[16];
-
-    OS_printf("FSWV1: Calibration data loaded\n");
+
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        bus = &Baro_Buses[b];
+        if (bus->Fd < 0)
+        {
+            continue;
+        }
+
+        if (__atomic_load_n(&bus->Pending, __ATOMIC_ACQUIRE))
+        {
+            bus->Overruns++;
+            continue;
+        }
+
+        bus->TriggerNs = EdgeNs;
+
+        if (bus->TaskRunning)
+        {
+            __atomic_store_n(&bus->Pending, true, __ATOMIC_RELEASE);
+            OS_BinSemGive(bus->Trigger);
+        }
+        else
+        {
+            FSWV1_SensorBusPass(bus);
+        }
+    }
+
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Read sensor data                                                        */
+/* Collect the samples finished since the last call                        */
+/* Oldest first within an instance, instance by instance. Samples that do */
+/* not fit in MaxSamples stay queued for the next call.                    */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-int32 FSWV1_ReadSensor(FSWV1_SensorData_t *Data)
+int32 FSWV1_ReadSensors(FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count)
 {
-    uint8 data[6];
-    int32 adc_T, adc_P;
-    int32 temp;
-    uint32 press;
-    
-    if (Data == NULL)
+    FSWV1_BaroDevice_t *dev;
+    uint32 head;
+    uint32 tail;
+    uint32 i;
+
+    if (Samples == NULL || Count == NULL)
     {
         return CFE_ES_BAD_ARGUMENT;
     }
 
-    if (I2C_Fd < 0)
+    *Count = 0;
+
+    if (!Baro_Initialized)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Sensor not initialized");
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
 
-    /*
-    ** Read pressure and temperature data (6 bytes from 0xF7)
-    ** data[0-2]: pressure (MSB, LSB, XLSB)
-    ** data[3-5]: temperature (MSB, LSB, XLSB)
-    */
-    if (FSWV1_ReadReg(FSWV1_REG_PRESS_MSB, data, 6) != CFE_SUCCESS)
+    for (i = 0; i < BARO_DEVICE_COUNT && *Count < MaxSamples; i++)
+    {
+        dev = &Baro_Devices[i];
+        head = __atomic_load_n(&dev->Head, __ATOMIC_ACQUIRE);
+        tail = dev->Tail;
+
+        while (tail != head && *Count < MaxSamples)
+        {
+            Samples[(*Count)++] = dev->Ring[tail & (FSWV1_BMP_RING_SIZE - 1)];
+            tail++;
+        }
+
+        __atomic_store_n(&dev->Tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Set the measurement profile of one instance or all of them             */
+/* The profile is kept for failed devices and applied when a re-probe    */
+/* finds them again; the command still reports the failure. A profile a  */
+/* device's chip cannot run is refused and its previous one kept.         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SetSensorProfile(uint8 Instance, const FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile)
+{
+    FSWV1_APP_SetBmpProfileCmd_Payload_t previous;
+    FSWV1_BaroDevice_t *dev;
+    int32 result = CFE_SUCCESS;
+    int32 status;
+    uint32 i;
+
+    if (Profile->OsrsT < FSWV1_BMP_OSRS_X1 || Profile->OsrsT > FSWV1_BMP_OSRS_X16 ||
+        Profile->OsrsP < FSWV1_BMP_OSRS_X1 || Profile->OsrsP > FSWV1_BMP_OSRS_X16 ||
+        Profile->Filter > FSWV1_BMP_FILTER_16 || Profile->Standby > FSWV1_BMP_STANDBY_4000MS ||
+        (Profile->Mode != FSWV1_BMP_MODE_FORCED && Profile->Mode != FSWV1_BMP_MODE_NORMAL) ||
+        (Instance >= BARO_DEVICE_COUNT && Instance != FSWV1_BMP_ALL_INSTANCES))
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    if (!Baro_Initialized)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1: Failed to read sensor data");
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
-    
-    /* Combine raw ADC values (20-bit) */
-    adc_P = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
-    adc_T = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
-    
-    /* Compensate temperature (must be done first to calculate t_fine) */
-    temp = FSWV1_CompensateTemperature(adc_T);
-    Data->Temperature = temp / 100.0f;  /* Convert to °C */
 
-    /* Compensate pressure (uses t_fine from temperature calculation) */
-    press = FSWV1_CompensatePressure(adc_P);
-    Data->Pressure = press / 25600.0f;  /* Convert to hPa */
+    for (i = 0; i < BARO_DEVICE_COUNT; i++)
+    {
+        dev = &Baro_Devices[i];
+        if (Instance != FSWV1_BMP_ALL_INSTANCES && Instance != i)
+        {
+            continue;
+        }
+
+        if (dev->Bus == NULL)
+        {
+            result = CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+            continue;
+        }
 
-    /* Get timestamp */
-    CFE_TIME_SysTime_t time = CFE_TIME_GetTime();
-    Data->Timestamp = time.Seconds;
+        OS_MutSemTake(dev->Bus->Lock);
+        previous = dev->Profile;
+        dev->Profile = *Profile;
+        dev->Profile.Instance = (uint8)i;
+        status = CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        if (dev->Health != FSWV1_BMP_HEALTH_FAILED)
+        {
+            status = dev->Driver->ApplyProfile(dev);
+            if (status == CFE_ES_BAD_ARGUMENT)
+            {
+                dev->Profile = previous;
+            }
+        }
+        OS_MutSemGive(dev->Bus->Lock);
+
+        if (status != CFE_SUCCESS)
+        {
+            result = status;
+        }
+    }
+
+    return result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get an instance's measurement profile for housekeeping                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_GetSensorProfile(uint8 Instance, FSWV1_APP_SetBmpProfileCmd_Payload_t *Profile,
+                             uint32 *MeasTimeUs, uint32 *NotReady)
+{
+    if (Instance >= BARO_DEVICE_COUNT)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    *Profile = Baro_Devices[Instance].Profile;
+    *MeasTimeUs = Baro_Devices[Instance].MeasTimeUs;
+    *NotReady = Baro_Devices[Instance].NotReady;
 
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Compensate temperature (from FSWV1 datasheet)                         */
+/* Close sensors                                                           */
+/* Each reader task is stopped and joined before its bus is torn down:   */
+/* the semaphores and the fd stay valid until the task has given Done.   */
+/* A task that does not exit in time is deleted.                          */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static int32 FSWV1_CompensateTemperature(int32 adc_T)
+void FSWV1_CloseSensor(void)
 {
-    int32 var1, var2, T;
+    FSWV1_I2CBus_t *bus;
+    uint32 b;
+    int32 status;
 
-    var1 = ((((adc_T >> 3) - ((int32)CalibData.dig_T1 << 1))) * 
-            ((int32)CalibData.dig_T2)) >> 11;
-    
-    var2 = (((((adc_T >> 4) - ((int32)CalibData.dig_T1)) * 
-             ((adc_T >> 4) - ((int32)CalibData.dig_T1))) >> 12) *
-            ((int32)CalibData.dig_T3)) >> 14;
-    
-    t_fine = var1 + var2;
-    T = (t_fine * 5 + 128) >> 8;
-    
-    return T;
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        Baro_Buses[b].TaskRunning = false;
+        if (Baro_Buses[b].TaskStarted)
+        {
+            OS_BinSemGive(Baro_Buses[b].Trigger);
+        }
+    }
+
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        bus = &Baro_Buses[b];
+        if (!bus->TaskStarted)
+        {
+            continue;
+        }
+
+        status = OS_BinSemTimedWait(bus->Done, FSWV1_BMP_TASK_POLL_MS * 2);
+        if (status != OS_SUCCESS)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_SENSOR_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1: %s reader task did not exit, RC = %d; deleting it",
+                             bus->Path, (int)status);
+            CFE_ES_DeleteChildTask(bus->TaskId);
+        }
+        bus->TaskStarted = false;
+    }
+
+    for (b = 0; b < Baro_BusCount; b++)
+    {
+        bus = &Baro_Buses[b];
+        if (bus->Fd >= 0)
+        {
+            OS_BinSemDelete(bus->Done);
+            OS_BinSemDelete(bus->Trigger);
+            OS_MutSemDelete(bus->Lock);
+            close(bus->Fd);
+            bus->Fd = -1;
+        }
+    }
+
+    Baro_Initialized = false;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Compensate pressure (from FSWV1 datasheet)                            */
+/* Get I2C bus statistics for housekeeping                                 */
+/* Totals over all buses; SampleTxns is the primary instance's last read. */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static uint32 FSWV1_CompensatePressure(int32 adc_P)
+void FSWV1_GetSensorBusStats(uint32 *Transactions, uint32 *Errors, uint32 *Bytes, uint32 *SampleTxns)
 {
-    int64 var1, var2, p;
+    uint32 b;
 
-    var1 = ((int64)t_fine) - 128000;
-    var2 = var1 * var1 * (int64)CalibData.dig_P6;
-    var2 = var2 + ((var1 * (int64)CalibData.dig_P5) << 17);
-    var2 = var2 + (((int64)CalibData.dig_P4) << 35);
-    var1 = ((var1 * var1 * (int64)CalibData.dig_P3) >> 8) +
-           ((var1 * (int64)CalibData.dig_P2) << 12);
-    var1 = (((((int64)1) << 47) + var1)) * ((int64)CalibData.dig_P1) >> 33;
+    *Transactions = 0;
+    *Errors = 0;
+    *Bytes = 0;
+    *SampleTxns = 0;
 
-    if (var1 == 0)
+    for (b = 0; b < Baro_BusCount; b++)
     {
-        return 0; /* Avoid division by zero */
+        *Transactions += Baro_Buses[b].Transactions;
+        *Errors += Baro_Buses[b].Errors;
+        *Bytes += Baro_Buses[b].Bytes;
     }
 
-    p = 1048576 - adc_P;
-    p = (((p << 31) - var2) * 3125) / var1;
-    var1 = (((int64)CalibData.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-    var2 = (((int64)CalibData.dig_P8) * p) >> 19;
-    p = ((p + var1 + var2) >> 8) + (((int64)CalibData.dig_P7) << 4);
+    if (FSWV1_BMP_PRIMARY_INSTANCE < BARO_DEVICE_COUNT)
+    {
+        *SampleTxns = Baro_Devices[FSWV1_BMP_PRIMARY_INSTANCE].SampleTxns;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Configured barometers, which are healthy, and the buses they are on    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetSensorInstances(uint8 *Configured, uint8 *HealthyMask, uint8 *Buses, uint8 *TaskMask)
+{
+    uint32 i;
+
+    *Configured = (uint8)BARO_DEVICE_COUNT;
+    *HealthyMask = 0;
+    *Buses = (uint8)Baro_BusCount;
+    *TaskMask = 0;
 
-    return (uint32)p;
+    for (i = 0; i < BARO_DEVICE_COUNT; i++)
+    {
+        if (Baro_Devices[i].Health == FSWV1_BMP_HEALTH_OK)
+        {
+            *HealthyMask |= (uint8)(1u << i);
+        }
+    }
+
+    for (i = 0; i < Baro_BusCount; i++)
+    {
+        if (Baro_Buses[i].TaskRunning)
+        {
+            *TaskMask |= (uint8)(1u << i);
+        }
+    }
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Close sensor                                                            */
+/* Health and counters of one barometer                                    */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-void FSWV1_CloseSensor(void)
+int32 FSWV1_GetSensorInstanceStats(uint8 Instance, FSWV1_BaroStats_t *Stats)
+{
+    const FSWV1_BaroDevice_t *dev;
+
+    if (Instance >= BARO_DEVICE_COUNT)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    dev = &Baro_Devices[Instance];
+    Stats->Health = dev->Health;
+    Stats->Chip = dev->Chip;
+    Stats->Samples = dev->Samples;
+    Stats->NotReady = dev->NotReady;
+    Stats->ReadErrors = dev->ReadErrors;
+    Stats->Recoveries = dev->Recoveries;
+    Stats->Dropped = dev->Dropped;
+    Stats->FifoFull = dev->FifoFull;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read pass counters of one bus                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_GetSensorBusPassStats(uint8 Bus, uint32 *Passes, uint32 *Overruns, uint32 *MaxPassUs)
 {
-    if (I2C_Fd >= 0)
+    if (Bus >= Baro_BusCount)
     {
-        close(I2C_Fd);
-        I2C_Fd = -1;
+        return CFE_ES_BAD_ARGUMENT;
     }
+
+    *Passes = Baro_Buses[Bus].Passes;
+    *Overruns = Baro_Buses[Bus].Overruns;
+    *MaxPassUs = Baro_Buses[Bus].MaxPassUs;
+
+    return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -454,7 +1175,7 @@ int32 FSWV1_SendUDP(const FSWV1_SensorData_t *SensorData, const FSWV1_IMUData_t
     {
         /* Don't spam errors - UDP is best effort */
         static uint32 error_count = 0;
-        if (error_count % 100 == 0)
+        if (error_count % 100 == 0 && !FSWV1_Deadline_Degraded())
         {
             OS_printf("FSWV1: UDP send error, RC = %d\n", (int)status);
         }
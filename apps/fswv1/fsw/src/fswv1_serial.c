@@ -0,0 +1,216 @@
+/******************************************************************************
+** File: fswv1_serial.c
+**
+** Purpose:
+**   This file contains the serial port setup shared by the IMU UART, the
+**   telemetry UART and uart_test.c: 8N1 raw mode at any baud rate,
+**   optional RTS/CTS flow control, and the driver's low-latency flag and
+**   transmit FIFO size.
+**
+** Notes:
+**   The port is configured through termios2 (TCGETS2/TCSETS2) with BOTHER,
+**   so rates above B115200, including ones without a Bxxx constant, are
+**   passed to the driver as plain numbers. The PL011 on the Raspberry Pi
+**   reaches 921600 and beyond with its default 48 MHz clock.
+**
+**   Low latency and the FIFO size are set with TIOCSSERIAL. Some drivers
+**   (many USB adapters) do not support it, or need CAP_SYS_ADMIN for the
+**   FIFO size; these are reported as warnings and the port is still used.
+**
+**   <asm/termbits.h> clashes with <termios.h>, so this file uses the
+**   ioctls directly and does not include <termios.h>.
+**
+******************************************************************************/
+
+#include "fswv1_serial.h"
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define SERIAL_BAUD_TOLERANCE_PCT  2
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Fail an open: close the descriptor, keep errno                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int SerialFail(int Fd, FSWV1_SerialInfo_t *Info, const char *Step)
+{
+    int saved_errno = errno;
+
+    if (Fd >= 0)
+    {
+        close(Fd);
+    }
+
+    if (Info != NULL)
+    {
+        Info->FailedStep = Step;
+    }
+
+    errno = saved_errno;
+    return -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Apply the optional driver settings (low latency, hardware FIFO depth)  */
+/* Returns FSWV1_SERIAL_WARN_xxx bits for settings that were refused.     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static unsigned SerialApplyDriverSettings(int Fd, const FSWV1_SerialConfig_t *Config)
+{
+    struct serial_struct ss;
+    unsigned warnings = 0;
+
+    if (!Config->LowLatency && Config->HwXmitFifoDepth <= 0)
+    {
+        return 0;
+    }
+
+    if (ioctl(Fd, TIOCGSERIAL, &ss) != 0)
+    {
+        return (Config->LowLatency ? FSWV1_SERIAL_WARN_LOW_LATENCY : 0) |
+               (Config->HwXmitFifoDepth > 0 ? FSWV1_SERIAL_WARN_HW_FIFO : 0);
+    }
+
+    if (Config->LowLatency)
+    {
+        ss.flags |= ASYNC_LOW_LATENCY;
+        if (ioctl(Fd, TIOCSSERIAL, &ss) != 0)
+        {
+            warnings |= FSWV1_SERIAL_WARN_LOW_LATENCY;
+            ss.flags &= ~ASYNC_LOW_LATENCY;
+        }
+    }
+
+    /*
+    ** Set separately: changing the FIFO depth may need privileges that low
+    ** latency does not. This is the depth of the UART's own transmit FIFO
+    ** as the driver sees it, not a kernel tty buffer; many drivers ignore it.
+    */
+    if (Config->HwXmitFifoDepth > 0)
+    {
+        ss.xmit_fifo_size = Config->HwXmitFifoDepth;
+        if (ioctl(Fd, TIOCSSERIAL, &ss) != 0)
+        {
+            warnings |= FSWV1_SERIAL_WARN_HW_FIFO;
+        }
+    }
+
+    return warnings;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Open and configure a serial port                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_Serial_Open(const char *Device, const FSWV1_SerialConfig_t *Config, FSWV1_SerialInfo_t *Info)
+{
+    struct termios2 tio;
+    uint32_t diff;
+    int fd;
+
+    if (Info != NULL)
+    {
+        Info->ActualBaud = 0;
+        Info->Warnings = 0;
+        Info->FailedStep = NULL;
+    }
+
+    if (Device == NULL || Config == NULL || Config->BaudRate == 0)
+    {
+        errno = EINVAL;
+        return SerialFail(-1, Info, "check arguments");
+    }
+
+    fd = open(Device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0)
+    {
+        return SerialFail(-1, Info, "open device");
+    }
+
+    if (ioctl(fd, TCGETS2, &tio) != 0)
+    {
+        return SerialFail(fd, Info, "get attributes");
+    }
+
+    /* Baud rate as a number (BOTHER), same for input and output */
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ospeed = Config->BaudRate;
+    tio.c_ispeed = Config->BaudRate;
+
+    /* 8N1 mode (8 data bits, no parity, 1 stop bit) */
+    tio.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+    tio.c_cflag |= CS8;
+    if (Config->FlowControl)
+    {
+        tio.c_cflag |= CRTSCTS;
+    }
+    else
+    {
+        tio.c_cflag &= ~CRTSCTS;
+    }
+    tio.c_cflag |= CREAD | CLOCAL;   /* Enable receiver, ignore modem lines */
+
+    /* Raw input and output */
+    tio.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG | IEXTEN);
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
+    tio.c_oflag &= ~OPOST;
+
+    tio.c_cc[VMIN] = Config->Vmin;
+    tio.c_cc[VTIME] = Config->Vtime;
+
+    if (ioctl(fd, TCSETS2, &tio) != 0)
+    {
+        return SerialFail(fd, Info, "set attributes");
+    }
+
+    /* Read back what the driver made of the rate */
+    if (ioctl(fd, TCGETS2, &tio) != 0)
+    {
+        return SerialFail(fd, Info, "read back attributes");
+    }
+
+    if (Info != NULL)
+    {
+        Info->ActualBaud = tio.c_ospeed;
+
+        diff = (tio.c_ospeed > Config->BaudRate) ? tio.c_ospeed - Config->BaudRate :
+                                                   Config->BaudRate - tio.c_ospeed;
+        if ((uint64_t)diff * 100 > (uint64_t)Config->BaudRate * SERIAL_BAUD_TOLERANCE_PCT)
+        {
+            Info->Warnings |= FSWV1_SERIAL_WARN_BAUD;
+        }
+
+        Info->Warnings |= SerialApplyDriverSettings(fd, Config);
+    }
+    else
+    {
+        (void)SerialApplyDriverSettings(fd, Config);
+    }
+
+    /* Flush any existing data */
+    ioctl(fd, TCFLSH, TCIOFLUSH);
+
+    return fd;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Close a serial port                                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Serial_Close(int Fd)
+{
+    if (Fd >= 0)
+    {
+        close(Fd);
+    }
+}
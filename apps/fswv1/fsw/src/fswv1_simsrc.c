@@ -0,0 +1,184 @@
+/******************************************************************************
+** File: fswv1_simsrc.c
+**
+** Purpose:
+**   This file contains the synthetic sensor source for the FSWV1 app. With
+**   the simulated time source (FSWV1_TIME_SOURCE_SIM) the barometer and
+**   IMU rate groups read it in place of the I2C buses and the IMU UARTs.
+**
+**   Sample k of a stream is due at k periods of simulated time
+**   (FSWV1_SIM_BMP_RATE_HZ, FSWV1_SIM_IMU_RATE_HZ) and its values are a
+**   function of k and FSWV1_SIM_SEED only: a slow triangle wave plus
+**   hashed noise. A read returns the samples due since the previous one,
+**   so what the app publishes depends on the simulated time line and not
+**   on how fast the host runs it.
+**
+** Notes:
+**   Only the primary barometer and IMU instances are simulated. Samples
+**   that do not fit in a read stay queued for the next one; none are
+**   dropped.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+
+#define SIMSRC_NS_PER_SEC     1000000000ULL
+#define SIMSRC_BMP_PERIOD_NS  (SIMSRC_NS_PER_SEC / FSWV1_SIM_BMP_RATE_HZ)
+#define SIMSRC_IMU_PERIOD_NS  (SIMSRC_NS_PER_SEC / FSWV1_SIM_IMU_RATE_HZ)
+
+/*
+** Noise streams, one per simulated quantity
+*/
+enum
+{
+    SIMSRC_BMP_TEMP,
+    SIMSRC_BMP_PRESS,
+    SIMSRC_IMU_AX,
+    SIMSRC_IMU_AY,
+    SIMSRC_IMU_AZ,
+    SIMSRC_IMU_GX,
+    SIMSRC_IMU_GY,
+    SIMSRC_IMU_GZ,
+    SIMSRC_IMU_TEMP
+};
+
+/*
+** Static variables
+*/
+static uint64 SimSrc_BmpNext = 1;        /* Next barometer sample to return */
+static uint64 SimSrc_BmpTriggered = 0;   /* Last barometer sample due at a trigger */
+static uint64 SimSrc_ImuNext = 1;        /* Next IMU sample to return */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Uniform noise in [-Amplitude, Amplitude] for sample Index of Stream    */
+/* A splitmix64 finalizer over the seed, stream and index: the same       */
+/* sample always gets the same noise.                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static float SimSrc_Noise(uint32 Stream, uint64 Index, float Amplitude)
+{
+    uint64 z = Index + ((uint64)FSWV1_SIM_SEED << 40) + ((uint64)Stream << 56);
+
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    return Amplitude * ((float)(z >> 40) / (float)(1ULL << 23) - 1.0f);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Triangle wave in [-1, 1] with the given period                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static float SimSrc_Triangle(uint64 TimeNs, uint64 PeriodNs)
+{
+    float phase = (float)(TimeNs % PeriodNs) / (float)PeriodNs;
+
+    return (phase < 0.5f) ? (4.0f * phase - 1.0f) : (3.0f - 4.0f * phase);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Restart both streams at simulated time zero                            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_SimSrc_Reset(void)
+{
+    SimSrc_BmpNext = 1;
+    SimSrc_BmpTriggered = 0;
+    SimSrc_ImuNext = 1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Barometer rate group: the samples due by now become readable           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SimSrc_TriggerSensors(void)
+{
+    SimSrc_BmpTriggered = FSWV1_Time_MonoNs() / SIMSRC_BMP_PERIOD_NS;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Collect the barometer samples made readable by the triggers so far     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SimSrc_ReadSensors(FSWV1_SensorData_t *Samples, uint32 MaxSamples, uint32 *Count)
+{
+    FSWV1_SensorData_t *s;
+    uint64 t;
+
+    if (Samples == NULL || Count == NULL)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    *Count = 0;
+
+    while (SimSrc_BmpNext <= SimSrc_BmpTriggered && *Count < MaxSamples)
+    {
+        t = SimSrc_BmpNext * SIMSRC_BMP_PERIOD_NS;
+        s = &Samples[(*Count)++];
+
+        s->Temperature = 20.0f + 2.0f * SimSrc_Triangle(t, 600 * SIMSRC_NS_PER_SEC) +
+                         SimSrc_Noise(SIMSRC_BMP_TEMP, SimSrc_BmpNext, 0.01f);
+        s->Pressure = 1013.25f + 0.5f * SimSrc_Triangle(t, 60 * SIMSRC_NS_PER_SEC) +
+                      SimSrc_Noise(SIMSRC_BMP_PRESS, SimSrc_BmpNext, 0.02f);
+        s->ArrivalNs = t;
+        s->Timestamp = FSWV1_Time_MonoToTime(t);
+        s->Instance = FSWV1_BMP_PRIMARY_INSTANCE;
+
+        SimSrc_BmpNext++;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Collect the IMU samples due since the last call, oldest first          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SimSrc_ReadIMU(FSWV1_IMUData_t *Samples, uint32 MaxSamples, uint32 *Count)
+{
+    FSWV1_IMUData_t *s;
+    uint64 due;
+    uint64 t;
+
+    if (Samples == NULL || Count == NULL)
+    {
+        return OS_INVALID_POINTER;
+    }
+
+    *Count = 0;
+    due = FSWV1_Time_MonoNs() / SIMSRC_IMU_PERIOD_NS;
+
+    while (SimSrc_ImuNext <= due && *Count < MaxSamples)
+    {
+        t = SimSrc_ImuNext * SIMSRC_IMU_PERIOD_NS;
+        s = &Samples[(*Count)++];
+
+        s->Accel_X = SimSrc_Noise(SIMSRC_IMU_AX, SimSrc_ImuNext, 0.02f);
+        s->Accel_Y = SimSrc_Noise(SIMSRC_IMU_AY, SimSrc_ImuNext, 0.02f);
+        s->Accel_Z = 9.81f + SimSrc_Noise(SIMSRC_IMU_AZ, SimSrc_ImuNext, 0.02f);
+        s->Gyro_X = 0.1f * SimSrc_Triangle(t, 10 * SIMSRC_NS_PER_SEC) +
+                    SimSrc_Noise(SIMSRC_IMU_GX, SimSrc_ImuNext, 0.005f);
+        s->Gyro_Y = SimSrc_Noise(SIMSRC_IMU_GY, SimSrc_ImuNext, 0.005f);
+        s->Gyro_Z = SimSrc_Noise(SIMSRC_IMU_GZ, SimSrc_ImuNext, 0.005f);
+        s->Temperature = 25.0f + 0.5f * SimSrc_Triangle(t, 600 * SIMSRC_NS_PER_SEC) +
+                         SimSrc_Noise(SIMSRC_IMU_TEMP, SimSrc_ImuNext, 0.01f);
+        s->ArrivalNs = t;
+        s->Timestamp = FSWV1_Time_MonoToTime(t);
+        s->Instance = FSWV1_IMU_PRIMARY_INSTANCE;
+
+        SimSrc_ImuNext++;
+    }
+
+    return CFE_SUCCESS;
+}
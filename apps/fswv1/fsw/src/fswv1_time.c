@@ -0,0 +1,163 @@
+/******************************************************************************
+** File: fswv1_time.c
+**
+** Purpose:
+**   This file contains the time source for the FSWV1 app. Every timestamp,
+**   monotonic reading and short wait in the app goes through here, so the
+**   whole app can run on either clock selected by FSWV1_APP_TIME_SOURCE:
+**
+**   - FSWV1_TIME_SOURCE_REAL: CFE time for timestamps, CLOCK_MONOTONIC for
+**     intervals, clock_nanosleep for waits.
+**   - FSWV1_TIME_SOURCE_SIM: a simulated clock owned by the main task. It
+**     only moves when a cycle tick or a wait advances it, so cycles run
+**     back-to-back as fast as the CPU allows and every timestamp depends
+**     only on the number of cycles run.
+**
+** Notes:
+**   In simulated mode the app reads no real clock and the sensors come from
+**   fswv1_simsrc.c, so two runs without ground commands produce identical
+**   sensor telemetry. Commands still arrive in real time. Stage timings
+**   (perf probes, deadline monitor) read simulated time as well and stay at
+**   zero.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <time.h>
+#include <errno.h>
+
+#define TIME_NS_PER_SEC 1000000000ULL
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Convert a nanosecond count to CFE seconds/subseconds                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static CFE_TIME_SysTime_t TimeFromNs(uint64 Ns)
+{
+    CFE_TIME_SysTime_t time;
+    uint64 frac_ns = Ns % TIME_NS_PER_SEC;
+
+    time.Seconds = (uint32)(Ns / TIME_NS_PER_SEC);
+    time.Subseconds = (uint32)((frac_ns << 32) / TIME_NS_PER_SEC);
+
+    return time;
+}
+
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+/*
+** Static variables
+*/
+static uint64 Time_SimNs = 0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Advance the simulated clock by one cycle period                         */
+/* Returns false once FSWV1_SIM_DURATION_S has been simulated.             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool FSWV1_Time_SimTick(void)
+{
+    if (FSWV1_SIM_DURATION_S != 0 &&
+        Time_SimNs >= (uint64)FSWV1_SIM_DURATION_S * TIME_NS_PER_SEC)
+    {
+        return false;
+    }
+
+    Time_SimNs += TIME_NS_PER_SEC / FSWV1_APP_CYCLE_RATE_HZ;
+
+    return true;
+}
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Monotonic time in nanoseconds                                           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 FSWV1_Time_MonoNs(void)
+{
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    return Time_SimNs;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64)ts.tv_sec * TIME_NS_PER_SEC) + (uint64)ts.tv_nsec;
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Current CFE time                                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_TIME_SysTime_t FSWV1_Time_GetTime(void)
+{
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    return FSWV1_Time_MonoToTime(Time_SimNs);
+#else
+    return CFE_TIME_GetTime();
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* CFE time at which the monotonic clock read MonoNs                      */
+/* Real: the current CFE time minus the monotonic time elapsed since      */
+/* MonoNs. Convert soon after capture so a CFE time adjustment in between */
+/* does not shift the result.                                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_TIME_SysTime_t FSWV1_Time_MonoToTime(uint64 MonoNs)
+{
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    CFE_TIME_SysTime_t time = TimeFromNs(MonoNs);
+
+    time.Seconds += FSWV1_SIM_EPOCH_SECONDS;
+
+    return time;
+#else
+    CFE_TIME_SysTime_t now = CFE_TIME_GetTime();
+    uint64 mono_now = FSWV1_Time_MonoNs();
+
+    if (MonoNs >= mono_now)
+    {
+        return now;
+    }
+
+    return CFE_TIME_Subtract(now, TimeFromNs(mono_now - MonoNs));
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Wait for a short time (simulated: just advance the clock)               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Time_SleepNs(uint64 Ns)
+{
+#if FSWV1_APP_TIME_SOURCE == FSWV1_TIME_SOURCE_SIM
+    Time_SimNs += Ns;
+#else
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(Ns / TIME_NS_PER_SEC);
+    ts.tv_nsec = (long)(Ns % TIME_NS_PER_SEC);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR)
+    {
+    }
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Timestamp a message with the current time                               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_Time_StampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+    CFE_MSG_SetMsgTime(MsgPtr, FSWV1_Time_GetTime());
+}
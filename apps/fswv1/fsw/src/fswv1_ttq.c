@@ -0,0 +1,281 @@
+/******************************************************************************
+** File: fswv1_ttq.c
+**
+** Purpose:
+**   This file contains the time-tagged command queue for the FSWV1 app.
+**   TIME_TAG_CC wraps any fswv1 command code and its arguments with an
+**   absolute CFE time. Tagged commands are kept in a fixed-capacity binary
+**   min-heap ordered by execution time and run through
+**   FSWV1_APP_ProcessGroundCommand when their time comes.
+**
+** Notes:
+**   FSWV1_TTQ_Process() runs once per main loop pass. A command due before
+**   the next pass (FSWV1_TTQ_LOOKAHEAD_US, one wakeup period, after the
+**   cycle start, or FSWV1_APP_WAKEUP_TIMEOUT_MS after a wakeup timeout) is
+**   not left for the next pass: the main task sleeps until the tag and runs
+**   it then, so execution accuracy is not limited by the cycle rate. The
+**   window is fixed when the call starts, so a chain of closely spaced
+**   tags cannot hold the main task past the next wakeup.
+**
+**   Commands with equal tags run in the order they were queued.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include <string.h>
+
+/*
+** Queued command
+*/
+typedef struct
+{
+    uint64 ExecTime;        /* CFE time as seconds << 32 | subseconds */
+    uint32 Seq;             /* Queue order, breaks ties between equal tags */
+    uint8  CommandCode;
+    uint16 ArgLength;
+    uint8  Args[FSWV1_TTQ_MAX_ARG_BYTES];
+} FSWV1_TTQEntry_t;
+
+/*
+** Command message rebuilt for execution
+*/
+typedef union
+{
+    CFE_SB_Buffer_t SBBuf;
+    uint8 Bytes[sizeof(CFE_MSG_CommandHeader_t) + FSWV1_TTQ_MAX_ARG_BYTES];
+} FSWV1_TTQCmdBuf_t;
+
+/*
+** Static variables
+*/
+static FSWV1_TTQEntry_t TTQ_Heap[FSWV1_TTQ_CAPACITY];
+static uint32 TTQ_Count = 0;
+static uint32 TTQ_NextSeq = 0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* CFE time <-> 32.32 fixed point helpers                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint64 TTQTimeToTicks(CFE_TIME_SysTime_t Time)
+{
+    return ((uint64)Time.Seconds << 32) | Time.Subseconds;
+}
+
+static uint64 TTQTicksToUs(uint64 Ticks)
+{
+    return (Ticks >> 32) * 1000000ULL + (((Ticks & 0xFFFFFFFFULL) * 1000000ULL) >> 32);
+}
+
+static uint64 TTQUsToTicks(uint64 Us)
+{
+    return ((Us / 1000000ULL) << 32) | (((Us % 1000000ULL) << 32) / 1000000ULL);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Heap ordering: earlier tag first, then earlier queue order              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool TTQBefore(const FSWV1_TTQEntry_t *A, const FSWV1_TTQEntry_t *B)
+{
+    if (A->ExecTime != B->ExecTime)
+    {
+        return A->ExecTime < B->ExecTime;
+    }
+
+    /* Wrap-safe sequence comparison */
+    return (int32)(A->Seq - B->Seq) < 0;
+}
+
+static void TTQSwap(uint32 A, uint32 B)
+{
+    FSWV1_TTQEntry_t tmp = TTQ_Heap[A];
+
+    TTQ_Heap[A] = TTQ_Heap[B];
+    TTQ_Heap[B] = tmp;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Remove the root entry                                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TTQPopRoot(FSWV1_TTQEntry_t *Entry)
+{
+    uint32 i = 0;
+    uint32 child;
+
+    *Entry = TTQ_Heap[0];
+    TTQ_Count--;
+    TTQ_Heap[0] = TTQ_Heap[TTQ_Count];
+
+    while ((child = 2 * i + 1) < TTQ_Count)
+    {
+        if (child + 1 < TTQ_Count && TTQBefore(&TTQ_Heap[child + 1], &TTQ_Heap[child]))
+        {
+            child++;
+        }
+
+        if (!TTQBefore(&TTQ_Heap[child], &TTQ_Heap[i]))
+        {
+            break;
+        }
+
+        TTQSwap(i, child);
+        i = child;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Rebuild the wrapped command and execute it                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TTQExecute(const FSWV1_TTQEntry_t *Entry)
+{
+    FSWV1_TTQCmdBuf_t cmd;
+
+    memset(&cmd, 0, sizeof(cmd));
+    CFE_MSG_Init(&cmd.SBBuf.Msg, CFE_SB_ValueToMsgId(FSWV1_APP_CMD_MID),
+                 sizeof(CFE_MSG_CommandHeader_t) + Entry->ArgLength);
+    CFE_MSG_SetFcnCode(&cmd.SBBuf.Msg, Entry->CommandCode);
+    memcpy(&cmd.Bytes[sizeof(CFE_MSG_CommandHeader_t)], Entry->Args, Entry->ArgLength);
+
+    FSWV1_APP_ProcessGroundCommand(&cmd.SBBuf);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Initialize the queue and its statistics                                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_TTQ_Init(void)
+{
+    memset(&FSWV1_APP_Data.Ttq, 0, sizeof(FSWV1_APP_Data.Ttq));
+    TTQ_Count = 0;
+    TTQ_NextSeq = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Empty the queue                                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_TTQ_Clear(void)
+{
+    TTQ_Count = 0;
+    FSWV1_APP_Data.Ttq.Occupancy = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Queue a command for execution at an absolute CFE time                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_TTQ_Insert(CFE_TIME_SysTime_t ExecTime, uint8 CommandCode, const uint8 *Args, uint16 ArgLength)
+{
+    FSWV1_TTQEntry_t *entry;
+    uint32 i;
+    uint32 parent;
+
+    if (ArgLength > FSWV1_TTQ_MAX_ARG_BYTES || CommandCode == FSWV1_APP_TIME_TAG_CC)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    if (TTQ_Count >= FSWV1_TTQ_CAPACITY)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    i = TTQ_Count++;
+    entry = &TTQ_Heap[i];
+    entry->ExecTime = TTQTimeToTicks(ExecTime);
+    entry->Seq = TTQ_NextSeq++;
+    entry->CommandCode = CommandCode;
+    entry->ArgLength = ArgLength;
+    memcpy(entry->Args, Args, ArgLength);
+
+    while (i > 0)
+    {
+        parent = (i - 1) / 2;
+        if (!TTQBefore(&TTQ_Heap[i], &TTQ_Heap[parent]))
+        {
+            break;
+        }
+        TTQSwap(i, parent);
+        i = parent;
+    }
+
+    FSWV1_APP_Data.Ttq.Occupancy = TTQ_Count;
+    if (TTQ_Count > FSWV1_APP_Data.Ttq.HighWater)
+    {
+        FSWV1_APP_Data.Ttq.HighWater = TTQ_Count;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Run every command that is due, waiting for any that falls due before   */
+/* WindowEndNs (FSWV1_Time_MonoNs time, normally the next wakeup).        */
+/* Anything tagged later is left for the next cycle.                       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_TTQ_Process(uint64 WindowEndNs)
+{
+    FSWV1_TTQEntry_t entry;
+    uint64 now;
+    uint64 mono;
+    uint64 window_end;
+    uint64 late_us;
+
+    if (TTQ_Count == 0)
+    {
+        return;
+    }
+
+    /* Map the window end onto CFE time once; it does not move while we run */
+    mono = FSWV1_Time_MonoNs();
+    now = TTQTimeToTicks(FSWV1_Time_GetTime());
+    window_end = now;
+    if (WindowEndNs > mono)
+    {
+        window_end += TTQUsToTicks((WindowEndNs - mono) / 1000);
+    }
+
+    while (TTQ_Count > 0)
+    {
+        now = TTQTimeToTicks(FSWV1_Time_GetTime());
+
+        if (TTQ_Heap[0].ExecTime > now)
+        {
+            /* Not due yet: wait for it only if it falls inside this cycle's window */
+            if (TTQ_Heap[0].ExecTime >= window_end)
+            {
+                break;
+            }
+
+            FSWV1_Time_SleepNs(TTQTicksToUs(TTQ_Heap[0].ExecTime - now) * 1000);
+            now = TTQTimeToTicks(FSWV1_Time_GetTime());
+        }
+
+        TTQPopRoot(&entry);
+        FSWV1_APP_Data.Ttq.Occupancy = TTQ_Count;
+
+        late_us = (now > entry.ExecTime) ? TTQTicksToUs(now - entry.ExecTime) : 0;
+        if (late_us > FSWV1_TTQ_LATE_TOLERANCE_US)
+        {
+            FSWV1_APP_Data.Ttq.LateCount++;
+        }
+        if (late_us > FSWV1_APP_Data.Ttq.MaxLateUs)
+        {
+            FSWV1_APP_Data.Ttq.MaxLateUs = (late_us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32)late_us;
+        }
+
+        TTQExecute(&entry);
+        FSWV1_APP_Data.Ttq.ExecutedCount++;
+    }
+}
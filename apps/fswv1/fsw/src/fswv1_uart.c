@@ -4,6 +4,8 @@
 ** Purpose:
 **   This file contains UART interface functions for receiving IMU data.
 **   Receives formatted string: "$,Ax,Ay,Az,Gx,Gy,Gz,Temperature,#"
+**   or, selected by command or auto-detected, the compact COBS/CRC-16
+**   binary frame described in fswv1_imu_parse.h.
 **
 ** Expected Format:
 **   "$,0.05,-0.12,9.81,0.01,-0.02,0.00,25.5,#"
@@ -14,15 +16,31 @@
 **   - Gx, Gy, Gz: Gyroscope (deg/s or rad/s)
 **   - Temperature: degrees Celsius
 **
+** Notes:
+**   Each device in UART_DEVICES is an IMU instance (channel) with its own
+**   descriptor, framers, statistics and sample ring. One reader (the IMU
+**   child task, or the event loop) services every channel, and
+**   FSWV1_ReadUARTFrames merges the rings into a single stream in
+**   ArrivalNs order, each sample tagged with its instance.
+**
+**   The merge must not hand out a sample while a quiet channel might still
+**   produce an earlier one. Every channel keeps a watermark, DrainedNs: a
+**   read() that found the tty empty proves that everything which arrived
+**   before it has been framed. A ring head is released only once every
+**   other empty channel's watermark has passed it, and samples framed
+**   later are stamped after the watermark, so the merged stream never
+**   goes back in time.
+**
 ******************************************************************************/
 
 #include "fswv1_app.h"
-#include <fcntl.h>
-#include <termios.h>
+#include "fswv1_imu_parse.h"
+#include "fswv1_serial.h"
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
+#include <poll.h>
 
 /*
 ** UART Configuration
@@ -30,224 +48,1378 @@
 ** - /dev/ttyAMA0 - Primary UART (GPIO 14/15) on Raspberry Pi
 ** - /dev/ttyS0   - Alternative UART
 ** - /dev/ttyUSB0 - USB-to-Serial adapter
+**
+** For several IMUs, set UART_DEVICES to a comma-separated list of device
+** strings; entry n is IMU instance n. All channels share the settings
+** below.
+**
+** UART_BAUD is a plain number; any rate the driver supports works
+** (e.g. 921600). Each setting can be overridden with a compile definition.
 */
-#define UART_DEVICE "/dev/ttyAMA0"  
-#define UART_BAUDRATE B115200        
+#ifndef UART_DEVICE
+#define UART_DEVICE "/dev/ttyAMA0"
+#endif
+#ifndef UART_DEVICES
+#define UART_DEVICES UART_DEVICE
+#endif
+#ifndef UART_BAUD
+#define UART_BAUD 115200
+#endif
+#ifndef UART_FLOW_CONTROL
+#define UART_FLOW_CONTROL 0          /* 1 = RTS/CTS hardware flow control */
+#endif
+#ifndef UART_LOW_LATENCY
+#define UART_LOW_LATENCY 1           /* Ask the driver to push received bytes at once */
+#endif
+#ifndef UART_HW_XMIT_FIFO_DEPTH
+#define UART_HW_XMIT_FIFO_DEPTH 0    /* UART hardware transmit FIFO depth, 0 = driver default */
+#endif
 #define UART_BUFFER_SIZE 256
+#ifndef UART_RX_CHUNK_SIZE
+#define UART_RX_CHUNK_SIZE 1024      /* Bytes requested per read() */
+#endif
+
+static const char *const UART_DeviceTable[] = { UART_DEVICES };
+
+#define UART_CHANNEL_COUNT (sizeof(UART_DeviceTable) / sizeof(UART_DeviceTable[0]))
+
+CompileTimeAssert(UART_CHANNEL_COUNT <= FSWV1_IMU_MAX_INSTANCES, UartDevicesExceedImuInstances);
+
+/*
+** Framer results
+*/
+#define UART_RX_NONE       0   /* Byte consumed, no frame complete */
+#define UART_RX_FRAME      1   /* Frame decoded into the sample */
+#define UART_RX_BAD_FRAME  2   /* ASCII frame did not parse */
+#define UART_RX_BAD_CRC    3   /* Binary frame failed its CRC */
+#define UART_RX_RESYNC     4   /* Binary framing lost; resynchronized on the next delimiter */
+#define UART_RX_OVERFLOW   5   /* ASCII frame longer than the buffer, discarded */
+#define UART_RX_TRUNCATED  6   /* ASCII frame cut short ('$' before '#', or '#' without '$') */
+
+/*
+** Smoothing of the inter-arrival statistics: each new interval moves the
+** averages by 1/16 of the difference (as RFC 3550 jitter)
+*/
+#define UART_INTERVAL_SHIFT 4
+
+/*
+** IMU channel (one per entry of UART_DEVICES)
+** Everything but the statistics and the ring tail belongs to the reading
+** context: the reader task while IMUTask_Running is set, otherwise the
+** main task (event loop or FSWV1_ReadUARTFrames).
+*/
+typedef struct
+{
+    const char *Device;
+    int         Fd;                 /* -1 = not open */
+    uint8       Instance;
+
+    /*
+    ** ASCII frame assembly
+    */
+    char   Buffer[UART_BUFFER_SIZE];
+    int    BufferPos;
+    bool   AsciiDiscard;            /* Skipping the rest of an overflowed frame */
+
+    /*
+    ** Receive chunk: each read() takes everything the tty has buffered (up
+    ** to UART_RX_CHUNK_SIZE) and frames are then scanned out of it in user
+    ** space. RxPos..RxLen is the unscanned part; it is always used up
+    ** before the next read(), so no wrap-around is needed.
+    */
+    uint8  RxChunk[UART_RX_CHUNK_SIZE];
+    size_t RxLen;
+    size_t RxPos;
+    uint64 ChunkNs;                 /* When the current chunk was read */
+    uint64 ByteNs;                  /* Time one byte takes on the wire (10 bits) */
+
+    /*
+    ** Merge ordering: DrainedNs is published (release) when a read() finds
+    ** the tty empty; FloorNs is the earliest ArrivalNs the next sample may
+    ** carry.
+    */
+    uint64 DrainedNs;
+    uint64 FloorNs;
+
+    /*
+    ** Binary (COBS) frame assembly, bytes since the last 0x00 delimiter
+    */
+    uint8  BinBuffer[FSWV1_IMU_BIN_MAX_ENCODED];
+    size_t BinPos;
+    bool   BinDiscard;
+
+    /*
+    ** Wire format (FSWV1_IMU_FORMAT_xxx)
+    ** Format follows the commanded format; FormatActive is the format being
+    ** decoded, and under AUTO reads FSWV1_IMU_FORMAT_AUTO until a format
+    ** has been detected.
+    */
+    uint8  Format;
+    uint8  FormatActive;
+    uint32 BadStreak;               /* Unusable frames since the last good one */
+    uint32 BytesNoFrame;            /* Bytes since the last good frame */
+
+    /*
+    ** Sender frame counter tracking. The framer that completes a frame
+    ** leaves its counter in FrameSeq; binary counters wrap at 256, ASCII
+    ** counters at 2^32. A jump forward of less than half the range counts
+    ** as lost frames, anything else as a sender restart.
+    */
+    uint32 FrameSeq;
+    uint32 FrameSeqMask;            /* 0 = frame had no counter */
+    bool   SeqValid;
+    uint32 SeqExpected;
+    uint8  SeqFormat;               /* Format of the last good frame */
+
+    /*
+    ** Inter-arrival statistics of good frames (ArrivalNs)
+    */
+    uint64 LastArrivalNs;
+    int64  LastIntervalNs;
+    int64  IntervalAvgNs;
+    int64  JitterNs;
+
+    /*
+    ** Statistics (written by the reading context, read by housekeeping)
+    */
+    uint32 ReadCalls;
+    uint32 BytesRead;
+    uint32 ReadErrors;
+    uint32 ParseErrors;
+    uint32 CrcErrors;
+    uint32 Resyncs;
+    uint32 Overflows;
+    uint32 Truncated;
+    uint32 FramesGood;
+    uint32 SeqGaps;
+    uint32 SeqLost;
+    uint32 SeqResets;
+    uint32 IntervalUs;
+    uint32 JitterUs;
+    uint32 MaxIntervalUs;
+
+    /*
+    ** Samples framed on this channel, waiting for the merge
+    */
+    FSWV1_IMURing_t Ring;
+} FSWV1_UARTChannel_t;
 
 /*
 ** Static variables
 */
 static bool UART_Initialized = false;
-static int uart_fd = -1;
-static char uart_buffer[UART_BUFFER_SIZE];
-static int buffer_pos = 0;
+static FSWV1_UARTChannel_t UART_Channels[UART_CHANNEL_COUNT];
+static uint32 UART_OpenCount = 0;
+
+/*
+** Commanded wire format, written by FSWV1_SetIMUFormat and picked up by
+** the reading context on every channel
+*/
+static uint8 rx_format_cmd = FSWV1_IMU_FORMAT;
+
+/*
+** Field of the most recent ASCII parse failure on any channel
+*/
+static uint32 rx_last_bad_field = 0;
+
+/*
+** Samples dropped because a drain batch was full (consumer only)
+*/
+static uint32 rx_drain_dropped = 0;
+
+/*
+** IMU reader child task state
+** While IMUTask_Running is set the task owns the channels' descriptors
+** and framers; otherwise the event loop (FSWV1_ServiceUART) or
+** FSWV1_ReadUARTFrames reads them. The main task consumes the rings.
+*/
+static CFE_ES_TaskId_t IMUTask_Id;
+static volatile bool IMUTask_Running = false;
+static osal_id_t IMUTask_Done = OS_OBJECT_ID_UNDEFINED;   /* Given by the task on exit */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Restart a channel's framers, chunk and tracking state                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void UART_ResetChannel(FSWV1_UARTChannel_t *ch)
+{
+    ch->BufferPos = 0;
+    ch->AsciiDiscard = false;
+    ch->BinPos = 0;
+    ch->BinDiscard = false;
+    ch->BadStreak = 0;
+    ch->BytesNoFrame = 0;
+    ch->RxLen = 0;
+    ch->RxPos = 0;
+    ch->DrainedNs = 0;
+    ch->FloorNs = 0;
+    ch->SeqFormat = FSWV1_IMU_FORMAT_AUTO;   /* Restart counter and interval tracking */
+    FSWV1_IMURing_Init(&ch->Ring);
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
 /* Initialize UART for IMU data reception                                 */
+/* Succeeds when at least one channel opens; the others are left closed.  */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 int32 FSWV1_InitUART(void)
 {
-    struct termios tty;
-    
+    FSWV1_SerialConfig_t config;
+    FSWV1_SerialInfo_t info;
+    FSWV1_UARTChannel_t *ch;
+    uint8 format;
+    uint32 i;
+
     if (UART_Initialized)
     {
         return CFE_SUCCESS;
     }
-    
-    OS_printf("FSWV1_UART: Initializing UART on %s at 115200 baud...\n", UART_DEVICE);
-    
-    /* Open UART device */
-    uart_fd = open(UART_DEVICE, O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (uart_fd < 0)
-    {
-        CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_UART: Failed to open %s: %s", UART_DEVICE, strerror(errno));
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
-    }
-    
-    /* Get current settings */
-    if (tcgetattr(uart_fd, &tty) != 0)
+
+    OS_printf("FSWV1_UART: Initializing %u IMU UART(s) at %u baud...\n",
+              (unsigned)UART_CHANNEL_COUNT, (unsigned)UART_BAUD);
+
+    /* Open and configure the ports (8N1, raw, non-blocking read with 0.1 s timeout) */
+    memset(&config, 0, sizeof(config));
+    config.BaudRate = UART_BAUD;
+    config.FlowControl = UART_FLOW_CONTROL;
+    config.LowLatency = UART_LOW_LATENCY;
+    config.HwXmitFifoDepth = UART_HW_XMIT_FIFO_DEPTH;
+    config.Vmin = 0;
+    config.Vtime = 1;
+
+    format = __atomic_load_n(&rx_format_cmd, __ATOMIC_RELAXED);
+    UART_OpenCount = 0;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_UART: Failed to get UART attributes");
-        close(uart_fd);
-        uart_fd = -1;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        ch = &UART_Channels[i];
+        ch->Device = UART_DeviceTable[i];
+        ch->Instance = (uint8)i;
+        ch->Format = format;
+        ch->FormatActive = format;
+        UART_ResetChannel(ch);
+
+        ch->Fd = FSWV1_Serial_Open(ch->Device, &config, &info);
+        if (ch->Fd < 0)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_UART: IMU %u: %s failed for %s: %s",
+                             (unsigned)i, info.FailedStep, ch->Device, strerror(errno));
+            continue;
+        }
+
+        ch->ByteNs = (info.ActualBaud > 0) ? 10000000000ULL / info.ActualBaud : 0;
+        UART_OpenCount++;
+
+        CFE_EVS_SendEvent(FSWV1_APP_UART_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                         "FSWV1_UART: IMU %u on %s at %u baud (flow control %s, warnings 0x%X)",
+                         (unsigned)i, ch->Device, (unsigned)info.ActualBaud,
+                         UART_FLOW_CONTROL ? "on" : "off", info.Warnings);
     }
-    
-    /* Configure UART settings */
-    cfsetospeed(&tty, UART_BAUDRATE);
-    cfsetispeed(&tty, UART_BAUDRATE);
-    
-    /* 8N1 mode (8 data bits, no parity, 1 stop bit) */
-    tty.c_cflag &= ~PARENB;        /* No parity */
-    tty.c_cflag &= ~CSTOPB;        /* 1 stop bit */
-    tty.c_cflag &= ~CSIZE;
-    tty.c_cflag |= CS8;            /* 8 data bits */
-    tty.c_cflag &= ~0020000000000;  /* CRTSCTS - No hardware flow control */       /* No hardware flow control */
-    tty.c_cflag |= CREAD | CLOCAL; /* Enable receiver, ignore modem lines */
-    
-    /* Raw input mode */
-    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-    tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
-    
-    /* Raw output mode */
-    tty.c_oflag &= ~OPOST;
-    
-    /* Non-blocking read with timeout */
-    tty.c_cc[VMIN] = 0;   /* Non-blocking */
-    tty.c_cc[VTIME] = 1;  /* 0.1 second timeout */
-    
-    /* Apply settings */
-    if (tcsetattr(uart_fd, TCSANOW, &tty) != 0)
+
+    if (UART_OpenCount == 0)
     {
-        CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_UART: Failed to set UART attributes");
-        close(uart_fd);
-        uart_fd = -1;
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
-    
-    /* Flush any existing data */
-    tcflush(uart_fd, TCIOFLUSH);
-    
-    buffer_pos = 0;
+
     UART_Initialized = true;
-    
-    CFE_EVS_SendEvent(FSWV1_APP_UART_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
-                     "FSWV1_UART: UART initialized on %s at 115200 baud", UART_DEVICE);
-    
-    OS_printf("FSWV1_UART: Ready to receive IMU data\n");
-    
+
+    OS_printf("FSWV1_UART: Ready to receive IMU data (%u of %u channels)\n",
+              (unsigned)UART_OpenCount, (unsigned)UART_CHANNEL_COUNT);
+
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Parse IMU data from formatted string                                   */
+/* Store one decoded frame (either wire format) into an IMU sample        */
+/* The frame's last byte arrived before the bytes still left in the       */
+/* chunk; back the read() time off by their time on the wire. The result  */
+/* is kept after the channel's watermark and its previous sample.         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void StoreIMUValues(FSWV1_UARTChannel_t *ch, const float values[FSWV1_IMU_PARSE_FIELDS],
+                           FSWV1_IMUData_t *data)
+{
+    uint64 arrival;
+
+    data->Accel_X = values[0];
+    data->Accel_Y = values[1];
+    data->Accel_Z = values[2];
+    data->Gyro_X = values[3];
+    data->Gyro_Y = values[4];
+    data->Gyro_Z = values[5];
+    data->Temperature = values[6];
+    data->Instance = ch->Instance;
+
+    /* Arrival time of the terminating byte */
+    arrival = ch->ChunkNs - (uint64)(ch->RxLen - ch->RxPos) * ch->ByteNs;
+    if (arrival < ch->FloorNs)
+    {
+        arrival = ch->FloorNs;
+    }
+    ch->FloorNs = arrival;
+
+    data->ArrivalNs = arrival;
+    data->Timestamp = FSWV1_Time_MonoToTime(arrival);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Feed one byte to the ASCII framer                                       */
 /* Format: "$,Ax,Ay,Az,Gx,Gy,Gz,Temperature,#"                           */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-static int32 ParseIMUData(const char *str, FSWV1_IMUData_t *data)
+static int32 RxAsciiByte(FSWV1_UARTChannel_t *ch, char byte, FSWV1_IMUData_t *data, int *bad_field)
 {
-    int parsed;
-    
-    /* Parse the format: $,Ax,Ay,Az,Gx,Gy,Gz,Temp,# */
-    parsed = sscanf(str, "$,%f,%f,%f,%f,%f,%f,%f,#",
-                    &data->Accel_X,
-                    &data->Accel_Y,
-                    &data->Accel_Z,
-                    &data->Gyro_X,
-                    &data->Gyro_Y,
-                    &data->Gyro_Z,
-                    &data->Temperature);
-    
-    if (parsed != 7)
+    float values[FSWV1_IMU_PARSE_FIELDS];
+    int has_seq;
+    bool truncated;
+
+    /* Look for start marker '$' */
+    if (byte == '$')
     {
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        truncated = (ch->BufferPos > 0);
+        ch->AsciiDiscard = false;
+        ch->BufferPos = 0;
+        ch->Buffer[ch->BufferPos++] = byte;
+
+        return truncated ? UART_RX_TRUNCATED : UART_RX_NONE;
     }
-    
-    /* Update timestamp */
-    data->Timestamp = CFE_TIME_GetTime().Seconds;
-    
-    return CFE_SUCCESS;
+    /* Look for end marker '#' */
+    else if (byte == '#')
+    {
+        if (ch->BufferPos > 0 && ch->BufferPos < UART_BUFFER_SIZE - 1)
+        {
+            ch->Buffer[ch->BufferPos++] = byte;
+            ch->Buffer[ch->BufferPos] = '\0';
+            ch->BufferPos = 0;
+
+            /* Parse the complete message; a frame without "$," reports field 0 */
+            *bad_field = 0;
+            if (FSWV1_IMU_ParseFrameSeq(ch->Buffer, values, bad_field,
+                                        &ch->FrameSeq, &has_seq) != FSWV1_IMU_PARSE_OK)
+            {
+                return UART_RX_BAD_FRAME;
+            }
+
+            ch->FrameSeqMask = has_seq ? 0xFFFFFFFF : 0;
+            StoreIMUValues(ch, values, data);
+            return UART_RX_FRAME;
+        }
+
+        if (ch->BufferPos > 0)
+        {
+            ch->BufferPos = 0;
+            return UART_RX_OVERFLOW;
+        }
+
+        /* End of an overflowed frame (already counted), or a frame whose start was lost */
+        if (ch->AsciiDiscard)
+        {
+            ch->AsciiDiscard = false;
+            return UART_RX_NONE;
+        }
+        return UART_RX_TRUNCATED;
+    }
+    /* Accumulate data between $ and # */
+    else if (ch->BufferPos > 0 && ch->BufferPos < UART_BUFFER_SIZE - 1)
+    {
+        ch->Buffer[ch->BufferPos++] = byte;
+    }
+    /* Buffer overflow protection: drop the frame up to its '#' */
+    else if (ch->BufferPos >= UART_BUFFER_SIZE - 1)
+    {
+        ch->BufferPos = 0;
+        ch->AsciiDiscard = true;
+        return UART_RX_OVERFLOW;
+    }
+
+    return UART_RX_NONE;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Read and parse IMU data from UART                                      */
+/* Feed one byte to the binary (COBS) framer                               */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-int32 FSWV1_ReadUART(FSWV1_IMUData_t *data)
+static int32 RxBinaryByte(FSWV1_UARTChannel_t *ch, uint8 byte, FSWV1_IMUData_t *data)
 {
-    char byte;
-    ssize_t bytes_read;
-    
-    if (!UART_Initialized || uart_fd < 0)
+    float values[FSWV1_IMU_PARSE_FIELDS];
+    uint8 seq;
+    int status;
+
+    if (byte != 0)
     {
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        if (ch->BinPos < sizeof(ch->BinBuffer))
+        {
+            if (!ch->BinDiscard)
+            {
+                ch->BinBuffer[ch->BinPos] = byte;
+            }
+            ch->BinPos++;
+            return UART_RX_NONE;
+        }
+
+        /*
+        ** Too long to be a frame: skip to the next delimiter, reporting
+        ** framing lost again for every frame length skipped
+        */
+        ch->BinPos = 0;
+        ch->BinDiscard = true;
+        return UART_RX_RESYNC;
     }
-    
-    if (data == NULL)
+
+    /* Delimiter */
+    if (ch->BinDiscard)
     {
-        return OS_INVALID_POINTER;
+        ch->BinDiscard = false;
+        ch->BinPos = 0;
+        return UART_RX_NONE;
+    }
+
+    if (ch->BinPos == 0)
+    {
+        return UART_RX_NONE;   /* Back-to-back delimiters are idle fill */
+    }
+
+    status = FSWV1_IMU_ParseBinary(ch->BinBuffer, ch->BinPos, values, &seq);
+    ch->BinPos = 0;
+
+    if (status == FSWV1_IMU_PARSE_BAD_CRC)
+    {
+        return UART_RX_BAD_CRC;
+    }
+    if (status != FSWV1_IMU_PARSE_OK)
+    {
+        return UART_RX_RESYNC;
+    }
+
+    ch->FrameSeq = seq;
+    ch->FrameSeqMask = 0xFF;
+    StoreIMUValues(ch, values, data);
+    return UART_RX_FRAME;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Restart both framers and the AUTO loss detection                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxResetFramers(FSWV1_UARTChannel_t *ch)
+{
+    ch->BadStreak = 0;
+    ch->BytesNoFrame = 0;
+    ch->BufferPos = 0;
+    ch->AsciiDiscard = false;
+    ch->BinPos = 0;
+    ch->BinDiscard = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Pick up a wire format change commanded by FSWV1_SetIMUFormat           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxApplyFormat(FSWV1_UARTChannel_t *ch)
+{
+    uint8 format = __atomic_load_n(&rx_format_cmd, __ATOMIC_RELAXED);
+
+    if (format == ch->Format)
+    {
+        return;
+    }
+
+    ch->Format = format;
+    __atomic_store_n(&ch->FormatActive, format, __ATOMIC_RELAXED);
+    RxResetFramers(ch);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Under AUTO, drop a detected format that has stopped producing frames   */
+/* and start detecting again                                               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxCheckLoss(FSWV1_UARTChannel_t *ch)
+{
+    if (ch->Format == FSWV1_IMU_FORMAT_AUTO &&
+        ch->FormatActive != FSWV1_IMU_FORMAT_AUTO &&
+        (ch->BadStreak >= FSWV1_IMU_AUTO_LOSS_FRAMES || ch->BytesNoFrame >= FSWV1_IMU_AUTO_LOSS_BYTES))
+    {
+        __atomic_store_n(&ch->FormatActive, FSWV1_IMU_FORMAT_AUTO, __ATOMIC_RELAXED);
+        RxResetFramers(ch);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Account for a frame of the given format that could not be used         */
+/* While AUTO is still hunting, failures are expected (the other format's */
+/* framer sees the stream too) and are not counted.                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxFrameFailed(FSWV1_UARTChannel_t *ch, int32 result, int bad_field)
+{
+    if (ch->FormatActive == FSWV1_IMU_FORMAT_AUTO)
+    {
+        return;
+    }
+
+    switch (result)
+    {
+        case UART_RX_BAD_FRAME:
+            __atomic_store_n(&ch->ParseErrors, ch->ParseErrors + 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&rx_last_bad_field, (uint32)bad_field, __ATOMIC_RELAXED);
+            break;
+
+        case UART_RX_BAD_CRC:
+            __atomic_store_n(&ch->CrcErrors, ch->CrcErrors + 1, __ATOMIC_RELAXED);
+            break;
+
+        case UART_RX_OVERFLOW:
+            __atomic_store_n(&ch->Overflows, ch->Overflows + 1, __ATOMIC_RELAXED);
+            break;
+
+        case UART_RX_TRUNCATED:
+            __atomic_store_n(&ch->Truncated, ch->Truncated + 1, __ATOMIC_RELAXED);
+            break;
+
+        default:
+            __atomic_store_n(&ch->Resyncs, ch->Resyncs + 1, __ATOMIC_RELAXED);
+            break;
+    }
+
+    ch->BadStreak++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Check the sender counter of a good frame for gaps                       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxTrackSequence(FSWV1_UARTChannel_t *ch)
+{
+    uint32 diff;
+
+    if (ch->FrameSeqMask == 0)
+    {
+        ch->SeqValid = false;
+        return;
     }
-    
-    /* Read available bytes */
-    while ((bytes_read = read(uart_fd, &byte, 1)) > 0)
+
+    if (ch->SeqValid)
     {
-        /* Look for start marker '$' */
-        if (byte == '$')
+        diff = (ch->FrameSeq - ch->SeqExpected) & ch->FrameSeqMask;
+        if (diff != 0 && diff <= ch->FrameSeqMask / 2)
         {
-            buffer_pos = 0;
-            uart_buffer[buffer_pos++] = byte;
+            __atomic_store_n(&ch->SeqGaps, ch->SeqGaps + 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&ch->SeqLost, ch->SeqLost + diff, __ATOMIC_RELAXED);
         }
-        /* Look for end marker '#' */
-        else if (byte == '#')
+        else if (diff != 0)
         {
-            if (buffer_pos > 0 && buffer_pos < UART_BUFFER_SIZE - 1)
-            {
-                uart_buffer[buffer_pos++] = byte;
-                uart_buffer[buffer_pos] = '\0';
-                
-                /* Parse the complete message */
-                if (ParseIMUData(uart_buffer, data) == CFE_SUCCESS)
-                {
-                    buffer_pos = 0;
-                    return CFE_SUCCESS;
-                }
-                else
-                {
-                    /* Parse failed, reset buffer */
-                    buffer_pos = 0;
-                }
-            }
-            else
-            {
-                /* Buffer overflow or invalid state, reset */
-                buffer_pos = 0;
-            }
+            __atomic_store_n(&ch->SeqResets, ch->SeqResets + 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    ch->SeqExpected = (ch->FrameSeq + 1) & ch->FrameSeqMask;
+    ch->SeqValid = true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Update the inter-arrival interval and jitter of good frames            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RxTrackInterval(FSWV1_UARTChannel_t *ch, uint64 ArrivalNs)
+{
+    int64 interval;
+    int64 delta;
+
+    if (ch->LastArrivalNs != 0 && ArrivalNs > ch->LastArrivalNs)
+    {
+        interval = (int64)(ArrivalNs - ch->LastArrivalNs);
+
+        if (ch->LastIntervalNs == 0)
+        {
+            ch->IntervalAvgNs = interval;
         }
-        /* Accumulate data between $ and # */
-        else if (buffer_pos > 0 && buffer_pos < UART_BUFFER_SIZE - 1)
+        else
         {
-            uart_buffer[buffer_pos++] = byte;
+            ch->IntervalAvgNs += (interval - ch->IntervalAvgNs) >> UART_INTERVAL_SHIFT;
+
+            delta = interval - ch->LastIntervalNs;
+            if (delta < 0)
+            {
+                delta = -delta;
+            }
+            ch->JitterNs += (delta - ch->JitterNs) >> UART_INTERVAL_SHIFT;
         }
-        /* Buffer overflow protection */
-        else if (buffer_pos >= UART_BUFFER_SIZE - 1)
+        ch->LastIntervalNs = interval;
+
+        __atomic_store_n(&ch->IntervalUs, (uint32)(ch->IntervalAvgNs / 1000), __ATOMIC_RELAXED);
+        __atomic_store_n(&ch->JitterUs, (uint32)(ch->JitterNs / 1000), __ATOMIC_RELAXED);
+        if (interval / 1000 > ch->MaxIntervalUs)
         {
-            buffer_pos = 0;  /* Reset on overflow */
+            __atomic_store_n(&ch->MaxIntervalUs, (uint32)(interval / 1000), __ATOMIC_RELAXED);
         }
     }
-    
-    /* No complete message received yet */
-    return OS_ERROR;
+
+    ch->LastArrivalNs = ArrivalNs;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
-/* Close UART (cleanup)                                                    */
+/* Account for a good frame of the given format                            */
+/* A change of format restarts the counter and interval tracking.         */
 /*                                                                         */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-void FSWV1_CloseUART(void)
+static void RxFrameGood(FSWV1_UARTChannel_t *ch, uint8 format, const FSWV1_IMUData_t *data)
 {
-    if (!UART_Initialized)
+    __atomic_store_n(&ch->FormatActive, format, __ATOMIC_RELAXED);
+    __atomic_store_n(&ch->FramesGood, ch->FramesGood + 1, __ATOMIC_RELAXED);
+    ch->BadStreak = 0;
+    ch->BytesNoFrame = 0;
+
+    if (format != ch->SeqFormat)
     {
-        return;
+        ch->SeqFormat = format;
+        ch->SeqValid = false;
+        ch->LastArrivalNs = 0;
+        ch->LastIntervalNs = 0;
+    }
+
+    RxTrackSequence(ch);
+    RxTrackInterval(ch, data->ArrivalNs);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Refill the receive chunk with one read()                               */
+/* Returns false when the tty had nothing buffered, after advancing the   */
+/* channel's watermark to the time of the read() attempt.                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool FSWV1_FillRxChunk(FSWV1_UARTChannel_t *ch)
+{
+    ssize_t bytes_read;
+    uint64 now;
+
+    now = FSWV1_Time_MonoNs();
+    bytes_read = read(ch->Fd, ch->RxChunk, sizeof(ch->RxChunk));
+    __atomic_store_n(&ch->ReadCalls, ch->ReadCalls + 1, __ATOMIC_RELAXED);
+
+    if (bytes_read <= 0)
+    {
+        /* Nothing buffered is normal; anything else is a link problem */
+        if (bytes_read < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            __atomic_store_n(&ch->ReadErrors, ch->ReadErrors + 1, __ATOMIC_RELAXED);
+        }
+
+        /* Every frame that ended before now has been pushed to the ring */
+        if (now >= ch->FloorNs)
+        {
+            ch->FloorNs = now + 1;
+        }
+        __atomic_store_n(&ch->DrainedNs, ch->FloorNs - 1, __ATOMIC_RELEASE);
+        return false;
     }
-    
-    if (uart_fd >= 0)
+
+    __atomic_store_n(&ch->BytesRead, ch->BytesRead + (uint32)bytes_read, __ATOMIC_RELAXED);
+    ch->RxLen = (size_t)bytes_read;
+    ch->RxPos = 0;
+    ch->ChunkNs = FSWV1_Time_MonoNs();
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Scan received bytes until one complete frame is parsed                 */
+/* Bytes after the frame stay in the chunk for the next call. While AUTO  */
+/* is hunting, every byte goes to both framers and the first good frame   */
+/* selects the format.                                                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 FSWV1_ReadUARTFrame(FSWV1_UARTChannel_t *ch, FSWV1_IMUData_t *data)
+{
+    uint8 byte;
+    uint8 active;
+    int32 result;
+    int bad_field = 0;
+
+    RxApplyFormat(ch);
+
+    /* Use up buffered bytes, reading more from the tty as needed */
+    while (ch->RxPos < ch->RxLen || FSWV1_FillRxChunk(ch))
     {
-        close(uart_fd);
-        uart_fd = -1;
+        byte = ch->RxChunk[ch->RxPos++];
+        ch->BytesNoFrame++;
+        RxCheckLoss(ch);
+        active = ch->FormatActive;
+
+        if (active != FSWV1_IMU_FORMAT_BINARY)
+        {
+            result = RxAsciiByte(ch, (char)byte, data, &bad_field);
+            if (result == UART_RX_FRAME)
+            {
+                RxFrameGood(ch, FSWV1_IMU_FORMAT_ASCII, data);
+                return CFE_SUCCESS;
+            }
+            if (result != UART_RX_NONE)
+            {
+                RxFrameFailed(ch, result, bad_field);
+            }
+        }
+
+        if (active != FSWV1_IMU_FORMAT_ASCII)
+        {
+            result = RxBinaryByte(ch, byte, data);
+            if (result == UART_RX_FRAME)
+            {
+                RxFrameGood(ch, FSWV1_IMU_FORMAT_BINARY, data);
+                return CFE_SUCCESS;
+            }
+            if (result != UART_RX_NONE)
+            {
+                RxFrameFailed(ch, result, 0);
+            }
+        }
     }
-    
-    UART_Initialized = false;
-    buffer_pos = 0;
-    
+
+    /* No complete message received yet */
+    return OS_ERROR;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read every open channel dry into its ring                               */
+/* Channels are always read together, so a quiet channel's watermark      */
+/* keeps up with the busy ones and does not hold the merge back.          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void UART_ServiceChannels(void)
+{
+    FSWV1_IMUData_t sample;
+    FSWV1_UARTChannel_t *ch;
+    uint32 i;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        ch = &UART_Channels[i];
+        if (ch->Fd < 0)
+        {
+            continue;
+        }
+
+        while (FSWV1_ReadUARTFrame(ch, &sample) == CFE_SUCCESS)
+        {
+            FSWV1_IMURing_Push(&ch->Ring, &sample);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* IMU reader child task                                                   */
+/* Blocks on all open IMU UARTs and pushes every parsed frame into its    */
+/* channel's ring as soon as it arrives. Timeouts still read every        */
+/* channel, which moves idle channels' watermarks on.                     */
+/* A channel whose tty reports a hangup or error (USB adapter unplugged)  */
+/* is dropped from the poll set: it would otherwise poll readable forever */
+/* with read() returning nothing. It is still read on every pass so its  */
+/* watermark keeps moving and the merge is not held back.                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_IMUTask(void)
+{
+    struct pollfd pfd[UART_CHANNEL_COUNT];
+    uint32 channel[UART_CHANNEL_COUNT];
+    nfds_t nfds = 0;
+    nfds_t n;
+    uint32 i;
+    int rc;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        if (UART_Channels[i].Fd >= 0)
+        {
+            pfd[nfds].fd = UART_Channels[i].Fd;
+            pfd[nfds].events = POLLIN;
+            pfd[nfds].revents = 0;
+            channel[nfds] = i;
+            nfds++;
+        }
+    }
+
+    FSWV1_RT_RegisterTask(FSWV1_RT_TASK_IMU);
+
+    while (IMUTask_Running)
+    {
+        rc = poll(pfd, nfds, FSWV1_IMU_TASK_POLL_MS);
+
+        if (rc < 0 && errno != EINTR)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_UART: IMU task poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (rc < 0)
+        {
+            continue;
+        }
+
+        for (n = 0; n < nfds; n++)
+        {
+            if (pfd[n].fd >= 0 && (pfd[n].revents & (POLLERR | POLLHUP | POLLNVAL)))
+            {
+                CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "FSWV1_UART: IMU UART %u hung up (revents 0x%X), no longer polled",
+                                 (unsigned int)channel[n], (unsigned int)pfd[n].revents);
+                pfd[n].fd = -1;   /* Ignored by poll() */
+            }
+        }
+
+        UART_ServiceChannels();
+    }
+
+    FSWV1_RT_UnregisterTask(FSWV1_RT_TASK_IMU);
+    IMUTask_Running = false;
+
+    /* Last touch of the channels: FSWV1_CloseUART may close them from here on */
+    OS_BinSemGive(IMUTask_Done);
+    CFE_ES_ExitChildTask();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Start the IMU reader child task                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_StartIMUTask(void)
+{
+    int32 status;
+
+    if (!UART_Initialized)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (IMUTask_Running)
+    {
+        return CFE_SUCCESS;
+    }
+
+    if (!OS_ObjectIdDefined(IMUTask_Done))
+    {
+        status = OS_BinSemCreate(&IMUTask_Done, "FSWV1_IMUDONE", OS_SEM_EMPTY, 0);
+        if (status != OS_SUCCESS)
+        {
+            IMUTask_Done = OS_OBJECT_ID_UNDEFINED;
+            CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_UART: Failed to create IMU task semaphore, RC = %d", (int)status);
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+    }
+
+    IMUTask_Running = true;
+
+    status = CFE_ES_CreateChildTask(&IMUTask_Id, FSWV1_IMU_TASK_NAME, FSWV1_IMUTask,
+                                    CFE_ES_TASK_STACK_ALLOCATE, FSWV1_IMU_TASK_STACK_SIZE,
+                                    FSWV1_IMU_TASK_PRIORITY, 0);
+    if (status != CFE_SUCCESS)
+    {
+        IMUTask_Running = false;
+        OS_BinSemDelete(IMUTask_Done);
+        IMUTask_Done = OS_OBJECT_ID_UNDEFINED;
+        CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "FSWV1_UART: Failed to create IMU task, RC = 0x%08X", (unsigned int)status);
+        return status;
+    }
+
+    CFE_EVS_SendEvent(FSWV1_APP_IMU_TASK_INF_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSWV1_UART: IMU reader task started (%u channels, ring %u samples each)",
+                     (unsigned int)UART_OpenCount, (unsigned int)FSWV1_IMU_RING_SIZE);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Drain the UARTs into the IMU rings (event loop, on an IMU fd readable) */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_ServiceUART(void)
+{
+    if (!UART_Initialized || IMUTask_Running)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    UART_ServiceChannels();
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* IMU UART descriptor of an instance for the event loop (-1 if closed)   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_GetUARTFd(uint8 Instance)
+{
+    if (!UART_Initialized || Instance >= UART_CHANNEL_COUNT)
+    {
+        return -1;
+    }
+
+    return UART_Channels[Instance].Fd;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Reverse Samples[First..Last) in place                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void FSWV1_ReverseSamples(FSWV1_IMUData_t *Samples, uint32 First, uint32 Last)
+{
+    FSWV1_IMUData_t tmp;
+
+    while (First + 1 < Last)
+    {
+        Last--;
+        tmp = Samples[First];
+        Samples[First] = Samples[Last];
+        Samples[Last] = tmp;
+        First++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Pick the channel whose ring holds the next sample of the merged stream */
+/* Returns NULL when no ring has a sample, or when the earliest head may  */
+/* still be preceded by a frame not yet read from a quiet channel.        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static FSWV1_UARTChannel_t *UART_MergeNext(void)
+{
+    const FSWV1_IMUData_t *head[UART_CHANNEL_COUNT];
+    uint64 drained[UART_CHANNEL_COUNT];
+    FSWV1_UARTChannel_t *best = NULL;
+    uint64 best_ns = 0;
+    uint32 i;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        head[i] = NULL;
+        if (UART_Channels[i].Fd < 0)
+        {
+            continue;
+        }
+
+        /* Watermark first: a ring seen empty afterwards holds nothing older */
+        drained[i] = __atomic_load_n(&UART_Channels[i].DrainedNs, __ATOMIC_ACQUIRE);
+        head[i] = FSWV1_IMURing_Peek(&UART_Channels[i].Ring);
+
+        if (head[i] != NULL && (best == NULL || head[i]->ArrivalNs < best_ns))
+        {
+            best = &UART_Channels[i];
+            best_ns = head[i]->ArrivalNs;
+        }
+    }
+
+    if (best == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        if (UART_Channels[i].Fd >= 0 && head[i] == NULL && drained[i] < best_ns)
+        {
+            return NULL;
+        }
+    }
+
+    return best;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Return every IMU sample received since the last call, oldest first     */
+/* Samples of all instances are merged in ArrivalNs order. Without the    */
+/* reader task the UARTs are read here first. If more than MaxSamples are */
+/* waiting, the newest MaxSamples are returned and the rest are counted   */
+/* as dropped.                                                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_ReadUARTFrames(FSWV1_IMUData_t *Samples, uint32 MaxSamples, uint32 *Count)
+{
+    FSWV1_UARTChannel_t *ch;
+    uint32 total = 0;
+    uint32 oldest;
+
+    if (!UART_Initialized)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (Samples == NULL || Count == NULL)
+    {
+        return OS_INVALID_POINTER;
+    }
+
+    *Count = 0;
+    if (MaxSamples == 0)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    if (!IMUTask_Running)
+    {
+        UART_ServiceChannels();
+    }
+
+    /*
+    ** Samples is filled as a circular buffer so that the newest samples
+    ** survive
+    */
+    while ((ch = UART_MergeNext()) != NULL)
+    {
+        FSWV1_IMURing_Pop(&ch->Ring, &Samples[total % MaxSamples]);
+        total++;
+    }
+
+    if (total > MaxSamples)
+    {
+        rx_drain_dropped += total - MaxSamples;
+
+        /* Rotate the oldest surviving sample to index 0 */
+        oldest = total % MaxSamples;
+        FSWV1_ReverseSamples(Samples, 0, oldest);
+        FSWV1_ReverseSamples(Samples, oldest, MaxSamples);
+        FSWV1_ReverseSamples(Samples, 0, MaxSamples);
+
+        total = MaxSamples;
+    }
+
+    *Count = total;
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Read the next IMU sample                                                */
+/* Pops the oldest sample of the merged stream; the rest stay queued for  */
+/* the next call, so nothing is dropped.                                   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_ReadUART(FSWV1_IMUData_t *data)
+{
+    FSWV1_UARTChannel_t *ch;
+
+    if (!UART_Initialized)
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    if (data == NULL)
+    {
+        return OS_INVALID_POINTER;
+    }
+
+    if (!IMUTask_Running)
+    {
+        UART_ServiceChannels();
+    }
+
+    ch = UART_MergeNext();
+    if (ch == NULL)
+    {
+        /* No complete message received yet */
+        return OS_ERROR;
+    }
+
+    FSWV1_IMURing_Pop(&ch->Ring, data);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get IMU ring statistics for housekeeping (all instances)               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetIMURingStats(uint32 *Overflows, uint32 *HighWater)
+{
+    uint32 high_water;
+    uint32 i;
+
+    *Overflows = 0;
+    *HighWater = 0;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        *Overflows += __atomic_load_n(&UART_Channels[i].Ring.Overflows, __ATOMIC_RELAXED);
+        high_water = __atomic_load_n(&UART_Channels[i].Ring.HighWater, __ATOMIC_RELAXED);
+        if (high_water > *HighWater)
+        {
+            *HighWater = high_water;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get UART read() statistics for housekeeping (all instances)            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetUARTReadStats(uint32 *ReadCalls, uint32 *BytesRead)
+{
+    uint32 i;
+
+    *ReadCalls = 0;
+    *BytesRead = 0;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        *ReadCalls += __atomic_load_n(&UART_Channels[i].ReadCalls, __ATOMIC_RELAXED);
+        *BytesRead += __atomic_load_n(&UART_Channels[i].BytesRead, __ATOMIC_RELAXED);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get IMU frame parse statistics for housekeeping (all instances)        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetIMUParseStats(uint32 *ParseErrors, uint32 *LastBadField)
+{
+    uint32 i;
+
+    *ParseErrors = 0;
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        *ParseErrors += __atomic_load_n(&UART_Channels[i].ParseErrors, __ATOMIC_RELAXED);
+    }
+    *LastBadField = __atomic_load_n(&rx_last_bad_field, __ATOMIC_RELAXED);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get the number of samples dropped by full drain batches                 */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 FSWV1_GetIMUDrainDropped(void)
+{
+    return rx_drain_dropped;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Select the IMU wire format (FSWV1_IMU_FORMAT_xxx) for all instances    */
+/* Takes effect at the next frame read, in the reading context.           */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_SetIMUFormat(uint8 Format)
+{
+    if (Format >= FSWV1_IMU_FORMAT_COUNT)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    __atomic_store_n(&rx_format_cmd, Format, __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get wire format state and binary link statistics for housekeeping      */
+/* Active is the first open instance's; the others are reported per       */
+/* instance by FSWV1_GetIMUInstanceStats.                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetIMUFormatStats(uint8 *Format, uint8 *Active, uint32 *CrcErrors, uint32 *Resyncs)
+{
+    bool found = false;
+    uint32 i;
+
+    *Format = __atomic_load_n(&rx_format_cmd, __ATOMIC_RELAXED);
+    *Active = *Format;
+    *CrcErrors = 0;
+    *Resyncs = 0;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        if (!found && UART_Initialized && UART_Channels[i].Fd >= 0)
+        {
+            *Active = __atomic_load_n(&UART_Channels[i].FormatActive, __ATOMIC_RELAXED);
+            found = true;
+        }
+        *CrcErrors += __atomic_load_n(&UART_Channels[i].CrcErrors, __ATOMIC_RELAXED);
+        *Resyncs += __atomic_load_n(&UART_Channels[i].Resyncs, __ATOMIC_RELAXED);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Copy one channel's stream integrity statistics                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void UART_ChannelLinkStats(const FSWV1_UARTChannel_t *ch, FSWV1_IMULinkStats_t *Stats)
+{
+    Stats->FramesGood = __atomic_load_n(&ch->FramesGood, __ATOMIC_RELAXED);
+    Stats->BadFrames = __atomic_load_n(&ch->ParseErrors, __ATOMIC_RELAXED) +
+                       __atomic_load_n(&ch->CrcErrors, __ATOMIC_RELAXED) +
+                       __atomic_load_n(&ch->Resyncs, __ATOMIC_RELAXED) +
+                       __atomic_load_n(&ch->Overflows, __ATOMIC_RELAXED) +
+                       __atomic_load_n(&ch->Truncated, __ATOMIC_RELAXED);
+    Stats->Overflows = __atomic_load_n(&ch->Overflows, __ATOMIC_RELAXED);
+    Stats->Truncated = __atomic_load_n(&ch->Truncated, __ATOMIC_RELAXED);
+    Stats->ReadErrors = __atomic_load_n(&ch->ReadErrors, __ATOMIC_RELAXED);
+    Stats->SeqGaps = __atomic_load_n(&ch->SeqGaps, __ATOMIC_RELAXED);
+    Stats->SeqLost = __atomic_load_n(&ch->SeqLost, __ATOMIC_RELAXED);
+    Stats->SeqResets = __atomic_load_n(&ch->SeqResets, __ATOMIC_RELAXED);
+    Stats->IntervalUs = __atomic_load_n(&ch->IntervalUs, __ATOMIC_RELAXED);
+    Stats->JitterUs = __atomic_load_n(&ch->JitterUs, __ATOMIC_RELAXED);
+    Stats->MaxIntervalUs = __atomic_load_n(&ch->MaxIntervalUs, __ATOMIC_RELAXED);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get IMU stream integrity statistics for housekeeping                    */
+/* Counters are totals over all instances; the interval, jitter and       */
+/* longest interval are the worst instance's.                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetIMULinkStats(FSWV1_IMULinkStats_t *Stats)
+{
+    FSWV1_IMULinkStats_t inst;
+    uint32 i;
+
+    memset(Stats, 0, sizeof(*Stats));
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        UART_ChannelLinkStats(&UART_Channels[i], &inst);
+
+        Stats->FramesGood += inst.FramesGood;
+        Stats->BadFrames += inst.BadFrames;
+        Stats->Overflows += inst.Overflows;
+        Stats->Truncated += inst.Truncated;
+        Stats->ReadErrors += inst.ReadErrors;
+        Stats->SeqGaps += inst.SeqGaps;
+        Stats->SeqLost += inst.SeqLost;
+        Stats->SeqResets += inst.SeqResets;
+        if (inst.IntervalUs > Stats->IntervalUs)
+        {
+            Stats->IntervalUs = inst.IntervalUs;
+        }
+        if (inst.JitterUs > Stats->JitterUs)
+        {
+            Stats->JitterUs = inst.JitterUs;
+        }
+        if (inst.MaxIntervalUs > Stats->MaxIntervalUs)
+        {
+            Stats->MaxIntervalUs = inst.MaxIntervalUs;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get the configured IMU instances and which of them are open            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_GetIMUInstances(uint8 *Configured, uint8 *OpenMask)
+{
+    uint32 i;
+
+    *Configured = (uint8)UART_CHANNEL_COUNT;
+    *OpenMask = 0;
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        if (UART_Initialized && UART_Channels[i].Fd >= 0)
+        {
+            *OpenMask |= (uint8)(1 << i);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Get one instance's stream statistics and active wire format            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_GetIMUInstanceStats(uint8 Instance, FSWV1_IMULinkStats_t *Stats, uint8 *FormatActive)
+{
+    if (Instance >= UART_CHANNEL_COUNT)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    UART_ChannelLinkStats(&UART_Channels[Instance], Stats);
+    *FormatActive = __atomic_load_n(&UART_Channels[Instance].FormatActive, __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Close UART (cleanup)                                                    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_CloseUART(void)
+{
+    uint32 i;
+    int32 status;
+
+    if (!UART_Initialized)
+    {
+        return;
+    }
+
+    /*
+    ** Join the reader task before its descriptors go away. The semaphore
+    ** only exists while a task was started; the task sees the flag within
+    ** one poll timeout (or has already exited and given it). One that does
+    ** not exit is deleted.
+    */
+    if (OS_ObjectIdDefined(IMUTask_Done))
+    {
+        IMUTask_Running = false;
+        status = OS_BinSemTimedWait(IMUTask_Done, FSWV1_IMU_TASK_POLL_MS * 2);
+        if (status != OS_SUCCESS)
+        {
+            CFE_EVS_SendEvent(FSWV1_APP_UART_ERR_EID, CFE_EVS_EventType_ERROR,
+                             "FSWV1_UART: IMU task did not exit, RC = %d; deleting it", (int)status);
+            CFE_ES_DeleteChildTask(IMUTask_Id);
+        }
+
+        OS_BinSemDelete(IMUTask_Done);
+        IMUTask_Done = OS_OBJECT_ID_UNDEFINED;
+    }
+
+    for (i = 0; i < UART_CHANNEL_COUNT; i++)
+    {
+        if (UART_Channels[i].Fd >= 0)
+        {
+            FSWV1_Serial_Close(UART_Channels[i].Fd);
+            UART_Channels[i].Fd = -1;
+        }
+        UART_ResetChannel(&UART_Channels[i]);
+    }
+
+    UART_Initialized = false;
+    UART_OpenCount = 0;
+
     OS_printf("FSWV1_UART: UART closed\n");
 }
@@ -11,11 +11,14 @@
 **
 ** Note: This uses a different UART than the IMU input UART to avoid conflicts.
 **
+** Writes never block: packets are queued in a transmit buffer and written
+** as far as the tty accepts, and the remainder is flushed on later calls
+** (or when the event loop sees the descriptor become writable).
+**
 ******************************************************************************/
 
 #include "fswv1_app.h"
-#include <fcntl.h>
-#include <termios.h>
+#include "fswv1_serial.h"
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
@@ -29,16 +32,39 @@
 ** - /dev/ttyS0   - Alternative UART
 ** - /dev/ttyUSB0 - USB-to-Serial adapter
 ** - /dev/ttyUSB1 - Another USB-to-Serial adapter
+**
+** The device, rate and buffer settings can be overridden with compile
+** definitions. At high rates, size the TX buffer for the largest burst of
+** packets sent between two writable events.
 */
+#ifndef TELEMETRY_UART_DEVICE
 #define TELEMETRY_UART_DEVICE "/dev/ttyUSB0"  /* Change this to match your hardware */
-#define TELEMETRY_UART_BAUDRATE B115200
+#endif
+#ifndef TELEMETRY_UART_BAUD
+#define TELEMETRY_UART_BAUD 115200
+#endif
+#ifndef TELEMETRY_UART_FLOW_CONTROL
+#define TELEMETRY_UART_FLOW_CONTROL 0    /* 1 = RTS/CTS hardware flow control */
+#endif
+#ifndef TELEMETRY_UART_LOW_LATENCY
+#define TELEMETRY_UART_LOW_LATENCY 1
+#endif
+#ifndef TELEMETRY_UART_HW_XMIT_FIFO_DEPTH
+#define TELEMETRY_UART_HW_XMIT_FIFO_DEPTH 0  /* UART hardware transmit FIFO depth, 0 = driver default */
+#endif
 #define TELEMETRY_ASCII_FORMAT 0  /* Set to 1 for ASCII format, 0 for binary CCSDS format */
+#ifndef TELEMETRY_TX_BUFFER_SIZE
+#define TELEMETRY_TX_BUFFER_SIZE 4096
+#endif
 
 /*
 ** Static variables
 */
 static bool TelemetryUART_Initialized = false;
 static int telemetry_uart_fd = -1;
+static uint8 tx_buffer[TELEMETRY_TX_BUFFER_SIZE];
+static size_t tx_pending = 0;
+static uint32 tx_error_count = 0;
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
@@ -47,84 +73,134 @@ static int telemetry_uart_fd = -1;
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 int32 FSWV1_InitTelemetryUART(void)
 {
-    struct termios tty;
+    FSWV1_SerialConfig_t config;
+    FSWV1_SerialInfo_t info;
     
     if (TelemetryUART_Initialized)
     {
         return CFE_SUCCESS;
     }
     
-    OS_printf("FSWV1_TELEMETRY_UART: Initializing telemetry UART on %s at 115200 baud...\n", 
-              TELEMETRY_UART_DEVICE);
+    OS_printf("FSWV1_TELEMETRY_UART: Initializing telemetry UART on %s at %u baud...\n", 
+              TELEMETRY_UART_DEVICE, (unsigned)TELEMETRY_UART_BAUD);
     
-    /* Open UART device */
-    telemetry_uart_fd = open(TELEMETRY_UART_DEVICE, O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (telemetry_uart_fd < 0)
-    {
-        CFE_EVS_SendEvent(FSWV1_APP_UART_TELEMETRY_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_TELEMETRY_UART: Failed to open %s: %s", 
-                         TELEMETRY_UART_DEVICE, strerror(errno));
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
-    }
+    /* Open and configure the port (8N1, raw, non-blocking) */
+    memset(&config, 0, sizeof(config));
+    config.BaudRate = TELEMETRY_UART_BAUD;
+    config.FlowControl = TELEMETRY_UART_FLOW_CONTROL;
+    config.LowLatency = TELEMETRY_UART_LOW_LATENCY;
+    config.HwXmitFifoDepth = TELEMETRY_UART_HW_XMIT_FIFO_DEPTH;
+    config.Vmin = 0;
+    config.Vtime = 5;
     
-    /* Get current settings */
-    if (tcgetattr(telemetry_uart_fd, &tty) != 0)
+    telemetry_uart_fd = FSWV1_Serial_Open(TELEMETRY_UART_DEVICE, &config, &info);
+    if (telemetry_uart_fd < 0)
     {
         CFE_EVS_SendEvent(FSWV1_APP_UART_TELEMETRY_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_TELEMETRY_UART: Failed to get UART attributes");
-        close(telemetry_uart_fd);
-        telemetry_uart_fd = -1;
+                         "FSWV1_TELEMETRY_UART: %s failed for %s: %s", 
+                         info.FailedStep, TELEMETRY_UART_DEVICE, strerror(errno));
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
     
-    /* Configure UART settings */
-    cfsetospeed(&tty, TELEMETRY_UART_BAUDRATE);
-    cfsetispeed(&tty, TELEMETRY_UART_BAUDRATE);
-    
-    /* 8N1 mode (8 data bits, no parity, 1 stop bit) */
-    tty.c_cflag &= ~PARENB;        /* No parity */
-    tty.c_cflag &= ~CSTOPB;        /* 1 stop bit */
-    tty.c_cflag &= ~CSIZE;
-    tty.c_cflag |= CS8;            /* 8 data bits */
-    tty.c_cflag &= ~0020000000000; /* No hardware flow control (CRTSCTS) */
-    tty.c_cflag |= CREAD | CLOCAL; /* Enable receiver, ignore modem lines */
-    
-    /* Raw input mode (for compatibility) */
-    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-    tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
-    
-    /* Raw output mode */
-    tty.c_oflag &= ~OPOST;
-    
-    /* Set up for blocking write (telemetry transmission) */
-    tty.c_cc[VMIN] = 0;
-    tty.c_cc[VTIME] = 5;  /* 0.5 second timeout for write operations */
-    
-    /* Apply settings */
-    if (tcsetattr(telemetry_uart_fd, TCSANOW, &tty) != 0)
-    {
-        CFE_EVS_SendEvent(FSWV1_APP_UART_TELEMETRY_ERR_EID, CFE_EVS_EventType_ERROR,
-                         "FSWV1_TELEMETRY_UART: Failed to set UART attributes");
-        close(telemetry_uart_fd);
-        telemetry_uart_fd = -1;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
-    }
-    
-    /* Flush any existing data */
-    tcflush(telemetry_uart_fd, TCIOFLUSH);
-    
+    tx_pending = 0;
     TelemetryUART_Initialized = true;
     
     CFE_EVS_SendEvent(FSWV1_APP_UART_TELEMETRY_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
-                     "FSWV1_TELEMETRY_UART: Telemetry UART initialized on %s at 115200 baud", 
-                     TELEMETRY_UART_DEVICE);
+                     "FSWV1_TELEMETRY_UART: Telemetry UART initialized on %s at %u baud (flow control %s, warnings 0x%X)", 
+                     TELEMETRY_UART_DEVICE, (unsigned)info.ActualBaud,
+                     TELEMETRY_UART_FLOW_CONTROL ? "on" : "off", info.Warnings);
     
     OS_printf("FSWV1_TELEMETRY_UART: Ready to transmit telemetry data\n");
     
     return CFE_SUCCESS;
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Write as much pending data as the UART accepts without blocking        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 FSWV1_FlushTelemetryUART(void)
+{
+    ssize_t bytes_written;
+
+    if (!TelemetryUART_Initialized || telemetry_uart_fd < 0)
+    {
+        return CFE_SUCCESS;
+    }
+
+    while (tx_pending > 0)
+    {
+        bytes_written = write(telemetry_uart_fd, tx_buffer, tx_pending);
+
+        if (bytes_written < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                break;
+            }
+
+            /* Don't spam errors for every failed write */
+            if (tx_error_count % 100 == 0 && !FSWV1_Deadline_Degraded())
+            {
+                OS_printf("FSWV1_TELEMETRY_UART: Write error: %s\n", strerror(errno));
+            }
+            tx_error_count++;
+            tx_pending = 0;
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+
+        tx_pending -= (size_t)bytes_written;
+        if (tx_pending > 0)
+        {
+            memmove(tx_buffer, &tx_buffer[bytes_written], tx_pending);
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Queue a complete packet and start writing it                           */
+/* A packet that does not fit is dropped whole so the stream never        */
+/* carries a truncated frame.                                              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 QueueTelemetry(const void *data, size_t len)
+{
+    if (len > sizeof(tx_buffer) - tx_pending)
+    {
+        if (tx_error_count % 100 == 0 && !FSWV1_Deadline_Degraded())
+        {
+            OS_printf("FSWV1_TELEMETRY_UART: TX buffer full, dropping %zu byte packet\n", len);
+        }
+        tx_error_count++;
+        FSWV1_FlushTelemetryUART();
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    memcpy(&tx_buffer[tx_pending], data, len);
+    tx_pending += len;
+
+    return FSWV1_FlushTelemetryUART();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Telemetry UART accessors for the event loop                             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_GetTelemetryUARTFd(void)
+{
+    return TelemetryUART_Initialized ? telemetry_uart_fd : -1;
+}
+
+uint32 FSWV1_TelemetryUARTPending(void)
+{
+    return (uint32)tx_pending;
+}
+
 #if TELEMETRY_ASCII_FORMAT
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                         */
@@ -136,7 +212,6 @@ static int32 SendTelemetryASCII(const FSWV1_SensorData_t *SensorData,
 {
     char buffer[512];
     int len;
-    ssize_t bytes_written;
     
     /* Format telemetry data as ASCII string */
     len = snprintf(buffer, sizeof(buffer),
@@ -157,23 +232,8 @@ static int32 SendTelemetryASCII(const FSWV1_SensorData_t *SensorData,
         return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
     }
     
-    /* Write to UART */
-    bytes_written = write(telemetry_uart_fd, buffer, len);
-    
-    if (bytes_written != len)
-    {
-        /* Don't spam errors for every failed write */
-        static uint32 error_count = 0;
-        if (error_count % 100 == 0)
-        {
-            OS_printf("FSWV1_TELEMETRY_UART: Write error, expected %d bytes, wrote %d bytes\n",
-                     len, (int)bytes_written);
-        }
-        error_count++;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
-    }
-    
-    return CFE_SUCCESS;
+    /* Queue for the UART */
+    return QueueTelemetry(buffer, (size_t)len);
 }
 #endif
 
@@ -199,7 +259,6 @@ static void swap_uint32_to_be(uint32_t *val)
 
 static int32 SendTelemetryBinary(void)
 {
-    ssize_t bytes_written;
     FSWV1_APP_CombinedTlm_t packet_copy;
     size_t packet_size = sizeof(FSWV1_APP_Data.CombinedTlm);
     
@@ -221,24 +280,14 @@ static int32 SendTelemetryBinary(void)
     swap_float_to_be(&packet_copy.Payload.Gyro_Z);
     swap_float_to_be(&packet_copy.Payload.IMU_Temperature);
     swap_uint32_to_be(&packet_copy.Payload.Timestamp);
+    swap_uint32_to_be(&packet_copy.Payload.BMP_Time.Seconds);
+    swap_uint32_to_be(&packet_copy.Payload.BMP_Time.Subseconds);
+    swap_uint32_to_be(&packet_copy.Payload.IMU_Time.Seconds);
+    swap_uint32_to_be(&packet_copy.Payload.IMU_Time.Subseconds);
 #endif
     
-    /* Write the byte-swapped CCSDS packet to UART */
-    bytes_written = write(telemetry_uart_fd, &packet_copy, packet_size);
-    
-    if (bytes_written != (ssize_t)packet_size)
-    {
-        static uint32 error_count = 0;
-        if (error_count % 100 == 0)
-        {
-            OS_printf("FSWV1_TELEMETRY_UART: Write error, expected %zu bytes, wrote %d bytes\n",
-                     packet_size, (int)bytes_written);
-        }
-        error_count++;
-        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
-    }
-    
-    return CFE_SUCCESS;
+    /* Queue the byte-swapped CCSDS packet for the UART */
+    return QueueTelemetry(&packet_copy, packet_size);
 }
 #endif
 
@@ -261,6 +310,12 @@ int32 FSWV1_SendTelemetryUART(const FSWV1_SensorData_t *SensorData,
     }
     
 #if TELEMETRY_ASCII_FORMAT
+    /* ASCII formatting is optional work; drop it while cycles overrun */
+    if (FSWV1_Deadline_Degraded())
+    {
+        return CFE_SUCCESS;
+    }
+
     /* Send ASCII formatted data */
     return SendTelemetryASCII(SensorData, IMUData);
 #else
@@ -283,10 +338,11 @@ void FSWV1_CloseTelemetryUART(void)
     
     if (telemetry_uart_fd >= 0)
     {
-        close(telemetry_uart_fd);
+        FSWV1_Serial_Close(telemetry_uart_fd);
         telemetry_uart_fd = -1;
     }
     
+    tx_pending = 0;
     TelemetryUART_Initialized = false;
     
     OS_printf("FSWV1_TELEMETRY_UART: Telemetry UART closed\n");
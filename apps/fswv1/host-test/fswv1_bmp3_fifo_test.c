@@ -0,0 +1,177 @@
+/******************************************************************************
+** File: fswv1_bmp3_fifo_test.c
+**
+** Purpose:
+**   Unit test of the BMP388/BMP390 FIFO decoder (FSWV1_BMP3_DecodeFifo in
+**   fswv1_bmp3_fifo.c): data, control, partial and sensor time frames,
+**   incomplete frames, reads past the end and unknown headers.
+**
+** Notes:
+**   Compensation accuracy and the frame clock are covered by
+**   bmp3_fifo_bench.c.
+**
+******************************************************************************/
+
+#include "fswv1_bmp3_fifo.h"
+#include "ut_fswv1.h"
+#include <string.h>
+
+static uint32_t UT_PutFrame(uint8_t *Buf, uint32_t AdcT, uint32_t AdcP)
+{
+    Buf[0] = FSWV1_BMP3_FH_TEMP_PRESS;
+    Buf[1] = AdcT & 0xFF;
+    Buf[2] = (AdcT >> 8) & 0xFF;
+    Buf[3] = (AdcT >> 16) & 0xFF;
+    Buf[4] = AdcP & 0xFF;
+    Buf[5] = (AdcP >> 8) & 0xFF;
+    Buf[6] = (AdcP >> 16) & 0xFF;
+
+    return FSWV1_BMP3_FRAME_SIZE;
+}
+
+static uint32_t UT_PutTime(uint8_t *Buf, uint32_t Ticks)
+{
+    Buf[0] = FSWV1_BMP3_FH_TIME;
+    Buf[1] = Ticks & 0xFF;
+    Buf[2] = (Ticks >> 8) & 0xFF;
+    Buf[3] = (Ticks >> 16) & 0xFF;
+
+    return FSWV1_BMP3_TIME_FRAME_SIZE;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* A full FIFO, its sensor time frame and the bytes read past the end      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_FullFifo(void)
+{
+    uint8_t buf[FSWV1_BMP3_FIFO_READ_MAX + 8];
+    FSWV1_BMP3_Frame_t frames[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    FSWV1_BMP3_FifoResult_t r;
+    uint32_t len = 0;
+    uint32_t n;
+    uint32_t i;
+    int ok;
+
+    for (i = 0; len + FSWV1_BMP3_FRAME_SIZE <= FSWV1_BMP3_FIFO_SIZE; i++)
+    {
+        len += UT_PutFrame(&buf[len], 0xABCDEF - i, 0x012345 + 7 * i);
+    }
+    len += UT_PutTime(&buf[len], 0xFEDCBA);
+    buf[len++] = FSWV1_BMP3_FH_EMPTY;
+    buf[len++] = 0;
+
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+
+    ok = (n == i);
+    for (i = 0; i < n && ok; i++)
+    {
+        ok = frames[i].AdcT == 0xABCDEF - i && frames[i].AdcP == 0x012345 + 7 * i;
+    }
+    UT_Check(ok, "FIFO: frames in order, 24-bit little-endian fields");
+    UT_Check(n == FSWV1_BMP3_FIFO_SIZE / FSWV1_BMP3_FRAME_SIZE, "FIFO: frame count of a full FIFO");
+    UT_Check(r.TimeValid && r.SensorTime == 0xFEDCBA, "FIFO: sensor time frame");
+    UT_Check(r.Consumed == len && !r.Invalid && r.Partial == 0, "FIFO: read past the end consumed");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Control and partial frames between data frames                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_ControlFrames(void)
+{
+    uint8_t buf[64];
+    FSWV1_BMP3_Frame_t frames[4];
+    FSWV1_BMP3_FifoResult_t r;
+    uint32_t len = 0;
+    uint32_t n;
+
+    len += UT_PutFrame(&buf[len], 1, 2);
+    buf[len++] = FSWV1_BMP3_FH_CONFIG_CHANGE;
+    buf[len++] = 0;
+    buf[len++] = FSWV1_BMP3_FH_TEMP;
+    buf[len++] = 9;
+    buf[len++] = 9;
+    buf[len++] = 9;
+    buf[len++] = FSWV1_BMP3_FH_PRESS;
+    buf[len++] = 8;
+    buf[len++] = 8;
+    buf[len++] = 8;
+    buf[len++] = FSWV1_BMP3_FH_CONFIG_ERROR;
+    buf[len++] = 0;
+    len += UT_PutFrame(&buf[len], 3, 4);
+
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, 4, &r);
+
+    UT_Check(n == 2 && frames[0].AdcT == 1 && frames[1].AdcT == 3 && frames[1].AdcP == 4,
+             "FIFO: data frames around control frames");
+    UT_Check(r.ConfigChanges == 1 && r.ConfigErrors == 1 && r.Partial == 2 && !r.TimeValid,
+             "FIFO: control and partial frames counted");
+    UT_Check(r.Consumed == len && !r.Invalid, "FIFO: control frames consumed");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Where decoding stops                                                    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Stops(void)
+{
+    uint8_t buf[128];
+    FSWV1_BMP3_Frame_t frames[FSWV1_BMP3_FIFO_MAX_FRAMES];
+    FSWV1_BMP3_FifoResult_t r;
+    uint32_t len;
+    uint32_t n;
+    uint32_t i;
+
+    /* Last frame cut off by the read length: left for the next burst */
+    len = 0;
+    len += UT_PutFrame(&buf[len], 5, 6);
+    len += UT_PutFrame(&buf[len], 7, 8);
+    n = FSWV1_BMP3_DecodeFifo(buf, len - 3, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    UT_Check(n == 1 && r.Consumed == FSWV1_BMP3_FRAME_SIZE && !r.Invalid, "FIFO: incomplete frame not consumed");
+
+    /* Sensor time frame cut off */
+    len = 0;
+    len += UT_PutFrame(&buf[len], 5, 6);
+    len += UT_PutTime(&buf[len], 0x123456);
+    n = FSWV1_BMP3_DecodeFifo(buf, len - 1, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    UT_Check(n == 1 && !r.TimeValid && r.Consumed == FSWV1_BMP3_FRAME_SIZE, "FIFO: incomplete sensor time");
+
+    /* Unknown header: the rest of the read is discarded */
+    len = 0;
+    len += UT_PutFrame(&buf[len], 5, 6);
+    buf[len++] = 0x3C;
+    len += UT_PutFrame(&buf[len], 7, 8);
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    UT_Check(n == 1 && r.Invalid && r.Consumed == len, "FIFO: unknown header");
+
+    /* More frames than room: the extra frames are consumed, not stored */
+    len = 0;
+    for (i = 0; i < 10; i++)
+    {
+        len += UT_PutFrame(&buf[len], i, i);
+    }
+    memset(frames, 0xFF, sizeof(frames));
+    n = FSWV1_BMP3_DecodeFifo(buf, len, frames, 4, &r);
+    UT_Check(n == 4 && frames[3].AdcT == 3 && frames[4].AdcT == 0xFFFFFFFF && r.Consumed == len,
+             "FIFO: MaxFrames respected");
+
+    /* Empty FIFO */
+    buf[0] = FSWV1_BMP3_FH_EMPTY;
+    n = FSWV1_BMP3_DecodeFifo(buf, 1, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    UT_Check(n == 0 && !r.Invalid && r.Consumed == 1, "FIFO: empty");
+    n = FSWV1_BMP3_DecodeFifo(buf, 0, frames, FSWV1_BMP3_FIFO_MAX_FRAMES, &r);
+    UT_Check(n == 0 && r.Consumed == 0, "FIFO: zero-length read");
+}
+
+int main(void)
+{
+    Test_FullFifo();
+    Test_ControlFrames();
+    Test_Stops();
+
+    return UT_Report("fswv1_bmp3_fifo_test");
+}
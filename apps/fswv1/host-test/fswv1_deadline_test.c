@@ -0,0 +1,142 @@
+/******************************************************************************
+** File: fswv1_deadline_test.c
+**
+** Purpose:
+**   Unit test of the cycle deadline monitor (fswv1_deadline.c): overrun
+**   attribution, degraded mode entry and exit, and the coalescing of mode
+**   change events inside FSWV1_DEADLINE_EVENT_MIN_MS.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "ut_fswv1.h"
+
+#define UT_CYCLE_NS     (1000000000ULL / FSWV1_APP_WAKEUP_RATE_HZ)
+#define UT_DEADLINE_NS  ((uint64)FSWV1_APP_CYCLE_DEADLINE_US * 1000)
+#define UT_WINDOW_NS    ((uint64)FSWV1_DEADLINE_EVENT_MIN_MS * 1000000ULL)
+
+/*
+** One cycle; an overrun is spent mostly in Stage
+*/
+static void UT_Cycle(bool Overrun, uint8 Stage)
+{
+    uint64 exec = Overrun ? UT_DEADLINE_NS * 2 : UT_DEADLINE_NS / 2;
+
+    UT_SetMonoNs(UT_GetMonoNs() + UT_CYCLE_NS);
+    FSWV1_Deadline_BeginCycle();
+    FSWV1_Deadline_StageTime(FSWV1_APP_STAGE_SENSOR, exec / 8);
+    FSWV1_Deadline_StageTime(Stage, exec / 2);
+    FSWV1_Deadline_EndCycle(exec);
+}
+
+static void UT_Cycles(uint32 Count, bool Overrun, uint8 Stage)
+{
+    while (Count-- > 0)
+    {
+        UT_Cycle(Overrun, Stage);
+    }
+}
+
+static uint32 UT_Degraded(void)
+{
+    return UT_EventCount(FSWV1_APP_DEADLINE_ERR_EID);
+}
+
+static uint32 UT_Normal(void)
+{
+    return UT_EventCount(FSWV1_APP_DEADLINE_INF_EID);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Entering and leaving degraded mode                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Modes(void)
+{
+    FSWV1_Deadline_Reset();
+    UT_ResetEvents();
+    UT_SetMonoNs(1000000000ULL);
+
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT - 1, true, FSWV1_APP_STAGE_UART);
+    UT_Check(!FSWV1_Deadline_Degraded(), "Deadline: not degraded before DEGRADE_COUNT overruns");
+
+    UT_Cycle(true, FSWV1_APP_STAGE_UART);
+    UT_Check(FSWV1_Deadline_Degraded() && FSWV1_APP_Data.Deadline.DegradedEntries == 1,
+             "Deadline: degraded after DEGRADE_COUNT overruns");
+    UT_Check(FSWV1_APP_Data.Deadline.Overruns[FSWV1_APP_STAGE_UART] == FSWV1_DEADLINE_DEGRADE_COUNT &&
+             FSWV1_APP_Data.Deadline.Overruns[FSWV1_APP_STAGE_SENSOR] == 0,
+             "Deadline: overruns charged to the slowest stage");
+    UT_Check(UT_Degraded() == 1, "Deadline: first mode change reported at once");
+
+    /* A good cycle between overruns restarts the streak */
+    FSWV1_Deadline_Reset();
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT - 1, true, FSWV1_APP_STAGE_IMU);
+    UT_Cycle(false, FSWV1_APP_STAGE_IMU);
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT - 1, true, FSWV1_APP_STAGE_IMU);
+    UT_Check(!FSWV1_Deadline_Degraded(), "Deadline: overrun streak must be consecutive");
+
+    UT_Cycle(true, FSWV1_APP_STAGE_IMU);
+    UT_Cycles(FSWV1_DEADLINE_RECOVER_COUNT - 1, false, FSWV1_APP_STAGE_IMU);
+    UT_Check(FSWV1_Deadline_Degraded(), "Deadline: still degraded before RECOVER_COUNT good cycles");
+    UT_Cycle(false, FSWV1_APP_STAGE_IMU);
+    UT_Check(!FSWV1_Deadline_Degraded(), "Deadline: normal after RECOVER_COUNT good cycles");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Mode changes inside the event window are coalesced                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Coalescing(void)
+{
+    uint64 first;
+
+    FSWV1_Deadline_Reset();
+    UT_ResetEvents();
+    UT_SetMonoNs(1000000000ULL);
+
+    /* Degraded: reported at once */
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT, true, FSWV1_APP_STAGE_UDP);
+    first = UT_GetMonoNs();
+    UT_Check(UT_Degraded() == 1 && UT_Normal() == 0, "Coalesce: entry reported");
+
+    /* Normal, then degraded again, all inside the window: nothing sent */
+    UT_Cycles(FSWV1_DEADLINE_RECOVER_COUNT, false, FSWV1_APP_STAGE_UDP);
+    UT_Check(!FSWV1_Deadline_Degraded() && UT_Normal() == 0, "Coalesce: recovery inside the window held");
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT, true, FSWV1_APP_STAGE_UDP);
+    UT_Check(FSWV1_Deadline_Degraded() && UT_Degraded() == 1, "Coalesce: re-entry inside the window held");
+
+    /* Window expires in the mode last reported: still nothing to send */
+    UT_SetMonoNs(first + UT_WINDOW_NS);
+    UT_Cycle(false, FSWV1_APP_STAGE_UDP);
+    UT_Check(UT_Degraded() == 1 && UT_Normal() == 0, "Coalesce: no event when the mode is back to the reported one");
+
+    /* Recovery after the window: reported at once */
+    UT_Cycles(FSWV1_DEADLINE_RECOVER_COUNT, false, FSWV1_APP_STAGE_UDP);
+    UT_Check(!FSWV1_Deadline_Degraded() && UT_Normal() == 1, "Coalesce: recovery after the window reported");
+
+    /* Degraded again right away: held, then sent once the window expires */
+    first = UT_GetMonoNs();
+    UT_Cycles(FSWV1_DEADLINE_DEGRADE_COUNT, true, FSWV1_APP_STAGE_UDP);
+    UT_Check(UT_Degraded() == 1, "Coalesce: entry inside the window held");
+
+    UT_Cycles(10, false, FSWV1_APP_STAGE_UDP);
+    UT_Check(UT_Degraded() == 1, "Coalesce: held event not sent early");
+
+    UT_SetMonoNs(first + UT_WINDOW_NS);
+    UT_Cycle(false, FSWV1_APP_STAGE_UDP);
+    UT_Check(FSWV1_Deadline_Degraded() && UT_Degraded() == 2 && UT_Normal() == 1,
+             "Coalesce: held mode reported when the window expires");
+
+    UT_Cycles(10, false, FSWV1_APP_STAGE_UDP);
+    UT_Check(UT_EventTotal() == 3, "Coalesce: held event sent only once");
+}
+
+int main(void)
+{
+    Test_Modes();
+    Test_Coalescing();
+
+    return UT_Report("fswv1_deadline_test");
+}
@@ -0,0 +1,222 @@
+/******************************************************************************
+** File: fswv1_imu_parse_test.c
+**
+** Purpose:
+**   Unit test of the IMU frame parser (fswv1_imu_parse.c): CRC-16, COBS
+**   framing of binary frames and their error codes, and the ASCII frame
+**   fields and sender counter.
+**
+** Notes:
+**   Binary frames for the error cases are built here with a reference
+**   COBS encoder, so the CRC and length checks can be hit with framing
+**   that is itself valid. The raw layout is little-endian, as the host.
+**
+******************************************************************************/
+
+#include "fswv1_imu_parse.h"
+#include "ut_fswv1.h"
+#include <string.h>
+#include <math.h>
+
+static const float UT_Values[FSWV1_IMU_PARSE_FIELDS] = { 0.125f, -9.80665f, 1.5f, 0.0f, -250.25f, 3.0e-3f, 36.5f };
+
+/*
+** Reference COBS encoder (Cheshire & Baker); returns the length without
+** the 0x00 delimiter
+*/
+static size_t UT_CobsEncode(const uint8_t *In, size_t Length, uint8_t *Out)
+{
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    size_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        if (In[i] == 0)
+        {
+            Out[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+            continue;
+        }
+
+        Out[out++] = In[i];
+        if (++code == 0xFF)
+        {
+            Out[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+    }
+    Out[code_pos] = code;
+
+    return out;
+}
+
+/*
+** Raw FLOAT frame: Seq, values, CRC (+ CrcXor to corrupt it)
+*/
+static size_t UT_RawFrame(uint8_t Seq, const float Values[FSWV1_IMU_PARSE_FIELDS], uint16_t CrcXor, uint8_t *Raw)
+{
+    size_t len = 0;
+    uint16_t crc;
+
+    Raw[len++] = Seq;
+    memcpy(&Raw[len], Values, FSWV1_IMU_PARSE_FIELDS * sizeof(float));
+    len += FSWV1_IMU_PARSE_FIELDS * sizeof(float);
+
+    crc = FSWV1_IMU_Crc16(Raw, len) ^ CrcXor;
+    Raw[len++] = (uint8_t)(crc & 0xFF);
+    Raw[len++] = (uint8_t)(crc >> 8);
+
+    return len;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* CRC-16/CCITT-FALSE                                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Crc(void)
+{
+    const uint8_t check[] = "123456789";
+
+    UT_Check(FSWV1_IMU_Crc16(check, 9) == 0x29B1, "CRC: catalogue check value");
+    UT_Check(FSWV1_IMU_Crc16(check, 0) == 0xFFFF, "CRC: empty input gives the initial value");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Encode/decode round trips                                               */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_RoundTrip(void)
+{
+    uint8_t frame[FSWV1_IMU_BIN_MAX_ENCODED + 1];
+    uint8_t raw[FSWV1_IMU_BIN_MAX_DECODED];
+    uint8_t ref[FSWV1_IMU_BIN_MAX_ENCODED + 1];
+    float zeros[FSWV1_IMU_PARSE_FIELDS];
+    float values[FSWV1_IMU_PARSE_FIELDS];
+    size_t len;
+    size_t i;
+    uint8_t seq = 0;
+    int ok;
+
+    /* FLOAT: bit-exact values, no 0x00 before the delimiter */
+    len = FSWV1_IMU_EncodeBinary(UT_Values, 200, 0, frame);
+    ok = (len == FSWV1_IMU_BIN_FLOAT_LEN + 2) && frame[len - 1] == 0;
+    for (i = 0; i + 1 < len; i++)
+    {
+        ok = ok && frame[i] != 0;
+    }
+    UT_Check(ok, "COBS: FLOAT frame framed by a single trailing 0x00");
+    UT_Check(FSWV1_IMU_ParseBinary(frame, len - 1, values, &seq) == FSWV1_IMU_PARSE_OK &&
+             seq == 200 && memcmp(values, UT_Values, sizeof(values)) == 0, "COBS: FLOAT round trip");
+
+    /* Same bytes as the reference encoder */
+    UT_Check(UT_CobsEncode(raw, UT_RawFrame(200, UT_Values, 0, raw), ref) == len - 1 &&
+             memcmp(ref, frame, len - 1) == 0, "COBS: matches the reference encoder");
+
+    /* INT16: 19 bytes on the wire, values to the scale resolution */
+    len = FSWV1_IMU_EncodeBinary(UT_Values, 7, 1, frame);
+    UT_Check(len == 19 && frame[len - 1] == 0, "COBS: INT16 frame is 19 bytes");
+    ok = FSWV1_IMU_ParseBinary(frame, len - 1, values, &seq) == FSWV1_IMU_PARSE_OK && seq == 7;
+    for (i = 0; i < FSWV1_IMU_PARSE_FIELDS && ok; i++)
+    {
+        ok = fabsf(values[i] - UT_Values[i]) <= 0.5f / FSWV1_IMU_BIN_ACCEL_SCALE + 1e-6f ||
+             (i >= 3 && fabsf(values[i] - UT_Values[i]) <= 0.5f / FSWV1_IMU_BIN_GYRO_SCALE + 1e-6f);
+    }
+    UT_Check(ok, "COBS: INT16 round trip");
+
+    /* All-zero payload: every byte is stuffed */
+    memset(zeros, 0, sizeof(zeros));
+    len = FSWV1_IMU_EncodeBinary(zeros, 0, 0, frame);
+    UT_Check(FSWV1_IMU_ParseBinary(frame, len - 1, values, &seq) == FSWV1_IMU_PARSE_OK &&
+             seq == 0 && memcmp(values, zeros, sizeof(values)) == 0, "COBS: zero payload round trip");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Binary error codes                                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_BinaryErrors(void)
+{
+    uint8_t raw[FSWV1_IMU_BIN_MAX_DECODED + 8];
+    uint8_t enc[FSWV1_IMU_BIN_MAX_ENCODED + 16];
+    const uint8_t short_group[] = { 0x05, 0x11, 0x22 };
+    const uint8_t embedded_zero[] = { 0x03, 0x11, 0x00, 0x01 };
+    float values[FSWV1_IMU_PARSE_FIELDS];
+    uint8_t seq = 0x5A;
+    size_t raw_len;
+    size_t len;
+    uint16_t crc;
+
+    values[0] = 42.0f;
+
+    /* Valid framing, wrong CRC */
+    raw_len = UT_RawFrame(1, UT_Values, 0x0100, raw);
+    len = UT_CobsEncode(raw, raw_len, enc);
+    UT_Check(FSWV1_IMU_ParseBinary(enc, len, values, &seq) == FSWV1_IMU_PARSE_BAD_CRC,
+             "Binary: CRC mismatch detected");
+    UT_Check(values[0] == 42.0f && seq == 0x5A, "Binary: outputs untouched on failure");
+
+    /* Valid framing and CRC, unknown length */
+    raw_len = UT_RawFrame(1, UT_Values, 0, raw) - 2 - 1;
+    crc = FSWV1_IMU_Crc16(raw, raw_len);
+    raw[raw_len++] = (uint8_t)(crc & 0xFF);
+    raw[raw_len++] = (uint8_t)(crc >> 8);
+    len = UT_CobsEncode(raw, raw_len, enc);
+    UT_Check(FSWV1_IMU_ParseBinary(enc, len, values, &seq) == FSWV1_IMU_PARSE_BAD_LENGTH,
+             "Binary: unknown decoded length");
+
+    /* Broken COBS */
+    UT_Check(FSWV1_IMU_ParseBinary(short_group, sizeof(short_group), values, &seq) == FSWV1_IMU_PARSE_BAD_COBS,
+             "Binary: code byte past the end");
+    UT_Check(FSWV1_IMU_ParseBinary(embedded_zero, sizeof(embedded_zero), values, &seq) ==
+             FSWV1_IMU_PARSE_BAD_COBS, "Binary: 0x00 inside a frame");
+
+    /* Too long for any layout */
+    memset(enc, 0x01, sizeof(enc));
+    UT_Check(FSWV1_IMU_ParseBinary(enc, sizeof(enc), values, &seq) != FSWV1_IMU_PARSE_OK,
+             "Binary: oversized frame refused");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* ASCII frames                                                            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Ascii(void)
+{
+    float values[FSWV1_IMU_PARSE_FIELDS];
+    uint32_t seq = 0;
+    int has_seq = -1;
+    int bad_field = -1;
+
+    UT_Check(FSWV1_IMU_ParseFrameSeq("$,0.125,-9.80665,1.5,0,-250.25,3e-3,36.5,#", values, &bad_field,
+                                     &seq, &has_seq) == FSWV1_IMU_PARSE_OK &&
+             has_seq == 0 && memcmp(values, UT_Values, sizeof(values)) == 0, "ASCII: fields");
+
+    UT_Check(FSWV1_IMU_ParseFrameSeq("$,0.125,-9.80665,1.5,0,-250.25,3e-3,36.5,4294967295,#", values,
+                                     &bad_field, &seq, &has_seq) == FSWV1_IMU_PARSE_OK &&
+             has_seq == 1 && seq == 4294967295u, "ASCII: sender counter");
+
+    UT_Check(FSWV1_IMU_ParseFrame("$,1,2,x,4,5,6,7,#", values, &bad_field) == FSWV1_IMU_PARSE_BAD_FIELD &&
+             bad_field == 2 && values[1] == 2.0f, "ASCII: bad field index");
+    UT_Check(FSWV1_IMU_ParseFrame("$,1,2,3,4,5,6,#", values, &bad_field) == FSWV1_IMU_PARSE_BAD_FIELD &&
+             bad_field == 6, "ASCII: missing field");
+    UT_Check(FSWV1_IMU_ParseFrame("1,2,3,4,5,6,7,#", values, &bad_field) == FSWV1_IMU_PARSE_BAD_START,
+             "ASCII: missing start marker");
+}
+
+int main(void)
+{
+    Test_Crc();
+    Test_RoundTrip();
+    Test_BinaryErrors();
+    Test_Ascii();
+
+    return UT_Report("fswv1_imu_parse_test");
+}
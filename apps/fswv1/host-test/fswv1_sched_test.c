@@ -0,0 +1,164 @@
+/******************************************************************************
+** File: fswv1_sched_test.c
+**
+** Purpose:
+**   Unit test of the rate groups (fswv1_sched.c): FSWV1_SetRateGroup
+**   limits, and FSWV1_RateGroupDue run and skip accounting under wakeup
+**   jitter and late wakeups, at the configured wakeup rate.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "ut_fswv1.h"
+
+#define UT_CYCLE_NS (1000000000ULL / FSWV1_APP_WAKEUP_RATE_HZ)
+#define UT_MS       1000000ULL
+
+static uint32 UT_Rng = 2463534242u;
+
+/* Uniform in [-Span, Span] */
+static int64 UT_Jitter(int64 Span)
+{
+    UT_Rng ^= UT_Rng << 13;
+    UT_Rng ^= UT_Rng >> 17;
+    UT_Rng ^= UT_Rng << 5;
+
+    return (int64)(UT_Rng % (uint32)(2 * Span + 1)) - Span;
+}
+
+/*
+** Run Seconds of wakeups at the wakeup rate, each up to JitterNs off its
+** nominal time. Returns how many times Group was due.
+*/
+static uint32 UT_RunWakeups(uint8 Group, uint64 StartNs, uint32 Seconds, int64 JitterNs)
+{
+    uint32 cycles = Seconds * FSWV1_APP_WAKEUP_RATE_HZ;
+    uint32 due = 0;
+    uint32 i;
+
+    for (i = 1; i <= cycles; i++)
+    {
+        if (FSWV1_RateGroupDue(Group, StartNs + i * UT_CYCLE_NS + UT_Jitter(JitterNs)))
+        {
+            due++;
+        }
+    }
+
+    return due;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Rates above the wakeup rate and unknown groups are refused              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_SetRateGroup(void)
+{
+    UT_SetMonoNs(0);
+
+    UT_Check(FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_COUNT, 10) == CFE_ES_BAD_ARGUMENT,
+             "SetRateGroup: unknown group refused");
+    UT_Check(FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_IMU, FSWV1_APP_WAKEUP_RATE_HZ + 1) == CFE_ES_BAD_ARGUMENT,
+             "SetRateGroup: rate above the wakeup rate refused");
+    UT_Check(FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_IMU, FSWV1_APP_WAKEUP_RATE_HZ) == CFE_SUCCESS,
+             "SetRateGroup: wakeup rate accepted");
+    UT_Check(FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_BMP280, 25) == CFE_SUCCESS &&
+             FSWV1_APP_Data.ReadRate == 25, "SetRateGroup: BMP group sets ReadRate");
+
+    UT_Check(FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_HK, 0) == CFE_SUCCESS &&
+             !FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_HK, 10000 * UT_MS), "RateGroupDue: disabled group never due");
+    UT_Check(!FSWV1_RateGroupDue(FSWV1_APP_RATE_GROUP_COUNT, 10000 * UT_MS), "RateGroupDue: unknown group");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Jittery wakeups: every deadline runs once, none are skipped             */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Jitter(void)
+{
+    FSWV1_RateGroup_t *rg = &FSWV1_APP_Data.RateGroups[FSWV1_APP_RATE_GROUP_IMU];
+    uint32 due;
+
+    /* A group at the wakeup rate, wakeups up to 40% of a cycle off */
+    UT_SetMonoNs(0);
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_IMU, FSWV1_APP_WAKEUP_RATE_HZ);
+    rg->RunCount = 0;
+    rg->SkippedCount = 0;
+    due = UT_RunWakeups(FSWV1_APP_RATE_GROUP_IMU, 0, 10, (int64)UT_CYCLE_NS * 2 / 5);
+
+    UT_Check(due == 10 * FSWV1_APP_WAKEUP_RATE_HZ && rg->SkippedCount == 0,
+             "RateGroupDue: wakeup-rate group runs every jittery wakeup");
+
+    /* A slower group, same jitter: on average at its rate, no skips */
+    UT_SetMonoNs(0);
+    FSWV1_SetRateGroup(FSWV1_APP_RATE_GROUP_IMU, 25);
+    rg->RunCount = 0;
+    rg->SkippedCount = 0;
+    due = UT_RunWakeups(FSWV1_APP_RATE_GROUP_IMU, 0, 10, (int64)UT_CYCLE_NS * 2 / 5);
+
+    UT_Check(due >= 249 && due <= 250 && rg->SkippedCount == 0, "RateGroupDue: 25 Hz group under jitter");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* The default rates fit the wakeup rate: nothing is skipped              */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Defaults(void)
+{
+    uint32 skipped = 0;
+    uint8 g;
+
+    UT_SetMonoNs(0);
+    FSWV1_InitRateGroups();
+
+    for (g = 0; g < FSWV1_APP_RATE_GROUP_COUNT; g++)
+    {
+        FSWV1_APP_Data.RateGroups[g].SkippedCount = 0;
+        UT_RunWakeups(g, 0, 10, (int64)UT_CYCLE_NS * 2 / 5);
+        skipped += FSWV1_APP_Data.RateGroups[g].SkippedCount;
+    }
+
+    UT_Check(FSWV1_APP_Data.RateGroups[FSWV1_APP_RATE_GROUP_IMU].RateHz == FSWV1_APP_WAKEUP_RATE_HZ,
+             "InitRateGroups: IMU group runs every wakeup");
+    UT_Check(skipped == 0, "InitRateGroups: default rates skip nothing at the wakeup rate");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* A late wakeup runs the group once and counts the deadlines it missed   */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Skips(void)
+{
+    FSWV1_RateGroup_t *rg = &FSWV1_APP_Data.RateGroups[FSWV1_APP_RATE_GROUP_TLM];
+    uint8 g = FSWV1_APP_RATE_GROUP_TLM;
+
+    UT_SetMonoNs(0);
+    FSWV1_SetRateGroup(g, 25);   /* Deadlines every 40 ms from 40 ms */
+    rg->RunCount = 0;
+    rg->SkippedCount = 0;
+
+    UT_Check(FSWV1_RateGroupDue(g, 40 * UT_MS), "RateGroupDue: due at its deadline");
+    UT_Check(!FSWV1_RateGroupDue(g, 40 * UT_MS + UT_CYCLE_NS), "RateGroupDue: not due again a cycle later");
+
+    /* Next wakeup 100 ms late: deadlines 80, 120 and 160 ms have passed */
+    UT_Check(FSWV1_RateGroupDue(g, 180 * UT_MS), "RateGroupDue: late wakeup runs the group");
+    UT_Check(rg->RunCount == 2 && rg->SkippedCount == 2, "RateGroupDue: missed deadlines counted as skipped");
+
+    /* The schedule keeps its phase: next deadline at 200 ms */
+    UT_Check(!FSWV1_RateGroupDue(g, 180 * UT_MS + UT_CYCLE_NS), "RateGroupDue: not due before the next deadline");
+    UT_Check(FSWV1_RateGroupDue(g, 200 * UT_MS), "RateGroupDue: due at the next whole period");
+    UT_Check(rg->SkippedCount == 2, "RateGroupDue: no skips once back on time");
+}
+
+int main(void)
+{
+    Test_SetRateGroup();
+    Test_Jitter();
+    Test_Skips();
+    Test_Defaults();
+
+    return UT_Report("fswv1_sched_test");
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+** File: fswv1_simsrc_test.c
+**
+** Purpose:
+**   Unit test of the synthetic sensor source (fswv1_simsrc.c): sample
+**   rates and times, and determinism: two runs give the same samples, and
+**   so do runs that read on a different schedule.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "ut_fswv1.h"
+#include <string.h>
+
+#define UT_SECONDS   10
+#define UT_BMP_COUNT (UT_SECONDS * FSWV1_SIM_BMP_RATE_HZ)
+#define UT_IMU_COUNT (UT_SECONDS * FSWV1_SIM_IMU_RATE_HZ)
+#define UT_CYCLE_NS  (1000000000ULL / FSWV1_APP_CYCLE_RATE_HZ)
+
+/*
+** Everything one run collected
+*/
+typedef struct
+{
+    FSWV1_SensorData_t Bmp[UT_BMP_COUNT];
+    FSWV1_IMUData_t    Imu[UT_IMU_COUNT];
+    uint32 BmpCount;
+    uint32 ImuCount;
+} UT_SimRun_t;
+
+static UT_SimRun_t UT_RunA;
+static UT_SimRun_t UT_RunB;
+
+/*
+** Run UT_SECONDS of simulated cycles. Every Stride-th cycle, and the last,
+** triggers and collects the barometer and reads the IMU, at most
+** MaxSamples per call.
+*/
+static void UT_Run(UT_SimRun_t *Run, uint32 Stride, uint32 MaxSamples)
+{
+    uint32 cycles = UT_SECONDS * FSWV1_APP_CYCLE_RATE_HZ;
+    uint32 count;
+    uint32 c;
+
+    memset(Run, 0, sizeof(*Run));
+    FSWV1_SimSrc_Reset();
+
+    for (c = 1; c <= cycles; c++)
+    {
+        UT_SetMonoNs((uint64)c * UT_CYCLE_NS);
+        if (c % Stride != 0 && c != cycles)
+        {
+            continue;
+        }
+
+        FSWV1_SimSrc_TriggerSensors();
+        do
+        {
+            FSWV1_SimSrc_ReadSensors(&Run->Bmp[Run->BmpCount], MaxSamples, &count);
+            Run->BmpCount += count;
+        } while (count == MaxSamples);
+
+        do
+        {
+            FSWV1_SimSrc_ReadIMU(&Run->Imu[Run->ImuCount], MaxSamples, &count);
+            Run->ImuCount += count;
+        } while (count == MaxSamples);
+    }
+}
+
+/* Field by field, so struct padding does not matter */
+static bool UT_SameRuns(const UT_SimRun_t *A, const UT_SimRun_t *B)
+{
+    uint32 i;
+
+    if (A->BmpCount != B->BmpCount || A->ImuCount != B->ImuCount)
+    {
+        return false;
+    }
+
+    for (i = 0; i < A->BmpCount; i++)
+    {
+        if (A->Bmp[i].Temperature != B->Bmp[i].Temperature || A->Bmp[i].Pressure != B->Bmp[i].Pressure ||
+            A->Bmp[i].ArrivalNs != B->Bmp[i].ArrivalNs ||
+            A->Bmp[i].Timestamp.Seconds != B->Bmp[i].Timestamp.Seconds ||
+            A->Bmp[i].Timestamp.Subseconds != B->Bmp[i].Timestamp.Subseconds ||
+            A->Bmp[i].Instance != B->Bmp[i].Instance)
+        {
+            return false;
+        }
+    }
+
+    for (i = 0; i < A->ImuCount; i++)
+    {
+        if (A->Imu[i].Accel_X != B->Imu[i].Accel_X || A->Imu[i].Accel_Y != B->Imu[i].Accel_Y ||
+            A->Imu[i].Accel_Z != B->Imu[i].Accel_Z || A->Imu[i].Gyro_X != B->Imu[i].Gyro_X ||
+            A->Imu[i].Gyro_Y != B->Imu[i].Gyro_Y || A->Imu[i].Gyro_Z != B->Imu[i].Gyro_Z ||
+            A->Imu[i].Temperature != B->Imu[i].Temperature || A->Imu[i].ArrivalNs != B->Imu[i].ArrivalNs ||
+            A->Imu[i].Timestamp.Seconds != B->Imu[i].Timestamp.Seconds ||
+            A->Imu[i].Timestamp.Subseconds != B->Imu[i].Timestamp.Subseconds ||
+            A->Imu[i].Instance != B->Imu[i].Instance)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* One sample per period of simulated time, stamped with that time         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Rates(void)
+{
+    uint64 bmp_period = 1000000000ULL / FSWV1_SIM_BMP_RATE_HZ;
+    uint64 imu_period = 1000000000ULL / FSWV1_SIM_IMU_RATE_HZ;
+    bool ok = true;
+    uint32 i;
+
+    UT_Run(&UT_RunA, 1, FSWV1_IMU_DRAIN_MAX);
+
+    UT_Check(UT_RunA.BmpCount == UT_BMP_COUNT && UT_RunA.ImuCount == UT_IMU_COUNT,
+             "SimSrc: one sample per period");
+
+    for (i = 0; i < UT_RunA.BmpCount; i++)
+    {
+        ok = ok && UT_RunA.Bmp[i].ArrivalNs == (i + 1) * bmp_period &&
+             UT_RunA.Bmp[i].Instance == FSWV1_BMP_PRIMARY_INSTANCE &&
+             UT_RunA.Bmp[i].Pressure > 1012.0f && UT_RunA.Bmp[i].Pressure < 1014.5f;
+    }
+    for (i = 0; i < UT_RunA.ImuCount; i++)
+    {
+        ok = ok && UT_RunA.Imu[i].ArrivalNs == (i + 1) * imu_period &&
+             UT_RunA.Imu[i].Instance == FSWV1_IMU_PRIMARY_INSTANCE &&
+             UT_RunA.Imu[i].Accel_Z > 9.7f && UT_RunA.Imu[i].Accel_Z < 9.9f;
+    }
+    UT_Check(ok, "SimSrc: samples at their period, values in range");
+    UT_Check(UT_RunA.Bmp[0].Pressure != UT_RunA.Bmp[1].Pressure &&
+             UT_RunA.Imu[0].Accel_X != UT_RunA.Imu[1].Accel_X, "SimSrc: samples carry noise");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Same samples on every run, whatever the read schedule                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Determinism(void)
+{
+    UT_Run(&UT_RunA, 1, FSWV1_IMU_DRAIN_MAX);
+    UT_Run(&UT_RunB, 1, FSWV1_IMU_DRAIN_MAX);
+    UT_Check(UT_SameRuns(&UT_RunA, &UT_RunB), "SimSrc: two runs give identical samples");
+
+    /* Reads every 7th cycle, a few samples at a time */
+    UT_Run(&UT_RunB, 7, 3);
+    UT_Check(UT_SameRuns(&UT_RunA, &UT_RunB), "SimSrc: read schedule does not change the samples");
+}
+
+int main(void)
+{
+    Test_Rates();
+    Test_Determinism();
+
+    return UT_Report("fswv1_simsrc_test");
+}
@@ -0,0 +1,221 @@
+/******************************************************************************
+** File: fswv1_ttq_test.c
+**
+** Purpose:
+**   Unit test of the time-tagged command queue (fswv1_ttq.c): heap order,
+**   ties, capacity and argument checks, and the cycle and timeout windows.
+**
+** Notes:
+**   FSWV1_APP_ProcessGroundCommand is replaced by a recorder. Every queued
+**   command carries its tag (ms) and queue index in its arguments so the
+**   execution order can be checked against the tags.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "ut_fswv1.h"
+#include <string.h>
+
+#define UT_TTQ_MAX_RUNS 64
+
+typedef struct
+{
+    uint16 CommandCode;
+    uint32 TagMs;
+    uint32 Index;
+    uint64 RunNs;
+} UT_TtqRun_t;
+
+static UT_TtqRun_t UT_Runs[UT_TTQ_MAX_RUNS];
+static uint32 UT_RunCount = 0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Command dispatcher replacement                                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void FSWV1_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
+{
+    const uint8 *args = (const uint8 *)SBBufPtr + sizeof(CFE_MSG_CommandHeader_t);
+    UT_TtqRun_t *run;
+
+    if (UT_RunCount >= UT_TTQ_MAX_RUNS)
+    {
+        return;
+    }
+
+    run = &UT_Runs[UT_RunCount++];
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &run->CommandCode);
+    memcpy(&run->TagMs, &args[0], sizeof(run->TagMs));
+    memcpy(&run->Index, &args[4], sizeof(run->Index));
+    run->RunNs = UT_GetMonoNs();
+}
+
+static CFE_TIME_SysTime_t UT_MsToTime(uint32 Ms)
+{
+    return FSWV1_Time_MonoToTime((uint64)Ms * 1000000ULL);
+}
+
+static int32 UT_Queue(uint32 TagMs, uint32 Index)
+{
+    uint8 args[8];
+
+    memcpy(&args[0], &TagMs, sizeof(TagMs));
+    memcpy(&args[4], &Index, sizeof(Index));
+
+    return FSWV1_TTQ_Insert(UT_MsToTime(TagMs), FSWV1_APP_NOOP_CC, args, sizeof(args));
+}
+
+static void UT_Reset(uint64 NowNs)
+{
+    FSWV1_TTQ_Init();
+    UT_RunCount = 0;
+    UT_SetMonoNs(NowNs);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Commands run in tag order; equal tags run in queue order                */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_HeapOrder(void)
+{
+    uint32 state = 12345;
+    uint32 tags[FSWV1_TTQ_CAPACITY];
+    uint32 i;
+    bool ok = true;
+
+    UT_Reset(1000000000ULL);
+
+    for (i = 0; i < FSWV1_TTQ_CAPACITY; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        tags[i] = 2000 + (state >> 16) % 16;   /* Many duplicates */
+        ok = ok && (UT_Queue(tags[i], i) == CFE_SUCCESS);
+    }
+    UT_Check(ok, "TTQ: insert up to capacity");
+    UT_Check(FSWV1_APP_Data.Ttq.Occupancy == FSWV1_TTQ_CAPACITY &&
+             FSWV1_APP_Data.Ttq.HighWater == FSWV1_TTQ_CAPACITY, "TTQ: occupancy and high water");
+
+    /* Everything is due: one pass runs the whole queue */
+    UT_SetMonoNs(3000000000ULL);
+    FSWV1_TTQ_Process(UT_GetMonoNs());
+
+    UT_Check(UT_RunCount == FSWV1_TTQ_CAPACITY, "TTQ: all due commands run");
+    for (i = 0; i < UT_RunCount; i++)
+    {
+        ok = ok && UT_Runs[i].CommandCode == FSWV1_APP_NOOP_CC && UT_Runs[i].TagMs == tags[UT_Runs[i].Index];
+        if (i > 0)
+        {
+            ok = ok && (UT_Runs[i - 1].TagMs < UT_Runs[i].TagMs ||
+                        (UT_Runs[i - 1].TagMs == UT_Runs[i].TagMs && UT_Runs[i - 1].Index < UT_Runs[i].Index));
+        }
+    }
+    UT_Check(ok, "TTQ: tag order, ties in queue order");
+    UT_Check(FSWV1_APP_Data.Ttq.Occupancy == 0 && FSWV1_APP_Data.Ttq.ExecutedCount == FSWV1_TTQ_CAPACITY,
+             "TTQ: queue empty after the pass");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Full queue, nested time tags and oversized arguments are refused       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Rejects(void)
+{
+    uint8 args[FSWV1_TTQ_MAX_ARG_BYTES + 1];
+    uint32 i;
+
+    UT_Reset(0);
+    memset(args, 0, sizeof(args));
+
+    UT_Check(FSWV1_TTQ_Insert(UT_MsToTime(10), FSWV1_APP_TIME_TAG_CC, args, 0) == CFE_ES_BAD_ARGUMENT,
+             "TTQ: TIME_TAG_CC cannot be queued");
+    UT_Check(FSWV1_TTQ_Insert(UT_MsToTime(10), FSWV1_APP_NOOP_CC, args, sizeof(args)) == CFE_ES_BAD_ARGUMENT,
+             "TTQ: oversized arguments refused");
+
+    for (i = 0; i < FSWV1_TTQ_CAPACITY; i++)
+    {
+        UT_Queue(10 + i, i);
+    }
+    UT_Check(UT_Queue(5, 99) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "TTQ: full queue refuses");
+
+    FSWV1_TTQ_Clear();
+    UT_Check(FSWV1_APP_Data.Ttq.Occupancy == 0, "TTQ: clear empties the queue");
+    UT_SetMonoNs(1000000000ULL);
+    FSWV1_TTQ_Process(UT_GetMonoNs());
+    UT_Check(UT_RunCount == 0, "TTQ: cleared commands do not run");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Tags inside the window are waited for, later ones are left queued       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Window(void)
+{
+    uint64 start = 10000000000ULL;   /* 10 s */
+    uint64 window = (uint64)FSWV1_TTQ_LOOKAHEAD_US * 1000;
+
+    UT_Reset(start);
+
+    UT_Queue(10000 + 1, 0);                                   /* 1 ms into the cycle */
+    UT_Queue(10000 + 2, 1);                                   /* 2 ms */
+    UT_Queue(10000 + FSWV1_TTQ_LOOKAHEAD_US / 1000 + 5, 2);   /* After the window */
+
+    FSWV1_TTQ_Process(start + window);
+
+    UT_Check(UT_RunCount == 2, "TTQ window: commands inside the window run");
+    UT_Check(UT_RunCount == 2 && UT_Runs[0].RunNs >= start + 999000 && UT_Runs[0].RunNs <= start + 1000000 &&
+             UT_Runs[1].RunNs >= start + 1999000 && UT_Runs[1].RunNs <= start + 2000000,
+             "TTQ window: each runs at its tag");
+    UT_Check(FSWV1_APP_Data.Ttq.Occupancy == 1 && FSWV1_APP_Data.Ttq.LateCount == 0,
+             "TTQ window: later command left queued, none late");
+
+    /* The next pass comes 10 ms after the last tag */
+    UT_SetMonoNs(start + (FSWV1_TTQ_LOOKAHEAD_US / 1000 + 15) * 1000000ULL);
+    FSWV1_TTQ_Process(UT_GetMonoNs() + window);
+
+    UT_Check(UT_RunCount == 3 && UT_Runs[2].Index == 2, "TTQ window: left command runs next pass");
+    UT_Check(FSWV1_APP_Data.Ttq.LateCount == 1 && FSWV1_APP_Data.Ttq.MaxLateUs >= 9999 &&
+             FSWV1_APP_Data.Ttq.MaxLateUs <= 10000, "TTQ window: lateness recorded");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* With wakeups stopped, tags before the next timeout still run on time    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_TimeoutWindow(void)
+{
+    uint64 start = 20000000000ULL;   /* 20 s, long after the last wakeup */
+    uint64 window = (uint64)FSWV1_APP_WAKEUP_TIMEOUT_MS * 1000000ULL;
+
+    UT_Reset(start);
+
+    UT_Queue(20000 + FSWV1_APP_WAKEUP_TIMEOUT_MS / 4, 0);
+    UT_Queue(20000 + FSWV1_APP_WAKEUP_TIMEOUT_MS / 2, 1);
+    UT_Queue(20000 + FSWV1_APP_WAKEUP_TIMEOUT_MS * 3 / 2, 2);   /* After the next timeout */
+
+    FSWV1_TTQ_Process(start + window);
+
+    UT_Check(UT_RunCount == 2 && FSWV1_APP_Data.Ttq.LateCount == 0,
+             "TTQ timeout: commands before the next timeout run on time");
+    UT_Check(FSWV1_APP_Data.Ttq.Occupancy == 1, "TTQ timeout: later command left for the next pass");
+
+    UT_SetMonoNs(start + window);
+    FSWV1_TTQ_Process(UT_GetMonoNs() + window);
+
+    UT_Check(UT_RunCount == 3 && UT_Runs[2].Index == 2 && FSWV1_APP_Data.Ttq.LateCount == 0,
+             "TTQ timeout: next pass runs it on time");
+}
+
+int main(void)
+{
+    Test_HeapOrder();
+    Test_Rejects();
+    Test_Window();
+    Test_TimeoutWindow();
+
+    return UT_Report("fswv1_ttq_test");
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+** File: fswv1_uart_test.c
+**
+** Purpose:
+**   Unit test of the IMU UART drain (fswv1_uart.c) with two instances:
+**   FSWV1_ReadUARTFrames merges them in arrival order and keeps the newest
+**   samples when the batch is full; FSWV1_ReadUART pops one sample at a
+**   time and drops nothing.
+**
+** Notes:
+**   Built with UART_DEVICES "imu0","imu1". FSWV1_Serial_Open hands out the
+**   read ends of two pipes and reports no baud rate, so every frame is
+**   stamped with the fake clock at the read() that returned it.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "fswv1_serial.h"
+#include "ut_fswv1.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define UT_MS 1000000ULL
+
+static int UT_Pipes[2][2];
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Serial port and RT replacements                                         */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int FSWV1_Serial_Open(const char *Device, const FSWV1_SerialConfig_t *Config, FSWV1_SerialInfo_t *Info)
+{
+    int instance = (strcmp(Device, "imu1") == 0) ? 1 : 0;
+
+    if (Info != NULL)
+    {
+        Info->ActualBaud = 0;
+        Info->Warnings = 0;
+        Info->FailedStep = "open";
+    }
+
+    return UT_Pipes[instance][0];
+}
+
+void FSWV1_Serial_Close(int Fd)
+{
+    close(Fd);
+}
+
+int32 FSWV1_RT_RegisterTask(uint8 Task)
+{
+    return CFE_SUCCESS;
+}
+
+void FSWV1_RT_UnregisterTask(uint8 Task)
+{
+}
+
+/*
+** Send one ASCII frame with Accel_X = Value on Instance at time Ms, and
+** let the event loop path read it
+*/
+static void UT_Send(uint8 Instance, uint32 Ms, float Value)
+{
+    char frame[64];
+    int len;
+
+    len = snprintf(frame, sizeof(frame), "$,%g,0,0,0,0,0,25,#", (double)Value);
+    if (write(UT_Pipes[Instance][1], frame, (size_t)len) != len)
+    {
+        UT_Check(0, "UART: pipe write");
+    }
+
+    UT_SetMonoNs((uint64)Ms * UT_MS);
+    FSWV1_ServiceUART();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Samples of both instances come out in arrival order                     */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Merge(void)
+{
+    FSWV1_IMUData_t samples[8];
+    uint32 count = 0;
+
+    UT_Send(1, 100, 1.0f);
+    UT_Send(0, 200, 2.0f);
+    UT_Send(1, 300, 3.0f);
+    UT_Send(0, 400, 4.0f);
+
+    UT_Check(FSWV1_ReadUARTFrames(samples, 8, &count) == CFE_SUCCESS && count == 4, "Merge: all samples returned");
+    UT_Check(count == 4 && samples[0].Accel_X == 1.0f && samples[1].Accel_X == 2.0f &&
+             samples[2].Accel_X == 3.0f && samples[3].Accel_X == 4.0f, "Merge: arrival order across instances");
+    UT_Check(count == 4 && samples[0].Instance == 1 && samples[1].Instance == 0 && samples[2].Instance == 1 &&
+             samples[3].Instance == 0, "Merge: instance recorded");
+    UT_Check(count == 4 && samples[0].ArrivalNs == 100 * UT_MS && samples[3].ArrivalNs == 400 * UT_MS &&
+             samples[3].Timestamp.Seconds == 0, "Merge: arrival times");
+
+    UT_Check(FSWV1_ReadUARTFrames(samples, 8, &count) == CFE_SUCCESS && count == 0, "Merge: nothing left");
+    UT_Check(FSWV1_ReadUARTFrames(samples, 0, &count) == CFE_ES_BAD_ARGUMENT, "Merge: empty batch refused");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* A full batch keeps the newest samples and counts the rest as dropped    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_Drop(void)
+{
+    FSWV1_IMUData_t samples[3];
+    uint32 dropped = FSWV1_GetIMUDrainDropped();
+    uint32 count = 0;
+    uint32 i;
+
+    for (i = 1; i <= 7; i++)
+    {
+        UT_Send((uint8)(i % 2), 1000 + 10 * i, (float)i);
+    }
+
+    UT_Check(FSWV1_ReadUARTFrames(samples, 3, &count) == CFE_SUCCESS && count == 3, "Drop: batch filled");
+    UT_Check(count == 3 && samples[0].Accel_X == 5.0f && samples[1].Accel_X == 6.0f && samples[2].Accel_X == 7.0f,
+             "Drop: newest samples kept, oldest first");
+    UT_Check(FSWV1_GetIMUDrainDropped() - dropped == 4, "Drop: older samples counted");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* FSWV1_ReadUART pops the oldest sample and leaves the rest queued        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void Test_ReadOne(void)
+{
+    FSWV1_IMUData_t sample;
+    uint32 dropped = FSWV1_GetIMUDrainDropped();
+    bool ok = true;
+    uint32 i;
+
+    UT_Send(0, 2000, 10.0f);
+    UT_Send(1, 2010, 11.0f);
+    UT_Send(0, 2020, 12.0f);
+
+    for (i = 0; i < 3; i++)
+    {
+        ok = ok && FSWV1_ReadUART(&sample) == CFE_SUCCESS && sample.Accel_X == 10.0f + (float)i;
+    }
+    UT_Check(ok, "ReadUART: one sample per call, oldest first");
+    UT_Check(FSWV1_ReadUART(&sample) == OS_ERROR, "ReadUART: empty afterwards");
+    UT_Check(FSWV1_GetIMUDrainDropped() == dropped, "ReadUART: nothing dropped");
+}
+
+int main(void)
+{
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        if (pipe(UT_Pipes[i]) != 0)
+        {
+            perror("pipe");
+            return 1;
+        }
+        fcntl(UT_Pipes[i][0], F_SETFL, O_NONBLOCK);
+    }
+
+    UT_Check(FSWV1_InitUART() == CFE_SUCCESS, "UART: both instances open");
+
+    Test_Merge();
+    Test_Drop();
+    Test_ReadOne();
+
+    FSWV1_CloseUART();
+
+    return UT_Report("fswv1_uart_test");
+}
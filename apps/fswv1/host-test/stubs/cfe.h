@@ -0,0 +1,135 @@
+/******************************************************************************
+** File: cfe.h
+**
+** Purpose:
+**   Host stand-in for the cFE API, used only by the FSWV1 unit tests.
+**   Declares the types and calls the modules under test use; the message
+**   layout is simplified and ut_cfe_stubs.c implements the calls.
+**
+******************************************************************************/
+
+#ifndef FSWV1_UT_CFE_H
+#define FSWV1_UT_CFE_H
+
+#include "common_types.h"
+#include "osapi.h"
+
+/*
+** Status codes
+*/
+typedef int32 CFE_Status_t;
+
+#define CFE_SUCCESS                         ((int32)0)
+#define CFE_ES_BAD_ARGUMENT                 ((int32)0xc4000002)
+#define CFE_SB_TIME_OUT                     ((int32)0xca00000e)
+#define CFE_SB_NO_MESSAGE                   ((int32)0xca00000f)
+#define CFE_STATUS_WRONG_MSG_LENGTH         ((int32)0xc8000002)
+#define CFE_STATUS_VALIDATION_FAILURE       ((int32)0xc8000003)
+#define CFE_STATUS_REQUEST_ALREADY_PENDING  ((int32)0xc8000004)
+#define CFE_STATUS_EXTERNAL_RESOURCE_FAIL   ((int32)0xc8000005)
+#define CFE_STATUS_INCORRECT_STATE          ((int32)0xc8000006)
+#define CFE_STATUS_NOT_IMPLEMENTED          ((int32)0xc800ffff)
+
+/*
+** Executive services
+*/
+typedef osal_id_t CFE_ES_TaskId_t;
+typedef void (*CFE_ES_ChildTaskMainFuncPtr_t)(void);
+typedef void *CFE_ES_StackPointer_t;
+
+#define CFE_ES_TASKID_UNDEFINED     ((CFE_ES_TaskId_t)0)
+#define CFE_ES_TASK_STACK_ALLOCATE  NULL
+
+enum
+{
+    CFE_ES_RunStatus_APP_RUN = 1,
+    CFE_ES_RunStatus_APP_EXIT,
+    CFE_ES_RunStatus_APP_ERROR
+};
+
+int32 CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName,
+                             CFE_ES_ChildTaskMainFuncPtr_t FunctionPtr, CFE_ES_StackPointer_t StackPtr,
+                             size_t StackSize, osal_priority_t Priority, uint32 Flags);
+int32 CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId);
+void  CFE_ES_ExitChildTask(void);
+
+/*
+** Event services
+*/
+typedef struct
+{
+    uint16 EventID;
+    uint16 Mask;
+} CFE_EVS_BinFilter_t;
+
+enum
+{
+    CFE_EVS_EventType_DEBUG = 1,
+    CFE_EVS_EventType_INFORMATION,
+    CFE_EVS_EventType_ERROR,
+    CFE_EVS_EventType_CRITICAL
+};
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/*
+** Messages (primary header only; the function code lives in Sec[0])
+*/
+typedef struct
+{
+    uint8 Bytes[8];
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8 Sec[2];
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8 Sec[6];
+    uint8 Spare[4];
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+    CFE_MSG_Message_t Msg;
+    long long int ForceAlign;
+} CFE_SB_Buffer_t;
+
+typedef uint32    CFE_SB_MsgId_t;
+typedef uint32    CFE_SB_MsgId_Atom_t;
+typedef osal_id_t CFE_SB_PipeId_t;
+typedef uint16    CFE_MSG_FcnCode_t;
+typedef size_t    CFE_MSG_Size_t;
+
+#define CFE_SB_INVALID_PIPE     ((CFE_SB_PipeId_t)0)
+#define CFE_SB_POLL             0
+#define CFE_SB_PEND_FOREVER     (-1)
+
+CFE_SB_MsgId_t      CFE_SB_ValueToMsgId(CFE_SB_MsgId_Atom_t MsgIdValue);
+CFE_SB_MsgId_Atom_t CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId);
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode);
+
+/*
+** Time services
+*/
+typedef struct
+{
+    uint32 Seconds;
+    uint32 Subseconds;
+} CFE_TIME_SysTime_t;
+
+#endif /* FSWV1_UT_CFE_H */
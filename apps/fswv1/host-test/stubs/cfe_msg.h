@@ -0,0 +1,4 @@
+/*
+** Host stand-in, see cfe.h
+*/
+#include "cfe.h"
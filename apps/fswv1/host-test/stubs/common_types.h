@@ -0,0 +1,29 @@
+/******************************************************************************
+** File: common_types.h
+**
+** Purpose:
+**   Host stand-in for the OSAL common types, used only by the FSWV1 unit
+**   tests (see host-test/CMakeLists.txt).
+**
+******************************************************************************/
+
+#ifndef FSWV1_UT_COMMON_TYPES_H
+#define FSWV1_UT_COMMON_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint8_t   uint8;
+typedef int8_t    int8;
+typedef uint16_t  uint16;
+typedef int16_t   int16;
+typedef uint32_t  uint32;
+typedef int32_t   int32;
+typedef uint64_t  uint64;
+typedef int64_t   int64;
+typedef uintptr_t cpuaddr;
+
+#define CompileTimeAssert(Condition, Message) typedef char Message[(Condition) ? 1 : -1]
+
+#endif /* FSWV1_UT_COMMON_TYPES_H */
@@ -0,0 +1,47 @@
+/******************************************************************************
+** File: osapi.h
+**
+** Purpose:
+**   Host stand-in for the OSAL API, used only by the FSWV1 unit tests.
+**   Declares what the modules under test call; ut_cfe_stubs.c implements
+**   it without any real OS objects.
+**
+******************************************************************************/
+
+#ifndef FSWV1_UT_OSAPI_H
+#define FSWV1_UT_OSAPI_H
+
+#include "common_types.h"
+
+typedef uint32 osal_id_t;
+typedef uint32 osal_priority_t;
+
+#define OS_OBJECT_ID_UNDEFINED  ((osal_id_t)0)
+
+#define OS_SUCCESS              0
+#define OS_ERROR                (-1)
+#define OS_INVALID_POINTER      (-2)
+#define OS_SEM_TIMEOUT          (-10)
+
+#define OS_SEM_EMPTY            0
+#define OS_SEM_FULL             1
+
+void  OS_printf(const char *String, ...) __attribute__((format(printf, 1, 2)));
+bool  OS_ObjectIdDefined(osal_id_t ObjectId);
+
+int32 OS_TimerCreate(osal_id_t *TimerId, const char *TimerName, uint32 *Accuracy,
+                     void (*CallbackPtr)(osal_id_t TimerId));
+int32 OS_TimerSet(osal_id_t TimerId, uint32 StartTime, uint32 IntervalTime);
+int32 OS_TimerDelete(osal_id_t TimerId);
+
+int32 OS_CountSemCreate(osal_id_t *SemId, const char *SemName, uint32 InitialValue, uint32 Options);
+int32 OS_CountSemGive(osal_id_t SemId);
+int32 OS_CountSemTimedWait(osal_id_t SemId, uint32 Msecs);
+int32 OS_CountSemDelete(osal_id_t SemId);
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 InitialValue, uint32 Options);
+int32 OS_BinSemGive(osal_id_t SemId);
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs);
+int32 OS_BinSemDelete(osal_id_t SemId);
+
+#endif /* FSWV1_UT_OSAPI_H */
@@ -0,0 +1,249 @@
+/******************************************************************************
+** File: ut_cfe_stubs.c
+**
+** Purpose:
+**   This file implements the host stand-in cFE/OSAL calls of the FSWV1
+**   unit tests. Object creation always succeeds, the software bus has no
+**   traffic, and events are counted for UT_EventCount.
+**
+******************************************************************************/
+
+#include "cfe.h"
+#include "ut_fswv1.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UT_MAX_EVENT_ID 256
+
+static uint32 UT_Events[UT_MAX_EVENT_ID];
+static uint32 UT_EventsTotal = 0;
+static osal_id_t UT_NextId = 1;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Event recorder                                                          */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void UT_ResetEvents(void)
+{
+    memset(UT_Events, 0, sizeof(UT_Events));
+    UT_EventsTotal = 0;
+}
+
+uint32_t UT_EventCount(uint16_t EventID)
+{
+    return (EventID < UT_MAX_EVENT_ID) ? UT_Events[EventID] : 0;
+}
+
+uint32_t UT_EventTotal(void)
+{
+    return UT_EventsTotal;
+}
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    va_list args;
+
+    if (EventID < UT_MAX_EVENT_ID)
+    {
+        UT_Events[EventID]++;
+    }
+    UT_EventsTotal++;
+
+    if (getenv("FSWV1_UT_VERBOSE") != NULL)
+    {
+        printf("EVS %u/%u: ", (unsigned)EventID, (unsigned)EventType);
+        va_start(args, Spec);
+        vprintf(Spec, args);
+        va_end(args);
+        printf("\n");
+    }
+
+    return CFE_SUCCESS;
+}
+
+void OS_printf(const char *String, ...)
+{
+    va_list args;
+
+    if (getenv("FSWV1_UT_VERBOSE") != NULL)
+    {
+        va_start(args, String);
+        vprintf(String, args);
+        va_end(args);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* OSAL objects: IDs only                                                  */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool OS_ObjectIdDefined(osal_id_t ObjectId)
+{
+    return ObjectId != OS_OBJECT_ID_UNDEFINED;
+}
+
+int32 OS_TimerCreate(osal_id_t *TimerId, const char *TimerName, uint32 *Accuracy,
+                     void (*CallbackPtr)(osal_id_t TimerId))
+{
+    *TimerId = UT_NextId++;
+    *Accuracy = 0;
+    return OS_SUCCESS;
+}
+
+int32 OS_TimerSet(osal_id_t TimerId, uint32 StartTime, uint32 IntervalTime)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_TimerDelete(osal_id_t TimerId)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_CountSemCreate(osal_id_t *SemId, const char *SemName, uint32 InitialValue, uint32 Options)
+{
+    *SemId = UT_NextId++;
+    return OS_SUCCESS;
+}
+
+int32 OS_CountSemGive(osal_id_t SemId)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_CountSemTimedWait(osal_id_t SemId, uint32 Msecs)
+{
+    return OS_SEM_TIMEOUT;
+}
+
+int32 OS_CountSemDelete(osal_id_t SemId)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 InitialValue, uint32 Options)
+{
+    *SemId = UT_NextId++;
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemGive(osal_id_t SemId)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemDelete(osal_id_t SemId)
+{
+    return OS_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Executive services: child tasks are never started                       */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName,
+                             CFE_ES_ChildTaskMainFuncPtr_t FunctionPtr, CFE_ES_StackPointer_t StackPtr,
+                             size_t StackSize, osal_priority_t Priority, uint32 Flags)
+{
+    return CFE_STATUS_NOT_IMPLEMENTED;
+}
+
+int32 CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId)
+{
+    return CFE_SUCCESS;
+}
+
+void CFE_ES_ExitChildTask(void)
+{
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Software bus: pipes exist but never receive anything                    */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(CFE_SB_MsgId_Atom_t MsgIdValue)
+{
+    return MsgIdValue;
+}
+
+CFE_SB_MsgId_Atom_t CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId)
+{
+    return MsgId;
+}
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    *PipeIdPtr = UT_NextId++;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    return (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Message header access                                                   */
+/* Bytes[0..3] hold the message ID and Bytes[4..7] the size, both in host  */
+/* order; the command function code is Sec[0] of the command header.      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+    uint32 size = (uint32)Size;
+
+    memset(MsgPtr, 0, Size);
+    memcpy(&MsgPtr->Bytes[0], &MsgId, sizeof(MsgId));
+    memcpy(&MsgPtr->Bytes[4], &size, sizeof(size));
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+    memcpy(MsgId, &MsgPtr->Bytes[0], sizeof(*MsgId));
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+    uint32 size;
+
+    memcpy(&size, &MsgPtr->Bytes[4], sizeof(size));
+    *Size = size;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+    *FcnCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->Sec[0];
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+    ((CFE_MSG_CommandHeader_t *)MsgPtr)->Sec[0] = (uint8)FcnCode;
+    return CFE_SUCCESS;
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+** File: ut_check.c
+**
+** Purpose:
+**   This file contains the result checks of the FSWV1 unit tests.
+**
+******************************************************************************/
+
+#include "ut_fswv1.h"
+#include <stdio.h>
+
+static uint32_t UT_Checks = 0;
+static uint32_t UT_Failures = 0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Record one check                                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void UT_Check(int Ok, const char *What)
+{
+    UT_Checks++;
+
+    if (!Ok)
+    {
+        printf("FAIL: %s\n", What);
+        UT_Failures++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Print the summary and return the exit status                            */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int UT_Report(const char *Name)
+{
+    if (UT_Failures > 0)
+    {
+        printf("%s: %u of %u checks FAILED\n", Name, (unsigned)UT_Failures, (unsigned)UT_Checks);
+        return 1;
+    }
+
+    printf("%s: all %u checks passed\n", Name, (unsigned)UT_Checks);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+** File: ut_fakes.c
+**
+** Purpose:
+**   This file contains the app-level fakes of the FSWV1 unit tests: the
+**   global app data and a fake clock in place of fswv1_time.c.
+**
+** Notes:
+**   CFE time is the fake monotonic time itself (seconds and 2^-32 second
+**   subseconds), so a test can reason about both with one number.
+**
+******************************************************************************/
+
+#include "fswv1_app.h"
+#include "ut_fswv1.h"
+
+/*
+** Global app data used by the modules under test
+*/
+FSWV1_APP_Data_t FSWV1_APP_Data;
+
+static uint64 UT_MonoNs = 0;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* Fake clock control                                                      */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void UT_SetMonoNs(uint64_t Ns)
+{
+    UT_MonoNs = Ns;
+}
+
+uint64_t UT_GetMonoNs(void)
+{
+    return UT_MonoNs;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                         */
+/* FSWV1_Time_xxx on the fake clock                                        */
+/*                                                                         */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 FSWV1_Time_MonoNs(void)
+{
+    return UT_MonoNs;
+}
+
+CFE_TIME_SysTime_t FSWV1_Time_MonoToTime(uint64 MonoNs)
+{
+    CFE_TIME_SysTime_t time;
+
+    time.Seconds = (uint32)(MonoNs / 1000000000ULL);
+    time.Subseconds = (uint32)(((MonoNs % 1000000000ULL) << 32) / 1000000000ULL);
+
+    return time;
+}
+
+CFE_TIME_SysTime_t FSWV1_Time_GetTime(void)
+{
+    return FSWV1_Time_MonoToTime(UT_MonoNs);
+}
+
+void FSWV1_Time_SleepNs(uint64 Ns)
+{
+    UT_MonoNs += Ns;
+}
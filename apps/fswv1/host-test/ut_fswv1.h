@@ -0,0 +1,44 @@
+/******************************************************************************
+** File: ut_fswv1.h
+**
+** Purpose:
+**   This file contains the helpers shared by the FSWV1 unit tests: result
+**   checks, the fake monotonic clock behind FSWV1_Time_xxx and the event
+**   recorder behind CFE_EVS_SendEvent.
+**
+** Notes:
+**   Only standard types are used here so the tests of the cFE-free
+**   modules (fswv1_imu_parse.c, fswv1_bmp3_fifo.c) can include it too.
+**
+******************************************************************************/
+
+#ifndef UT_FSWV1_H
+#define UT_FSWV1_H
+
+#include <stdint.h>
+
+/*
+** Record one check; a failed check is printed and makes UT_Report fail
+*/
+void UT_Check(int Ok, const char *What);
+
+/*
+** Print the summary; returns the process exit status (0 = all passed)
+*/
+int UT_Report(const char *Name);
+
+/*
+** Fake clock: FSWV1_Time_MonoNs returns the set time, FSWV1_Time_SleepNs
+** advances it, and FSWV1_Time_GetTime/MonoToTime map it 1:1 onto CFE time
+*/
+void     UT_SetMonoNs(uint64_t Ns);
+uint64_t UT_GetMonoNs(void);
+
+/*
+** Events sent through CFE_EVS_SendEvent since the last UT_ResetEvents
+*/
+void     UT_ResetEvents(void);
+uint32_t UT_EventCount(uint16_t EventID);
+uint32_t UT_EventTotal(void);
+
+#endif /* UT_FSWV1_H */
@@ -0,0 +1,284 @@
+/*
+ * IMU Frame Parser Check and Benchmark
+ *
+ * Checks FSWV1_IMU_ParseFrame() against the sscanf() format it replaced
+ * and against strtof(), then compares their throughput.
+ *
+ * Compile: gcc -O2 -Ifsw/inc -o imu_parse_bench imu_parse_bench.c fsw/src/fswv1_imu_parse.c
+ * Run:     ./imu_parse_bench [frames]
+ *
+ * Exit status is non-zero if any result differs from sscanf/strtof or the
+ * parser is less than 5x faster than sscanf.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <locale.h>
+#include <time.h>
+#include "fswv1_imu_parse.h"
+
+#define SSCANF_FORMAT   "$,%f,%f,%f,%f,%f,%f,%f,#"
+#define FRAME_SIZE      256
+#define RANDOM_FRAMES   200000
+#define BENCH_FRAMES    1000000
+#define BENCH_SET       1024
+#define TARGET_SPEEDUP  5.0
+
+static int failures = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static int same_bits(float a, float b) {
+    uint32_t ua, ub;
+    memcpy(&ua, &a, sizeof(ua));
+    memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+/*
+ * Compare one frame: same accept/reject decision as sscanf, bit-identical
+ * values, and on rejection the failing field must be the one sscanf
+ * stopped at (or the one before it, when a converted number was followed
+ * by something other than ',').
+ */
+static void check_frame(const char *frame) {
+    float ref[FSWV1_IMU_PARSE_FIELDS];
+    float val[FSWV1_IMU_PARSE_FIELDS];
+    int ref_count;
+    int status;
+    int bad_field = -1;
+    int i;
+
+    ref_count = sscanf(frame, SSCANF_FORMAT, &ref[0], &ref[1], &ref[2], &ref[3],
+                       &ref[4], &ref[5], &ref[6]);
+    if (ref_count < 0) {
+        ref_count = 0;
+    }
+    status = FSWV1_IMU_ParseFrame(frame, val, &bad_field);
+
+    if ((ref_count == FSWV1_IMU_PARSE_FIELDS) != (status == FSWV1_IMU_PARSE_OK)) {
+        printf("MISMATCH accept: \"%s\" sscanf=%d parser=%d\n", frame, ref_count, status);
+        failures++;
+        return;
+    }
+
+    if (status == FSWV1_IMU_PARSE_BAD_FIELD &&
+        bad_field != ref_count && bad_field != ref_count - 1) {
+        printf("MISMATCH field: \"%s\" sscanf stopped at %d, parser reports %d\n",
+               frame, ref_count, bad_field);
+        failures++;
+    }
+
+    for (i = 0; i < ref_count && i < FSWV1_IMU_PARSE_FIELDS; i++) {
+        if (!same_bits(ref[i], val[i])) {
+            printf("MISMATCH value: \"%s\" field %d sscanf=%.9g parser=%.9g\n",
+                   frame, i, ref[i], val[i]);
+            failures++;
+        }
+    }
+}
+
+/* One number in one of the formats a sensor or a test script might send */
+static void random_number(char *out, size_t size) {
+    float f;
+    uint32_t bits;
+    int prec = (int)(rng() % 8);
+
+    switch (rng() % 8) {
+    case 0:  /* Typical sensor output */
+        snprintf(out, size, "%.*f", prec, ((int32_t)rng() % 200000) / 1000.0);
+        break;
+    case 1:  /* Random float, shortest round-trip form */
+        do {
+            bits = rng();
+            memcpy(&f, &bits, sizeof(f));
+        } while (f != f);
+        snprintf(out, size, "%.9g", f);
+        break;
+    case 2:  /* Exponent form */
+        snprintf(out, size, "%.*e", prec, ((int32_t)rng()) / 1000.0);
+        break;
+    case 3:  /* Long decimal (slow path) */
+        snprintf(out, size, "%.17f", ((int32_t)rng()) / 65536.0);
+        break;
+    case 4:  /* Leading white space and sign */
+        snprintf(out, size, "%s%s%u.%u", (rng() & 1) ? " " : "\t",
+                 (rng() & 1) ? "+" : "-", rng() % 1000, rng() % 1000);
+        break;
+    case 5:  /* Integer */
+        snprintf(out, size, "%d", (int32_t)rng() >> (rng() % 31));
+        break;
+    case 6:  /* Halfway-ish values near float precision */
+        snprintf(out, size, "%u.%06u", rng() % 20000000, rng() % 1000000);
+        break;
+    default: /* Trailing zeros */
+        snprintf(out, size, "%u.%u000000", rng() % 100000, rng() % 100);
+        break;
+    }
+}
+
+static void build_frame(char *frame, size_t size, int random) {
+    char num[64];
+    size_t len;
+    int i;
+
+    len = (size_t)snprintf(frame, size, "$");
+    for (i = 0; i < FSWV1_IMU_PARSE_FIELDS; i++) {
+        if (random) {
+            random_number(num, sizeof(num));
+        } else {
+            /* What the IMU actually sends: 2-3 decimals, small range */
+            snprintf(num, sizeof(num), "%.*f", (i == 6) ? 2 : 3,
+                     ((int32_t)(rng() % 40000) - 20000) / 1000.0);
+        }
+        len += (size_t)snprintf(frame + len, size - len, ",%s", num);
+    }
+    snprintf(frame + len, size - len, ",#");
+}
+
+static const char *edge_frames[] = {
+    "$,0,0,0,0,0,0,0,#",
+    "$,-0,-0.0,+0,0.000,0e10,-0e-99,.0,#",
+    "$,1,2,3,4,5,6,7,#",
+    "$,0.1,0.2,0.3,1e-10,1e10,3.4028235e38,1.17549435e-38,#",
+    "$,16777216,16777217,16777218,33554431,1e11,1e-11,1.4e-45,#",
+    "$,9.81,-9.81,0.001,-0.001,123.456,-123.456,25.50,#",
+    "$,1e39,-1e39,1e-50,7e-46,inf,-infinity,nan,#",
+    "$,0x1p3,0X1.8p1,1E5,1e+5,1e,1e+,5,#",
+    "$,1.5,2.5,3.5,.5,5.,0.,00001.25000,#",
+    "$,3.14159265358979323846,2.71828182845904523536,1.000000059604644775390625,1.0000000596046447753906251,0.30000001192092895507812,123456789012345678901234,0.000000000000000000001,#",
+    "$, 1,\t2,\n3, +4, -5,  6,   7,#",
+    "$,1,2,3,4,5,6,7",
+    "$,1,2,3,4,5,6,7#",
+    "$,1,2,3,4,5,6,7,",
+    "$,1,2,3,4,5,6,7xyz",
+    "$,1,2,3,,5,6,7,#",
+    "$,1,2,3,4,5,6,#",
+    "$,a,2,3,4,5,6,7,#",
+    "$,1,2,3,4,5,6,x,#",
+    "$,1.2.3,4,5,6,7,8,9,#",
+    "$,1e,2e+,3E-,4,5,6,7,#",
+    "$,1e-x,2,3,4,5,6,7,#",
+    "$,0x,2,3,4,5,6,7,#",
+    "$,1 ,2,3,4,5,6,7,#",
+    "$,-,2,3,4,5,6,7,#",
+    "$,.,2,3,4,5,6,7,#",
+    "$1,2,3,4,5,6,7,#",
+    "#,1,2,3,4,5,6,7,#",
+    "$",
+    "",
+    NULL
+};
+
+static double bench_sscanf(char frames[][FRAME_SIZE], int count) {
+    float v[FSWV1_IMU_PARSE_FIELDS];
+    volatile float sink = 0.0f;
+    uint64_t start;
+    int i;
+
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        if (sscanf(frames[i % BENCH_SET], SSCANF_FORMAT,
+                   &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6]) == 7) {
+            sink += v[0];
+        }
+    }
+    return (double)(now_ns() - start) / count;
+}
+
+static double bench_parser(char frames[][FRAME_SIZE], int count) {
+    float v[FSWV1_IMU_PARSE_FIELDS];
+    volatile float sink = 0.0f;
+    uint64_t start;
+    int bad_field;
+    int i;
+
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        if (FSWV1_IMU_ParseFrame(frames[i % BENCH_SET], v, &bad_field) == FSWV1_IMU_PARSE_OK) {
+            sink += v[0];
+        }
+    }
+    return (double)(now_ns() - start) / count;
+}
+
+int main(int argc, char *argv[]) {
+    static char frames[BENCH_SET][FRAME_SIZE];
+    char frame[FRAME_SIZE * 2];
+    int bench_count = (argc > 1) ? atoi(argv[1]) : BENCH_FRAMES;
+    double sscanf_ns, parser_ns, speedup;
+    float v[FSWV1_IMU_PARSE_FIELDS];
+    int bad_field;
+    int i;
+
+    printf("===========================================\n");
+    printf("IMU Frame Parser Check and Benchmark\n");
+    printf("===========================================\n");
+
+    /* Correctness */
+    for (i = 0; edge_frames[i] != NULL; i++) {
+        check_frame(edge_frames[i]);
+    }
+    printf("Edge cases:     %d frames checked\n", i);
+
+    for (i = 0; i < RANDOM_FRAMES; i++) {
+        build_frame(frame, sizeof(frame), 1);
+        check_frame(frame);
+    }
+    printf("Random frames:  %d frames checked\n", RANDOM_FRAMES);
+
+    /* The parser must not follow the process locale */
+    if (setlocale(LC_NUMERIC, "de_DE.UTF-8") != NULL ||
+        setlocale(LC_NUMERIC, "fr_FR.UTF-8") != NULL) {
+        if (FSWV1_IMU_ParseFrame("$,1.5,2.5,3.5,4.5,5.5,6.5,1234567890.12345678,#", v, &bad_field)
+                != FSWV1_IMU_PARSE_OK || v[0] != 1.5f || v[6] != 1234567890.12345678f) {
+            printf("MISMATCH: parser depends on LC_NUMERIC\n");
+            failures++;
+        }
+        printf("Locale:         checked under %s\n", setlocale(LC_NUMERIC, NULL));
+        setlocale(LC_NUMERIC, "C");
+    } else {
+        printf("Locale:         no comma-decimal locale installed, skipped\n");
+    }
+
+    printf("Mismatches:     %d\n\n", failures);
+
+    /* Throughput on frames shaped like real IMU output */
+    for (i = 0; i < BENCH_SET; i++) {
+        build_frame(frames[i], FRAME_SIZE, 0);
+    }
+    printf("Example frame:  %s\n", frames[0]);
+
+    bench_sscanf(frames, BENCH_SET);
+    bench_parser(frames, BENCH_SET);
+    sscanf_ns = bench_sscanf(frames, bench_count);
+    parser_ns = bench_parser(frames, bench_count);
+    speedup = sscanf_ns / parser_ns;
+
+    printf("sscanf:         %8.1f ns/frame (%.0f frames/s)\n", sscanf_ns, 1e9 / sscanf_ns);
+    printf("parser:         %8.1f ns/frame (%.0f frames/s)\n", parser_ns, 1e9 / parser_ns);
+    printf("Speedup:        %8.1fx (target %.0fx)\n", speedup, TARGET_SPEEDUP);
+
+    if (failures > 0 || speedup < TARGET_SPEEDUP) {
+        printf("\nFAIL\n");
+        return 1;
+    }
+
+    printf("\nPASS\n");
+    return 0;
+}
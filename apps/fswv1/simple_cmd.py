@@ -9,6 +9,11 @@ Usage:
     python3 simple_cmd.py led-on
     python3 simple_cmd.py led-off
     python3 simple_cmd.py blink
+    python3 simple_cmd.py set-rate <bmp|imu|tlm|hk> <hz>
+    python3 simple_cmd.py set-cmd-budget <msgs> <us>
+    python3 simple_cmd.py rt-profile <0|1>
+    python3 simple_cmd.py time-tag <seconds> <microseconds> <command>
+    python3 simple_cmd.py imu-format <ascii|binary|auto>
 """
 
 import socket
@@ -32,9 +37,32 @@ CMD_CODES = {
     'led-off': 5,
     'toggle': 6,
     'status': 7,
+    'set-rate': 8,
+    'reset-perf': 9,
+    'set-cmd-budget': 10,
+    'rt-profile': 11,
+    'rt-jitter': 12,
+    'time-tag': 13,
+    'ttq-clear': 14,
+    'imu-format': 15,
 }
 
-def send_command(cmd_code, verbose=True):
+# IMU wire formats for imu-format (must match fswv1_app_msg.h)
+IMU_FORMATS = {
+    'ascii': 0,
+    'binary': 1,
+    'auto': 2,
+}
+
+# Rate groups for set-rate (must match fswv1_app_msg.h)
+RATE_GROUPS = {
+    'bmp': 0,
+    'imu': 1,
+    'tlm': 2,
+    'hk': 3,
+}
+
+def send_command(cmd_code, payload=b'', verbose=True):
     """
     Send a simple command packet to cFS.
     
@@ -44,12 +72,13 @@ def send_command(cmd_code, verbose=True):
     - Length (2 bytes): Packet data length - 1
     - Command Code (1 byte): Function code
     - Checksum (1 byte): Command checksum (can be 0)
+    - Payload (optional): command arguments in target byte order
     """
     
     # Build CCSDS primary header
     stream_id = 0x1800 | (BMP280_CMD_MID & 0x7FF)  # Command packet
     sequence = 0xC000  # Standalone packet, sequence 0
-    length = 1  # 2 bytes of data - 1 (cmd code + checksum only)
+    length = 1 + len(payload)  # data bytes - 1 (cmd code + checksum + payload)
     
     # Build secondary header
     function_code = cmd_code
@@ -59,7 +88,7 @@ def send_command(cmd_code, verbose=True):
     header = struct.pack('>HHH', stream_id, sequence, length)
     cmd_data = struct.pack('>BB', function_code, checksum)
     
-    message = header + cmd_data
+    message = header + cmd_data + payload
     
     if verbose:
         print(f"Sending command code {cmd_code} to {CFS_IP}:{CFS_CMD_PORT}")
@@ -81,6 +110,11 @@ def main():
         print("\nSpecial commands:")
         print("  blink    - Blink LED 5 times")
         print("  test     - Test all LED commands")
+        print("  set-rate <bmp|imu|tlm|hk> <hz> - Change a rate group (0 = off)")
+        print("  set-cmd-budget <msgs> <us>     - Commands drained per wakeup (0 = no limit, not both)")
+        print("  rt-profile <0|1>               - 0 = OSAL default, 1 = real-time profile")
+        print("  time-tag <s> <us> <command>    - Run a command without arguments at CFE time s.us")
+        print("  imu-format <ascii|binary|auto> - IMU UART wire format")
         sys.exit(1)
     
     cmd = sys.argv[1].lower()
@@ -104,6 +138,49 @@ def main():
             time.sleep(1)
         print("\nTest complete!")
     
+    elif cmd == 'set-rate':
+        if len(sys.argv) != 4 or sys.argv[2] not in RATE_GROUPS:
+            print("Usage: python3 simple_cmd.py set-rate <bmp|imu|tlm|hk> <hz>")
+            sys.exit(1)
+        # uint8 RateGroup, uint8 Spare[3], uint32 RateHz (little-endian target)
+        payload = struct.pack('<B3xI', RATE_GROUPS[sys.argv[2]], int(sys.argv[3]))
+        send_command(CMD_CODES['set-rate'], payload)
+    
+    elif cmd == 'set-cmd-budget':
+        if len(sys.argv) != 4:
+            print("Usage: python3 simple_cmd.py set-cmd-budget <msgs> <us>")
+            sys.exit(1)
+        # uint16 MaxMsgs, uint16 Spare, uint32 MaxUs (little-endian target)
+        payload = struct.pack('<H2xI', int(sys.argv[2]), int(sys.argv[3]))
+        send_command(CMD_CODES['set-cmd-budget'], payload)
+    
+    elif cmd == 'rt-profile':
+        if len(sys.argv) != 3:
+            print("Usage: python3 simple_cmd.py rt-profile <0|1>")
+            sys.exit(1)
+        # uint8 Profile, uint8 Spare[3]
+        payload = struct.pack('<B3x', int(sys.argv[2]))
+        send_command(CMD_CODES['rt-profile'], payload)
+    
+    elif cmd == 'time-tag':
+        if len(sys.argv) != 5 or sys.argv[4] not in CMD_CODES:
+            print("Usage: python3 simple_cmd.py time-tag <seconds> <microseconds> <command>")
+            sys.exit(1)
+        seconds = int(sys.argv[2])
+        subseconds = (int(sys.argv[3]) << 32) // 1000000
+        # uint32 ExecSeconds, uint32 ExecSubseconds, uint8 CommandCode,
+        # uint8 Spare, uint16 ArgLength, uint8 Args[16]
+        payload = struct.pack('<IIBxH16x', seconds, subseconds, CMD_CODES[sys.argv[4]], 0)
+        send_command(CMD_CODES['time-tag'], payload)
+    
+    elif cmd == 'imu-format':
+        if len(sys.argv) != 3 or sys.argv[2] not in IMU_FORMATS:
+            print("Usage: python3 simple_cmd.py imu-format <ascii|binary|auto>")
+            sys.exit(1)
+        # uint8 Format, uint8 Spare[3]
+        payload = struct.pack('<B3x', IMU_FORMATS[sys.argv[2]])
+        send_command(CMD_CODES['imu-format'], payload)
+    
     elif cmd in CMD_CODES:
         send_command(CMD_CODES[cmd])
     
@@ -1,142 +1,552 @@
 /*
- * Simple UART Test Program
- * Compile: gcc -o uart_test uart_test.c
- * Run: ./uart_test
+ * IMU UART Link Test
+ *
+ * Frames the IMU stream with the flight parser (ASCII and COBS/CRC-16
+ * binary, as fswv1_uart.c does) and reports, for every window and for the
+ * whole run: frames/s, bytes/s, parse error rate, sender sequence losses,
+ * the inter-frame arrival interval with its histogram, and the longest
+ * gap. Use it to qualify an IMU link or a new baud rate before deploying.
+ *
+ * Compile: gcc -O2 -Ifsw/inc -o uart_test uart_test.c fsw/src/fswv1_serial.c fsw/src/fswv1_imu_parse.c -lm
+ * Run:     ./uart_test [options] [device] [baud]
+ *
+ * Options:
+ *   -w SEC   Report window in seconds (default 1)
+ *   -t SEC   Stop after SEC seconds (default: run until Ctrl+C)
+ *   -f FMT   Frame format: auto, ascii or binary (default auto)
+ *   -b US    Histogram bin width in microseconds (default 500)
+ *   -n N     Histogram bins; the last one also holds longer intervals (default 20)
+ *   -j       JSON output, one object per line
+ *   -v       Print every frame
+ *
+ * Arrival times are interpolated within each read() from the byte time on
+ * the wire, the same way the flight code stamps samples.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <fcntl.h>
-#include <termios.h>
 #include <unistd.h>
 #include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include "fswv1_serial.h"
+#include "fswv1_imu_parse.h"
 
-#define UART_DEVICE "/dev/ttyAMA0"
-#define UART_BAUDRATE B115200
+#define UART_DEVICE     "/dev/ttyAMA0"
+#define UART_BAUD       115200
+#define RX_CHUNK_SIZE   4096
+#define ASCII_BUF_SIZE  256
+#define MAX_BINS        64
+#define HIST_BAR        "########################################"
 
-int main() {
-    int uart_fd;
-    struct termios tty;
-    char buffer[256];
-    int buffer_pos = 0;
-    ssize_t bytes_read;
-    char byte;
-    int packet_count = 0;
-    
-    printf("===========================================\n");
-    printf("UART Test Program\n");
+enum { FMT_AUTO, FMT_ASCII, FMT_BINARY };
+static const char *format_names[] = { "auto", "ascii", "binary" };
+
+typedef struct {
+    uint64_t frames;
+    uint64_t bytes;
+    uint64_t reads;
+    uint64_t parse_errors;    /* ASCII frame did not parse */
+    uint64_t crc_errors;      /* Binary frame CRC mismatch */
+    uint64_t resyncs;         /* Binary frame not valid COBS or wrong length */
+    uint64_t overflows;       /* ASCII frame longer than the buffer */
+    uint64_t truncated;       /* ASCII frame cut short */
+    uint64_t seq_gaps;
+    uint64_t seq_lost;
+    uint64_t seq_resets;
+    uint64_t intervals;
+    double   interval_sum;
+    double   interval_sq;
+    uint64_t interval_min;
+    uint64_t interval_max;
+    uint64_t longest_gap;     /* Longest time without a frame, including silence */
+    uint64_t hist[MAX_BINS];
+} link_stats_t;
+
+/* Options */
+static double window_s = 1.0;
+static double duration_s = 0.0;
+static int format = FMT_AUTO;
+static uint64_t bin_ns = 500000;
+static int bins = 20;
+static int json = 0;
+static int verbose = 0;
+
+/* Framer and tracking state */
+static int active = FMT_AUTO;             /* Format locked onto (AUTO = hunting) */
+static char ascii_buf[ASCII_BUF_SIZE];
+static int ascii_pos = 0;
+static int ascii_discard = 0;
+static uint8_t bin_buf[FSWV1_IMU_BIN_MAX_ENCODED];
+static size_t bin_pos = 0;
+static int bin_discard = 0;
+static int seq_valid = 0;
+static uint32_t seq_expected = 0;
+static uint64_t last_frame_ns = 0;
+
+static link_stats_t win;
+static link_stats_t total;
+static volatile sig_atomic_t stop = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void stats_reset(link_stats_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->interval_min = UINT64_MAX;
+}
+
+/* Apply one update to the window and the run totals */
+#define COUNT(field, n) do { win.field += (n); total.field += (n); } while (0)
+
+static void record_gap(link_stats_t *s, uint64_t gap) {
+    if (gap > s->longest_gap) {
+        s->longest_gap = gap;
+    }
+}
+
+static void record_interval(link_stats_t *s, uint64_t interval) {
+    uint64_t bin = interval / bin_ns;
+
+    s->intervals++;
+    s->interval_sum += (double)interval;
+    s->interval_sq += (double)interval * (double)interval;
+    if (interval < s->interval_min) {
+        s->interval_min = interval;
+    }
+    if (interval > s->interval_max) {
+        s->interval_max = interval;
+    }
+    record_gap(s, interval);
+    s->hist[bin < (uint64_t)bins ? bin : (uint64_t)bins - 1]++;
+}
+
+/* While hunting for the format, the other framer's failures are expected */
+static void frame_failed(uint64_t *w, uint64_t *t) {
+    if (active != FMT_AUTO) {
+        (*w)++;
+        (*t)++;
+    }
+}
+
+static void frame_good(int fmt, uint32_t seq, uint32_t seq_mask, uint64_t arrival,
+                       const float v[FSWV1_IMU_PARSE_FIELDS]) {
+    uint32_t diff;
+
+    if (active != fmt) {
+        /* New format: restart sequence and interval tracking */
+        active = fmt;
+        seq_valid = 0;
+        last_frame_ns = 0;
+    }
+
+    COUNT(frames, 1);
+
+    if (seq_mask == 0) {
+        seq_valid = 0;
+    } else {
+        if (seq_valid) {
+            diff = (seq - seq_expected) & seq_mask;
+            if (diff != 0 && diff <= seq_mask / 2) {
+                COUNT(seq_gaps, 1);
+                COUNT(seq_lost, diff);
+            } else if (diff != 0) {
+                COUNT(seq_resets, 1);
+            }
+        }
+        seq_expected = (seq + 1) & seq_mask;
+        seq_valid = 1;
+    }
+
+    if (last_frame_ns != 0 && arrival >= last_frame_ns) {
+        record_interval(&win, arrival - last_frame_ns);
+        record_interval(&total, arrival - last_frame_ns);
+    }
+    last_frame_ns = arrival;
+
+    if (verbose && !json) {
+        printf("%s frame: A=%.3f,%.3f,%.3f G=%.3f,%.3f,%.3f T=%.2f",
+               format_names[fmt], v[0], v[1], v[2], v[3], v[4], v[5], v[6]);
+        if (seq_mask != 0) {
+            printf(" seq=%u", seq);
+        }
+        printf("\n");
+    }
+}
+
+/* ASCII framer: "$,...,#", same rules as the flight code */
+static void ascii_byte(char byte, uint64_t arrival) {
+    float v[FSWV1_IMU_PARSE_FIELDS];
+    uint32_t seq = 0;
+    int has_seq = 0;
+    int bad_field = 0;
+
+    if (byte == '$') {
+        if (ascii_pos > 0) {
+            frame_failed(&win.truncated, &total.truncated);
+        }
+        ascii_discard = 0;
+        ascii_pos = 0;
+        ascii_buf[ascii_pos++] = byte;
+    } else if (byte == '#') {
+        if (ascii_pos > 0 && ascii_pos < ASCII_BUF_SIZE - 1) {
+            ascii_buf[ascii_pos++] = byte;
+            ascii_buf[ascii_pos] = '\0';
+            ascii_pos = 0;
+            if (FSWV1_IMU_ParseFrameSeq(ascii_buf, v, &bad_field, &seq, &has_seq) == FSWV1_IMU_PARSE_OK) {
+                frame_good(FMT_ASCII, seq, has_seq ? 0xFFFFFFFFu : 0, arrival, v);
+            } else {
+                frame_failed(&win.parse_errors, &total.parse_errors);
+            }
+        } else if (ascii_discard) {
+            ascii_discard = 0;
+        } else {
+            frame_failed(&win.truncated, &total.truncated);
+        }
+    } else if (ascii_pos > 0 && ascii_pos < ASCII_BUF_SIZE - 1) {
+        ascii_buf[ascii_pos++] = byte;
+    } else if (ascii_pos >= ASCII_BUF_SIZE - 1) {
+        ascii_pos = 0;
+        ascii_discard = 1;
+        frame_failed(&win.overflows, &total.overflows);
+    }
+}
+
+/* Binary framer: COBS frames ending in 0x00 */
+static void binary_byte(uint8_t byte, uint64_t arrival) {
+    float v[FSWV1_IMU_PARSE_FIELDS];
+    uint8_t seq;
+    int status;
+
+    if (byte != 0) {
+        if (bin_pos < sizeof(bin_buf)) {
+            bin_buf[bin_pos++] = byte;
+        } else if (!bin_discard) {
+            bin_discard = 1;
+            frame_failed(&win.resyncs, &total.resyncs);
+        }
+        return;
+    }
+
+    if (bin_discard || bin_pos == 0) {
+        bin_discard = 0;
+        bin_pos = 0;
+        return;
+    }
+
+    status = FSWV1_IMU_ParseBinary(bin_buf, bin_pos, v, &seq);
+    bin_pos = 0;
+
+    if (status == FSWV1_IMU_PARSE_OK) {
+        frame_good(FMT_BINARY, seq, 0xFF, arrival, v);
+    } else if (status == FSWV1_IMU_PARSE_BAD_CRC) {
+        frame_failed(&win.crc_errors, &total.crc_errors);
+    } else {
+        frame_failed(&win.resyncs, &total.resyncs);
+    }
+}
+
+static uint64_t error_count(const link_stats_t *s) {
+    return s->parse_errors + s->crc_errors + s->resyncs + s->overflows + s->truncated;
+}
+
+static double interval_stddev(const link_stats_t *s) {
+    double mean, var;
+
+    if (s->intervals < 2) {
+        return 0.0;
+    }
+    mean = s->interval_sum / s->intervals;
+    var = s->interval_sq / s->intervals - mean * mean;
+    return (var > 0.0) ? sqrt(var) : 0.0;
+}
+
+static void print_json(const char *type, const link_stats_t *s, double elapsed_s,
+                       double t_s, uint32_t baud) {
+    uint64_t errors = error_count(s);
+    int i;
+
+    printf("{\"type\":\"%s\",\"t\":%.3f,\"seconds\":%.3f,\"format\":\"%s\"",
+           type, t_s, elapsed_s, format_names[active]);
+    printf(",\"frames\":%llu,\"fps\":%.2f,\"bytes\":%llu,\"bps\":%.1f,\"link_util\":%.4f,\"reads\":%llu",
+           (unsigned long long)s->frames, s->frames / elapsed_s,
+           (unsigned long long)s->bytes, s->bytes / elapsed_s,
+           (s->bytes / elapsed_s) / (baud / 10.0), (unsigned long long)s->reads);
+    printf(",\"errors\":{\"parse\":%llu,\"crc\":%llu,\"resync\":%llu,\"overflow\":%llu,\"truncated\":%llu}",
+           (unsigned long long)s->parse_errors, (unsigned long long)s->crc_errors,
+           (unsigned long long)s->resyncs, (unsigned long long)s->overflows,
+           (unsigned long long)s->truncated);
+    printf(",\"error_rate\":%.6f", (s->frames + errors) ? (double)errors / (s->frames + errors) : 0.0);
+    printf(",\"seq\":{\"gaps\":%llu,\"lost\":%llu,\"resets\":%llu}",
+           (unsigned long long)s->seq_gaps, (unsigned long long)s->seq_lost,
+           (unsigned long long)s->seq_resets);
+    printf(",\"interval_us\":{\"count\":%llu,\"mean\":%.1f,\"stddev\":%.1f,\"min\":%.1f,\"max\":%.1f}",
+           (unsigned long long)s->intervals,
+           s->intervals ? s->interval_sum / s->intervals / 1000.0 : 0.0,
+           interval_stddev(s) / 1000.0,
+           s->intervals ? s->interval_min / 1000.0 : 0.0,
+           s->interval_max / 1000.0);
+    printf(",\"longest_gap_us\":%.1f", s->longest_gap / 1000.0);
+    printf(",\"hist\":{\"bin_us\":%.1f,\"counts\":[", bin_ns / 1000.0);
+    for (i = 0; i < bins; i++) {
+        printf("%s%llu", i ? "," : "", (unsigned long long)s->hist[i]);
+    }
+    printf("]}}\n");
+    fflush(stdout);
+}
+
+static void print_window(const link_stats_t *s, double elapsed_s, double t_s, uint32_t baud) {
+    uint64_t errors = error_count(s);
+
+    printf("[%7.1fs] %8.1f frames/s %9.0f B/s (%3.0f%%)  err %llu (%.2f%%)  lost %llu  ",
+           t_s, s->frames / elapsed_s, s->bytes / elapsed_s,
+           100.0 * (s->bytes / elapsed_s) / (baud / 10.0),
+           (unsigned long long)errors,
+           (s->frames + errors) ? 100.0 * errors / (s->frames + errors) : 0.0,
+           (unsigned long long)s->seq_lost);
+    if (s->intervals > 0) {
+        printf("interval %.1f +/- %.1f us [%.1f, %.1f]  ",
+               s->interval_sum / s->intervals / 1000.0, interval_stddev(s) / 1000.0,
+               s->interval_min / 1000.0, s->interval_max / 1000.0);
+    }
+    printf("gap %.1f us\n", s->longest_gap / 1000.0);
+    fflush(stdout);
+}
+
+static void print_summary(const link_stats_t *s, double elapsed_s, uint32_t baud) {
+    uint64_t errors = error_count(s);
+    uint64_t peak = 0;
+    int i;
+
+    printf("\n===========================================\n");
+    printf("Summary (%.1f s, format %s)\n", elapsed_s, format_names[active]);
     printf("===========================================\n");
-    printf("Opening %s at 115200 baud...\n", UART_DEVICE);
-    
-    // Open UART
-    uart_fd = open(UART_DEVICE, O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (uart_fd < 0) {
-        printf("ERROR: Cannot open %s: %s\n", UART_DEVICE, strerror(errno));
-        printf("\nTry:\n");
-        printf("  sudo usermod -a -G dialout $USER\n");
-        printf("  (then log out and back in)\n");
-        return 1;
+    printf("Frames:         %llu (%.1f frames/s)\n", (unsigned long long)s->frames, s->frames / elapsed_s);
+    printf("Bytes:          %llu (%.0f B/s, %.1f%% of %u baud)\n", (unsigned long long)s->bytes,
+           s->bytes / elapsed_s, 100.0 * (s->bytes / elapsed_s) / (baud / 10.0), baud);
+    printf("Reads:          %llu (%.1f bytes/read)\n", (unsigned long long)s->reads,
+           s->reads ? (double)s->bytes / s->reads : 0.0);
+    printf("Errors:         %llu (%.3f%%): parse %llu, crc %llu, resync %llu, overflow %llu, truncated %llu\n",
+           (unsigned long long)errors,
+           (s->frames + errors) ? 100.0 * errors / (s->frames + errors) : 0.0,
+           (unsigned long long)s->parse_errors, (unsigned long long)s->crc_errors,
+           (unsigned long long)s->resyncs, (unsigned long long)s->overflows,
+           (unsigned long long)s->truncated);
+    printf("Sequence:       %llu gaps, %llu frames lost, %llu resets\n",
+           (unsigned long long)s->seq_gaps, (unsigned long long)s->seq_lost,
+           (unsigned long long)s->seq_resets);
+    if (s->intervals > 0) {
+        printf("Interval:       mean %.1f us, stddev %.1f us, min %.1f us, max %.1f us\n",
+               s->interval_sum / s->intervals / 1000.0, interval_stddev(s) / 1000.0,
+               s->interval_min / 1000.0, s->interval_max / 1000.0);
+    }
+    printf("Longest gap:    %.1f us\n", s->longest_gap / 1000.0);
+
+    if (s->intervals == 0) {
+        return;
     }
-    
-    printf("✓ UART opened successfully!\n\n");
-    
-    // Get current settings
-    if (tcgetattr(uart_fd, &tty) != 0) {
-        printf("ERROR: Cannot get UART attributes\n");
-        close(uart_fd);
+
+    printf("\nInter-frame arrival histogram (%.1f us bins)\n", bin_ns / 1000.0);
+    for (i = 0; i < bins; i++) {
+        if (s->hist[i] > peak) {
+            peak = s->hist[i];
+        }
+    }
+    for (i = 0; i < bins; i++) {
+        if (s->hist[i] == 0) {
+            continue;
+        }
+        if (i == bins - 1) {
+            printf("  %8.1f +          us %10llu  ", i * bin_ns / 1000.0, (unsigned long long)s->hist[i]);
+        } else {
+            printf("  %8.1f - %-8.1f us %10llu  ", i * bin_ns / 1000.0, (i + 1) * bin_ns / 1000.0,
+                   (unsigned long long)s->hist[i]);
+        }
+        // At least one mark for any non-empty bin
+        printf("%.*s\n", (int)((40 * s->hist[i] + peak - 1) / peak), HIST_BAR);
+    }
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-w sec] [-t sec] [-f auto|ascii|binary] [-b bin_us] [-n bins] [-j] [-v] "
+           "[device] [baud]\n", prog);
+}
+
+int main(int argc, char *argv[]) {
+    const char *device = UART_DEVICE;
+    FSWV1_SerialConfig_t config;
+    FSWV1_SerialInfo_t info;
+    struct sigaction sa;
+    struct pollfd pfd;
+    static uint8_t chunk[RX_CHUNK_SIZE];
+    uint64_t start, window_start, window_ns, end_ns, now, chunk_ns, byte_ns, arrival, floor_ns = 0;
+    ssize_t len, i;
+    int timeout_ms;
+    int uart_fd;
+    int opt;
+
+    memset(&config, 0, sizeof(config));
+    config.BaudRate = UART_BAUD;
+    config.LowLatency = 1;
+
+    while ((opt = getopt(argc, argv, "w:t:f:b:n:jvh")) != -1) {
+        switch (opt) {
+        case 'w': window_s = atof(optarg); break;
+        case 't': duration_s = atof(optarg); break;
+        case 'b': bin_ns = (uint64_t)(atof(optarg) * 1000.0); break;
+        case 'n': bins = atoi(optarg); break;
+        case 'j': json = 1; break;
+        case 'v': verbose = 1; break;
+        case 'f':
+            if (strcmp(optarg, "ascii") == 0) {
+                format = FMT_ASCII;
+            } else if (strcmp(optarg, "binary") == 0) {
+                format = FMT_BINARY;
+            } else if (strcmp(optarg, "auto") == 0) {
+                format = FMT_AUTO;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if (optind < argc) {
+        device = argv[optind++];
+    }
+    if (optind < argc) {
+        config.BaudRate = (uint32_t)strtoul(argv[optind], NULL, 10);
+    }
+    if (window_s <= 0.0 || bin_ns == 0 || bins < 1 || bins > MAX_BINS || config.BaudRate == 0) {
+        usage(argv[0]);
         return 1;
     }
-    
-    // Configure UART
-    cfsetospeed(&tty, UART_BAUDRATE);
-    cfsetispeed(&tty, UART_BAUDRATE);
-    
-    tty.c_cflag &= ~PARENB;
-    tty.c_cflag &= ~CSTOPB;
-    tty.c_cflag &= ~CSIZE;
-    tty.c_cflag |= CS8;
-    tty.c_cflag &= ~020000000000;  // CRTSCTS
-    tty.c_cflag |= CREAD | CLOCAL;
-    
-    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-    tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
-    
-    tty.c_oflag &= ~OPOST;
-    
-    tty.c_cc[VMIN] = 0;
-    tty.c_cc[VTIME] = 1;
-    
-    // Apply settings
-    if (tcsetattr(uart_fd, TCSANOW, &tty) != 0) {
-        printf("ERROR: Cannot set UART attributes\n");
-        close(uart_fd);
+    active = format;
+
+    if (!json) {
+        printf("===========================================\n");
+        printf("IMU UART Link Test\n");
+        printf("===========================================\n");
+        printf("Opening %s at %u baud...\n", device, config.BaudRate);
+    }
+
+    // Open and configure UART (8N1, raw, non-blocking)
+    uart_fd = FSWV1_Serial_Open(device, &config, &info);
+    if (uart_fd < 0) {
+        fprintf(stderr, "ERROR: Cannot open %s (%s): %s\n", device, info.FailedStep, strerror(errno));
+        fprintf(stderr, "\nTry:\n");
+        fprintf(stderr, "  sudo usermod -a -G dialout $USER\n");
+        fprintf(stderr, "  (then log out and back in)\n");
         return 1;
     }
-    
-    tcflush(uart_fd, TCIOFLUSH);
-    
-    printf("✓ UART configured at 115200 baud, 8N1\n\n");
-    printf("Waiting for data...\n");
-    printf("Expected format: $,Ax,Ay,Az,Gx,Gy,Gz,T,#\n");
-    printf("Press Ctrl+C to exit\n\n");
-    printf("-------------------------------------------\n");
-    
+
+    if (info.Warnings & FSWV1_SERIAL_WARN_BAUD) {
+        fprintf(stderr, "WARNING: driver set %u baud instead of %u\n", info.ActualBaud, config.BaudRate);
+    }
+    if (info.Warnings & FSWV1_SERIAL_WARN_LOW_LATENCY) {
+        fprintf(stderr, "WARNING: driver does not support low-latency mode\n");
+    }
+
+    if (!json) {
+        printf("✓ UART configured at %u baud, 8N1\n", info.ActualBaud);
+        printf("Format %s, %.1f s windows, Ctrl+C for the summary\n\n", format_names[format], window_s);
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    stats_reset(&win);
+    stats_reset(&total);
+    byte_ns = 10000000000ULL / (info.ActualBaud ? info.ActualBaud : config.BaudRate);
+    window_ns = (uint64_t)(window_s * 1e9);
+    start = now_ns();
+    window_start = start;
+    end_ns = (duration_s > 0.0) ? start + (uint64_t)(duration_s * 1e9) : 0;
+    pfd.fd = uart_fd;
+    pfd.events = POLLIN;
+
     // Read loop
-    while (1) {
-        bytes_read = read(uart_fd, &byte, 1);
-        
-        if (bytes_read > 0) {
-            // Print raw byte for debugging
-            if (byte >= 32 && byte <= 126) {
-                printf("%c", byte);
+    while (!stop) {
+        now = now_ns();
+
+        if (now >= window_start + window_ns) {
+            // Silence since the last frame counts towards the longest gap
+            if (last_frame_ns != 0) {
+                record_gap(&win, now - last_frame_ns);
+                record_gap(&total, now - last_frame_ns);
+            }
+            if (json) {
+                print_json("window", &win, (now - window_start) / 1e9, (now - start) / 1e9, info.ActualBaud);
             } else {
-                printf("[0x%02X]", (unsigned char)byte);
+                print_window(&win, (now - window_start) / 1e9, (now - start) / 1e9, info.ActualBaud);
             }
-            fflush(stdout);
-            
-            // Look for start marker
-            if (byte == '$') {
-                buffer_pos = 0;
-                buffer[buffer_pos++] = byte;
+            stats_reset(&win);
+            window_start = now;
+        }
+        if (end_ns != 0 && now >= end_ns) {
+            break;
+        }
+
+        timeout_ms = (int)((window_start + window_ns - now) / 1000000) + 1;
+        if (poll(&pfd, 1, timeout_ms) <= 0) {
+            continue;
+        }
+
+        len = read(uart_fd, chunk, sizeof(chunk));
+        chunk_ns = now_ns();
+        if (len <= 0) {
+            if (len < 0 && errno != EAGAIN && errno != EINTR) {
+                fprintf(stderr, "ERROR: read: %s\n", strerror(errno));
+                break;
             }
-            // Look for end marker
-            else if (byte == '#') {
-                if (buffer_pos > 0 && buffer_pos < 255) {
-                    buffer[buffer_pos++] = byte;
-                    buffer[buffer_pos] = '\0';
-                    
-                    packet_count++;
-                    printf("\n✓ Packet %d received: %s\n", packet_count, buffer);
-                    
-                    // Try to parse
-                    float ax, ay, az, gx, gy, gz, temp;
-                    int parsed = sscanf(buffer, "$,%f,%f,%f,%f,%f,%f,%f,#",
-                                      &ax, &ay, &az, &gx, &gy, &gz, &temp);
-                    
-                    if (parsed == 7) {
-                        printf("  Parsed successfully!\n");
-                        printf("  Accel: X=%.2f Y=%.2f Z=%.2f\n", ax, ay, az);
-                        printf("  Gyro:  X=%.2f Y=%.2f Z=%.2f\n", gx, gy, gz);
-                        printf("  Temp:  %.2f °C\n", temp);
-                    } else {
-                        printf("  ✗ Parse failed (got %d values, expected 7)\n", parsed);
-                    }
-                    printf("-------------------------------------------\n");
-                    
-                    buffer_pos = 0;
-                }
+            continue;
+        }
+        COUNT(reads, 1);
+        COUNT(bytes, (uint64_t)len);
+
+        for (i = 0; i < len; i++) {
+            // Arrival of this byte: the chunk's read time, less the bytes after it
+            arrival = chunk_ns - (uint64_t)(len - 1 - i) * byte_ns;
+            if (arrival < floor_ns) {
+                arrival = floor_ns;
+            }
+            floor_ns = arrival;
+
+            if (active != FMT_BINARY) {
+                ascii_byte((char)chunk[i], arrival);
             }
-            // Accumulate data
-            else if (buffer_pos > 0 && buffer_pos < 255) {
-                buffer[buffer_pos++] = byte;
+            if (active != FMT_ASCII) {
+                binary_byte(chunk[i], arrival);
             }
         }
-        
-        usleep(1000);  // Sleep 1ms
     }
-    
-    close(uart_fd);
+
+    now = now_ns();
+    if (last_frame_ns != 0) {
+        record_gap(&total, now - last_frame_ns);
+    }
+    if (json) {
+        print_json("summary", &total, (now - start) / 1e9, (now - start) / 1e9, info.ActualBaud);
+    } else {
+        print_summary(&total, (now - start) / 1e9, info.ActualBaud);
+    }
+
+    FSWV1_Serial_Close(uart_fd);
     return 0;
 }
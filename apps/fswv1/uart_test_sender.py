@@ -1,10 +1,12 @@
 #!/usr/bin/env python3
 """
 UART IMU Simulator and Tester
-Sends test IMU data to /dev/ttyAMA0 continuously
+Sends test IMU data to /dev/ttyAMA0 continuously, as ASCII frames or as
+COBS/CRC-16 binary frames (--binary int16|float)
 """
 
 import serial
+import struct
 import time
 import random
 import sys
@@ -12,8 +14,53 @@ import sys
 UART_PORT = "/dev/ttyAMA0"
 BAUD_RATE = 115200
 
-def generate_imu_data():
-    """Generate realistic IMU test data."""
+# Binary frame format (must match fswv1_imu_parse.h)
+BIN_SCALES = (1000.0, 1000.0, 1000.0, 100.0, 100.0, 100.0, 100.0)
+
+def crc16_ccitt(data):
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+def cobs_encode(data):
+    """COBS-encode data and append the 0x00 delimiter."""
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_pos] = code
+                code_pos = len(out)
+                out.append(0)
+                code = 1
+    out[code_pos] = code
+    out.append(0)
+    return bytes(out)
+
+def encode_binary_frame(values, seq, int16=True):
+    """Build one binary IMU frame: seq, 7 values, CRC-16, COBS-framed."""
+    if int16:
+        raw = [max(-32768, min(32767, int(round(v * s)))) for v, s in zip(values, BIN_SCALES)]
+        body = struct.pack('<B7h', seq & 0xFF, *raw)
+    else:
+        body = struct.pack('<B7f', seq & 0xFF, *values)
+    return cobs_encode(body + struct.pack('<H', crc16_ccitt(body)))
+
+def generate_imu_values():
+    """Generate realistic IMU test values (Ax, Ay, Az, Gx, Gy, Gz, T)."""
     ax = random.uniform(-0.1, 0.1)
     ay = random.uniform(-0.1, 0.1)
     az = random.uniform(9.7, 9.9)  # ~1g gravity
@@ -22,23 +69,37 @@ def generate_imu_data():
     gz = random.uniform(-0.05, 0.05)
     temp = random.uniform(24.0, 27.0)
     
-    return f"${ax:.2f},{ay:.2f},{az:.2f},{gx:.2f},{gy:.2f},{gz:.2f},{temp:.2f},#\n"
+    return (ax, ay, az, gx, gy, gz, temp)
 
-def send_test_data_serial():
+def generate_imu_data(seq=None):
+    """Generate realistic IMU test data as an ASCII frame, optionally with a frame counter."""
+    fields = [f"{v:.2f}" for v in generate_imu_values()]
+    if seq is not None:
+        fields.append(str(seq))
+    return "$," + ",".join(fields) + ",#\n"
+
+def send_test_data_serial(binary=None, rate=1.0, baud=BAUD_RATE, seq=False):
     """Send test data using pyserial."""
     try:
-        ser = serial.Serial(UART_PORT, BAUD_RATE, timeout=1)
-        print(f"Opened {UART_PORT} at {BAUD_RATE} baud")
-        print("Sending IMU data every second...")
+        ser = serial.Serial(UART_PORT, baud, timeout=1)
+        print(f"Opened {UART_PORT} at {baud} baud")
+        print(f"Sending {binary or 'ASCII'} IMU data at {rate:g} Hz...")
         print("Press Ctrl+C to stop\n")
         
         count = 0
         while True:
-            data = generate_imu_data()
-            ser.write(data.encode())
+            if binary:
+                data = encode_binary_frame(generate_imu_values(), count, binary == 'int16')
+                ser.write(data)
+                text = data.hex(' ')
+            else:
+                data = generate_imu_data(count if seq else None)
+                ser.write(data.encode())
+                text = data.strip()
             count += 1
-            print(f"[{count}] Sent: {data.strip()}")
-            time.sleep(1)
+            if rate <= 10 or count % int(rate) == 0:
+                print(f"[{count}] Sent: {text}")
+            time.sleep(1.0 / rate)
             
     except serial.SerialException as e:
         print(f"Error opening serial port: {e}")
@@ -92,6 +153,14 @@ def main():
                        help='Send single packet and exit')
     parser.add_argument('-s', '--serial', action='store_true',
                        help='Use pyserial instead of file write')
+    parser.add_argument('-b', '--binary', choices=['int16', 'float'],
+                       help='Send COBS/CRC-16 binary frames (implies --serial)')
+    parser.add_argument('-r', '--rate', type=float, default=1.0,
+                       help='Frames per second with --serial (default 1)')
+    parser.add_argument('--baud', type=int, default=BAUD_RATE,
+                       help=f'Baud rate with --serial (default {BAUD_RATE}, must match UART_BAUD)')
+    parser.add_argument('--seq', action='store_true',
+                       help='Append a frame counter to ASCII frames ("$,...,T,N,#")')
     args = parser.parse_args()
     
     print("=" * 60)
@@ -100,8 +169,8 @@ def main():
     
     if args.once:
         send_single_packet()
-    elif args.serial:
-        send_test_data_serial()
+    elif args.serial or args.binary or args.seq:
+        send_test_data_serial(args.binary, args.rate, args.baud, args.seq)
     else:
         send_test_data_file()
 
@@ -60,9 +60,9 @@ def decode_telemetry(data):
     
     try:
         payload = data[12:52]
-        values = struct.unpack('>ffffffffI', payload)
+        values = struct.unpack('>fffffffffI', payload)
         
-        return {
+        tlm = {
             'bmp_temperature': values[0],
             'bmp_pressure': values[1],
             'accel_x': values[2],
@@ -76,6 +76,14 @@ def decode_telemetry(data):
             'receive_time': datetime.now().strftime('%Y-%m-%d %H:%M:%S.%f')[:-3]
         }
         
+        # Sample times (seconds + subseconds/2^32), if present
+        if len(data) >= 68:
+            bs, bss, is_, iss = struct.unpack('>IIII', data[52:68])
+            tlm['bmp_time'] = bs + bss / 4294967296.0
+            tlm['imu_time'] = is_ + iss / 4294967296.0
+        
+        return tlm
+        
     except struct.error:
         return None
 
@@ -96,6 +104,8 @@ def print_detailed(tlm):
     print(f"  Temperature:   {tlm['imu_temperature']:6.2f} °C")
     
     print(f"\n⏱️  Timestamp: {tlm['timestamp']} s")
+    if 'imu_time' in tlm:
+        print(f"  BMP sample: {tlm['bmp_time']:.6f} s   IMU sample: {tlm['imu_time']:.6f} s")
     print("=" * 70)
 
 def print_compact(tlm):
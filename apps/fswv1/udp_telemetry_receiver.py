@@ -29,6 +29,8 @@ def decode_telemetry(data):
     - Bytes 40-43:  Gyro_Z (float)
     - Bytes 44-47:  IMU_Temperature (float)
     - Bytes 48-51:  Timestamp (uint32)
+    - Bytes 52-59:  BMP sample time (uint32 seconds, uint32 subseconds)
+    - Bytes 60-67:  IMU sample time (uint32 seconds, uint32 subseconds)
     """
     
     if len(data) < 52:
@@ -40,7 +42,7 @@ def decode_telemetry(data):
         payload = data[12:52]
         
         # Unpack data: 9 floats + 1 uint32 (big-endian)
-        values = struct.unpack('>ffffffffI', payload)
+        values = struct.unpack('>fffffffffI', payload)
         
         telemetry = {
             'bmp_temperature': values[0],
@@ -55,6 +57,12 @@ def decode_telemetry(data):
             'timestamp': values[9]
         }
         
+        # Sample times (seconds + subseconds/2^32), if present
+        if len(data) >= 68:
+            bs, bss, is_, iss = struct.unpack('>IIII', data[52:68])
+            telemetry['bmp_time'] = bs + bss / 4294967296.0
+            telemetry['imu_time'] = is_ + iss / 4294967296.0
+        
         return telemetry
         
     except struct.error as e:
@@ -89,6 +97,9 @@ def print_telemetry(tlm):
     print(f"  Temperature: {tlm['imu_temperature']:7.2f} °C")
     
     print(f"\n⏱️  Timestamp: {tlm['timestamp']} seconds")
+    if 'imu_time' in tlm:
+        print(f"  BMP sample:  {tlm['bmp_time']:.6f} s")
+        print(f"  IMU sample:  {tlm['imu_time']:.6f} s")
     print("=" * 70)
 
 def print_compact(tlm):